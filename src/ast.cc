@@ -1,4 +1,5 @@
 #include "ast.hh"
+#include <algorithm>
 
 static int capturingGroupId = 0;
 
@@ -10,34 +11,24 @@ void CharacterClass::addRange(const std::pair<Char, Char>& range) {
 void CharacterClass::addChar(const Char& ch) {
     chars.insert(ch);
 }
+void CharacterClass::addClass(std::unique_ptr<CharacterClass> nested) {
+    classes.push_back(std::move(nested));
+}
 
 void CharacterClass::concatRanges(const std::vector<std::pair<Char, Char>>& _ranges) {
-    for (const auto& range : _ranges) {
-        auto it = ranges.begin();
-        while (it != ranges.end()) {
-            if (it->second < range.first - 1) {
-                if ((it->second + 1) >= (range.first - 1)) {
-                    it->second = std::max(it->second, range.second);
-                }
-                ranges.emplace(it, range);
-                break;
-            }
-            else if (range.second < it->first - 1) {
-                if ((range.second + 1) >= (it->first - 1)) {
-                    it->first = std::min(it->first, range.first);
-                }
-                ++it;
-            }
-            else {
-                it->first = std::min(it->first, range.first);
-                it->second = std::max(it->second, range.second);
-                it = ranges.erase(it);
-            }
+    // 追加后排序，再一趟合并重叠或相邻的区间
+    ranges.insert(ranges.end(), _ranges.begin(), _ranges.end());
+    std::sort(ranges.begin(), ranges.end());
+    std::vector<std::pair<Char, Char>> merged;
+    for (const auto& range : ranges) {
+        if (!merged.empty() && range.first.toCodepoint() <= merged.back().second.toCodepoint() + 1) {
+            merged.back().second = std::max(merged.back().second, range.second);
         }
-        if (it == ranges.end()) {
-            ranges.push_back(range);
+        else {
+            merged.push_back(range);
         }
     }
+    ranges = std::move(merged);
 }
 
 void CharacterClass::concatChars(const std::set<Char>& _chars) {
@@ -71,6 +62,11 @@ String CharacterClass::toString() const
             + toHexString(range.second.toCodepoint()) + "]";
     }
     s1 += ">\n";
+    for (auto& nested : classes) {
+        s1 += nested->isNegative ? "  <Nested, negated:\n" : "  <Nested:\n";
+        s1 += nested->toString();
+        s1 += "  >\n";
+    }
     return s1;
 }
 
@@ -128,6 +124,16 @@ String NonCapturingGroup::toString() const
     return "Non-capturing group:\n" + expression->toString();
 }
 
+AtomicGroup::AtomicGroup(std::unique_ptr<AST> expr)
+{
+    expression = std::move(expr);
+}
+
+String AtomicGroup::toString() const
+{
+    return "Atomic group:\n" + expression->toString();
+}
+
 LookaheadAssertion::LookaheadAssertion(std::unique_ptr<AST> expr, bool positive)
 {
     expression = std::move(expr);
@@ -183,15 +189,15 @@ String UnicodeProperty::toString() const
 }
 
 
-Quantifier::Quantifier() : type(Type::Once)
+Quantifier::Quantifier() : values({ 1, 1 }), lazy(false), possessive(false), type(Type::Once)
 {
 }
 
-Quantifier::Quantifier(int min, int max) : values({ min, max }) {
+Quantifier::Quantifier(int min, int max) : values({ min, max }), lazy(false), possessive(false) {
     type = Type::Designated;
 }
 
-Quantifier::Quantifier(Type type) : type(type) {
+Quantifier::Quantifier(Type type) : values({ 1, 1 }), lazy(false), possessive(false), type(type) {
     switch (type)
     {
     case Quantifier::Type::OneOrMore:
@@ -206,6 +212,16 @@ Quantifier::Quantifier(Type type) : type(type) {
     }
 }
 
+void Quantifier::setLazy()
+{
+    lazy = true;
+}
+
+void Quantifier::setPossessive()
+{
+    possessive = true;
+}
+
 String Quantifier::toString() const
 {
     String s;
@@ -228,6 +244,14 @@ String Quantifier::toString() const
             + (values.second != -1 ? String(values.second) : "infinity");
         break;
     }
+    if (lazy)
+    {
+        s += " (lazy)";
+    }
+    if (possessive)
+    {
+        s += " (possessive)";
+    }
     s += "\n";
     return s;
 }
@@ -252,7 +276,7 @@ String Factor::toString() const
 }
 
 Term::Term(bool _beginAnchor, std::unique_ptr<AST> factor0)
-    : hasBeginAnchor(_beginAnchor), factor_(std::move(factor0))
+    : hasBeginAnchor(_beginAnchor), hasEndAnchor(false), factor_(std::move(factor0))
 {
     factors.emplace_back(std::move(factor_));
 }
@@ -8,6 +8,9 @@
 #include <set>
 #include "string.hh"
 
+class Compiler;
+class Prefilter;
+
 // 基类
 class AST {
 public:
@@ -17,6 +20,8 @@ public:
 
 // 字面量节点
 class Literal : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     Char value;
 public:
@@ -26,14 +31,19 @@ public:
 
 // 字符类范围节点
 class CharacterClass : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     std::vector<std::pair<Char, Char>> ranges;
     std::set<Char> chars;
+    // 嵌套的类（如 [\W_] 中的 \W），与 ranges 和 chars 取并集
+    std::vector<std::unique_ptr<CharacterClass>> classes;
     bool isNegative;
 public:
     CharacterClass(bool isNegative);
     void addRange(const std::pair<Char, Char>& range);
     void addChar(const Char& ch);
+    void addClass(std::unique_ptr<CharacterClass> nested);
     void concatRanges(const std::vector<std::pair<Char, Char>>& _ranges);
     void concatChars(const std::set<Char>& chars);
     std::vector<std::pair<Char, Char>>&& getRanges();
@@ -50,6 +60,8 @@ public:
 
 // 锚点节点
 class Anchor : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 public:
     enum class Type { Begin, End };
 protected:
@@ -61,8 +73,12 @@ public:
 
 // 量词节点
 class Quantifier : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     std::pair<int, int> values;
+    bool lazy;
+    bool possessive;
 public:
     enum class Type
     {
@@ -72,11 +88,15 @@ public:
     Quantifier();
     Quantifier(int min, int max);
     Quantifier(Type type);
+    void setLazy();
+    void setPossessive();
     virtual String toString() const;
 };
 
 // 捕获组节点
 class CapturingGroup : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     int id;
     std::unique_ptr<AST> expression;
@@ -87,6 +107,8 @@ public:
 
 // 命名捕获组节点
 class NamedCapturingGroup : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     String name;
     int id;
@@ -98,6 +120,8 @@ public:
 
 // 非捕获组节点
 class NonCapturingGroup : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     std::unique_ptr<AST> expression;
 public:
@@ -105,8 +129,21 @@ public:
     virtual String toString() const;
 };
 
+// 原子组节点：其中的回溯点在离开时全部丢弃
+class AtomicGroup : public AST {
+    friend class Compiler;
+    friend class Prefilter;
+protected:
+    std::unique_ptr<AST> expression;
+public:
+    AtomicGroup(std::unique_ptr<AST> expr);
+    virtual String toString() const;
+};
+
 // 先行断言节点
 class LookaheadAssertion : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     std::unique_ptr<AST> expression;
     bool isPositive;
@@ -117,6 +154,8 @@ public:
 
 // 后行断言节点
 class LookbehindAssertion : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     std::unique_ptr<AST> expression;
     bool isPositive;
@@ -127,6 +166,8 @@ public:
 
 // 反向引用节点
 class Backreference : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     String reference;
     int id;
@@ -138,6 +179,8 @@ public:
 
 // Unicode属性节点
 class UnicodeProperty : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     String propertyName;
     String propertyValue;
@@ -154,6 +197,8 @@ enum class SpecialSequenceType
 SpecialSequenceType translateSpecialSequence(const String& seq);
 
 class Atom : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     std::unique_ptr<AST> atom;
 public:
@@ -163,6 +208,8 @@ public:
 
 // 匹配因子：原子（及其量词）或断言
 class Factor : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     std::unique_ptr<AST> assertion;
     std::pair<std::unique_ptr<AST>, std::unique_ptr<AST>> atom_quantifier;
@@ -180,6 +227,8 @@ public:
 
 // 匹配项：匹配因子的序列
 class Term : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     bool hasBeginAnchor;
     bool hasEndAnchor;
@@ -195,6 +244,8 @@ public:
 
 // 匹配式：各可选匹配项的并集
 class Expression : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     std::vector<std::unique_ptr<AST>> terms;
     std::unique_ptr<AST> term_;
@@ -206,6 +257,8 @@ public:
 
 // 正则表达式：最外层的匹配式
 class Regex : public AST {
+    friend class Compiler;
+    friend class Prefilter;
 protected:
     std::unique_ptr<AST> expression;
 public:
@@ -0,0 +1,692 @@
+#include "backtrack.hh"
+#include "compiler.hh"
+#include <algorithm>
+#include <cstring>
+
+Backtracker::Backtracker(Program _program, const Budget& _budget)
+    : Backtracker(std::make_shared<const Program>(std::move(_program)), _budget)
+{
+}
+
+Backtracker::Backtracker(std::shared_ptr<const Program> _program, const Budget& _budget)
+    : program(std::move(_program)), budget(_budget), memoized(0), markedFrom(0), markedTo(0), seenCount(0)
+{
+    // pc 能到达 Ref 时，结果依赖于捕获组的值，不能记忆
+    size_t n = program->size();
+    std::vector<bool> reachesRef(n, false);
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (size_t pc = n; pc-- > 0;)
+        {
+            const Instruction& instruction = (*program)[pc];
+            bool reaches = instruction.code == ByteCode::Ref;
+            switch (instruction.code)
+            {
+            case ByteCode::Jump:
+                reaches = reachesRef[instruction.operand_1];
+                break;
+            case ByteCode::Split:
+                reaches = reachesRef[instruction.operand_1] || reachesRef[instruction.operand_2];
+                break;
+            case ByteCode::Repeat:
+                reaches = reachesRef[pc + 1] || reachesRef[instruction.operand_2];
+                break;
+            case ByteCode::Loop:
+                reaches = reachesRef[instruction.operand_2];
+                break;
+            case ByteCode::Accept:
+            case ByteCode::Halt:
+                break;
+            default:
+                reaches = reaches || (pc + 1 < n && reachesRef[pc + 1]);
+                break;
+            }
+            if (reaches && !reachesRef[pc])
+            {
+                reachesRef[pc] = true;
+                changed = true;
+            }
+        }
+    }
+
+    // 计数循环体内的结果还依赖于计数，原子组内的还依赖于进入组的位置
+    translate();
+    counterSlots = 2 * program->groups;
+    atomicSlots = counterSlots + program->counters.size();
+    std::vector<bool> keyed(n, false);
+    for (size_t pc = 0; pc < n; ++pc)
+    {
+        if (code[pc].op == Op::Repeat)
+        {
+            std::fill(keyed.begin() + pc, keyed.begin() + program->loopEnd(pc) + 1, true);
+            referenced.push_back(counterSlots + code[pc].operand_1);
+        }
+        else if (code[pc].op == Op::Atomic)
+        {
+            std::fill(keyed.begin() + pc + 1, keyed.begin() + code[pc].operand_2 + 1, true);
+            referenced.push_back(atomicSlots + code[pc].operand_1);
+        }
+    }
+
+    memo.resize(n, VM::npos);
+    for (size_t pc = 0; pc < n; ++pc)
+    {
+        if (!reachesRef[pc] && !keyed[pc])
+        {
+            memo[pc] = memoized++;
+        }
+    }
+
+    for (const Instruction& instruction : program->instructions)
+    {
+        if (instruction.code == ByteCode::Ref)
+        {
+            referenced.push_back(2 * instruction.operand_1);
+            referenced.push_back(2 * instruction.operand_1 + 1);
+        }
+    }
+    std::sort(referenced.begin(), referenced.end());
+    referenced.erase(std::unique(referenced.begin(), referenced.end()), referenced.end());
+    key.resize(2 + referenced.size());
+
+    for (const Lookaround& lookaround : program->lookarounds)
+    {
+        lookarounds.push_back(std::make_unique<VM>(lookaround.body));
+    }
+    holds.resize(lookarounds.size());
+}
+
+void Backtracker::translate()
+{
+    const Program& p = *program;
+    size_t n = p.size();
+    code.resize(n);
+    for (size_t pc = 0; pc < n; ++pc)
+    {
+        const Instruction& instruction = p[pc];
+        Operation& operation = code[pc];
+        operation = { Op::Fail, instruction.operand_1, instruction.operand_2, nullptr, nullptr };
+        switch (instruction.code)
+        {
+        case ByteCode::Jump: operation.op = Op::Jump; break;
+        case ByteCode::Split: operation.op = Op::Split; break;
+        case ByteCode::Match:
+            operation.op = Op::Match;
+            operation.matcher = &p.matcher(instruction);
+            break;
+        case ByteCode::String:
+            operation.op = Op::String;
+            operation.operand_1 = instruction.operand_2;
+            operation.literal = p.literal(instruction).data();
+            break;
+        case ByteCode::Repeat: operation.op = Op::Repeat; break;
+        case ByteCode::Loop: operation.op = Op::Loop; break;
+        case ByteCode::Atomic: operation.op = Op::Atomic; break;
+        case ByteCode::Commit: operation.op = Op::Commit; break;
+        case ByteCode::Anchor: operation.op = Op::Anchor; break;
+        case ByteCode::Capture: operation.op = Op::Capture; break;
+        case ByteCode::Assert: operation.op = Op::Assert; break;
+        case ByteCode::Ref: operation.op = Op::Ref; break;
+        case ByteCode::Accept: operation.op = Op::Accept; break;
+        default: break;
+        }
+    }
+
+    // 单个字符类的贪婪循环合并为一个操作；循环体原有的指令保留，供别处跳入
+    for (size_t pc = 0; pc + 1 < n; ++pc)
+    {
+        const Instruction& instruction = p[pc];
+        if (instruction.code == ByteCode::Split && instruction.operand_1 == pc + 1 && pc + 2 < n
+            && p[pc + 1].code == ByteCode::Match
+            && p[pc + 2].code == ByteCode::Jump && p[pc + 2].operand_1 == pc)
+        {
+            code[pc] = { Compiler::isPossessive(p, pc) ? Op::PossessiveStar : Op::Star,
+                instruction.operand_2, 0, &p.matcher(p[pc + 1]), nullptr };
+        }
+        else if (instruction.code == ByteCode::Match
+            && p[pc + 1].code == ByteCode::Split && p[pc + 1].operand_1 == pc)
+        {
+            code[pc] = { Compiler::isPossessive(p, pc) ? Op::PossessivePlus : Op::Plus,
+                p[pc + 1].operand_2, static_cast<uint32_t>(pc + 1), &p.matcher(instruction), nullptr };
+        }
+    }
+
+    // 不含选择的原子组没有回溯点可丢，Atomic 与 Commit 只需跳过
+    for (size_t pc = n; pc-- > 0;)
+    {
+        if (code[pc].op != Op::Atomic)
+        {
+            continue;
+        }
+        size_t commit = code[pc].operand_2;
+        bool choices = false;
+        for (size_t k = pc + 1; k < commit; ++k)
+        {
+            Op op = code[k].op;
+            // PossessivePlus 跳过了它后面的 Split
+            bool skipped = op == Op::Split && code[k - 1].op == Op::PossessivePlus;
+            choices = choices || (!skipped && (op == Op::Split || op == Op::Star || op == Op::Plus
+                || op == Op::Repeat || op == Op::Loop || op == Op::Atomic));
+        }
+        if (!choices)
+        {
+            code[pc] = { Op::Jump, static_cast<uint32_t>(pc + 1), 0, nullptr, nullptr };
+            code[commit] = { Op::Jump, static_cast<uint32_t>(commit + 1), 0, nullptr, nullptr };
+        }
+    }
+}
+
+static size_t hashState(const size_t* state, size_t width)
+{
+    size_t h = 14695981039346656037ull;
+    for (size_t k = 0; k < width; ++k)
+    {
+        h = (h ^ state[k]) * 1099511628211ull;
+    }
+    return h ^ (h >> 29);
+}
+
+// Records that the thread (pc, position) has been explored. Returns false if
+// it already was.
+inline bool Backtracker::mark(size_t pc, size_t position)
+{
+    if (memo[pc] != VM::npos)
+    {
+        size_t bit = memo[pc] * (text.size() + 1) + position;
+        if (visited[bit / 64] & (uint64_t(1) << (bit % 64)))
+        {
+            return false;
+        }
+        visited[bit / 64] |= uint64_t(1) << (bit % 64);
+        markedTo = std::max(markedTo, position);
+        return true;
+    }
+    return visit(pc, position);
+}
+
+// Records (pc, position, referenced slots). Returns false if it was already
+// recorded.
+bool Backtracker::visit(size_t pc, size_t position)
+{
+    // 0 marks an empty entry, so pc is stored plus one
+    size_t width = key.size();
+    key[0] = pc + 1;
+    key[1] = position;
+    for (size_t k = 0; k < referenced.size(); ++k)
+    {
+        key[2 + k] = slots[referenced[k]];
+    }
+
+    if (2 * (seenCount + 1) * width > seen.size())
+    {
+        grow();
+    }
+    size_t mask = seen.size() / width - 1;
+    for (size_t i = hashState(key.data(), width) & mask;; i = (i + 1) & mask)
+    {
+        size_t* entry = &seen[i * width];
+        if (!entry[0])
+        {
+            std::copy(key.begin(), key.end(), entry);
+            seenCount++;
+            return true;
+        }
+        if (std::equal(key.begin(), key.end(), entry))
+        {
+            return false;
+        }
+    }
+}
+
+void Backtracker::grow()
+{
+    size_t width = key.size();
+    std::vector<size_t> old = std::move(seen);
+    seen.assign(std::max(64 * width, 2 * old.size()), 0);
+    size_t mask = seen.size() / width - 1;
+    for (size_t i = 0; i < old.size(); i += width)
+    {
+        if (old[i])
+        {
+            size_t j = hashState(&old[i], width) & mask;
+            while (seen[j * width])
+            {
+                j = (j + 1) & mask;
+            }
+            std::copy(old.begin() + i, old.begin() + i + width, seen.begin() + j * width);
+        }
+    }
+}
+
+Backtracker::Result Backtracker::search(StringView _text, Captures& captures, size_t start, bool anchored)
+{
+    text = _text;
+    Budget limits = budget;
+    if (!limits.steps)
+    {
+        limits.steps = defaultSteps();
+    }
+    meter.start(limits);
+    // 与 VM 一样，只有明确接着上次搜索同一文本时才复用断言表
+    bool evaluate = !continuing || evaluated.data() != text.data() || evaluated.size() != text.size();
+    continuing = false;
+    if (evaluate)
+    {
+        evaluated = StringView();
+    }
+    for (size_t i = 0; evaluate && i < lookarounds.size(); ++i)
+    {
+        const Lookaround& lookaround = program->lookarounds[i];
+        if (!lookarounds[i]->scan(text, lookaround.ahead, holds[i], &meter))
+        {
+            return Result::BudgetExceeded;
+        }
+        if (!lookaround.positive)
+        {
+            for (uint8_t& h : holds[i])
+            {
+                h = !h;
+            }
+        }
+    }
+    if (!lookarounds.empty())
+    {
+        evaluated = text;
+    }
+
+    clearMarks((memoized * (text.size() + 1) + 63) / 64);
+    markedFrom = markedTo = start;
+    // 保留表的容量，逐个查找时不再分配
+    if (seenCount)
+    {
+        std::fill(seen.begin(), seen.end(), 0);
+        seenCount = 0;
+    }
+    slots.assign(counterSlots, VM::npos);
+    slots.resize(atomicSlots, 0);
+    slots.resize(atomicSlots + program->atomicGroups, VM::npos);
+    if (!meter.check(footprint()))
+    {
+        return Result::BudgetExceeded;
+    }
+
+    for (size_t position = start; position <= text.size(); position = text.next(position))
+    {
+        if (explore(position))
+        {
+            captures.assign(slots.begin(), slots.begin() + counterSlots);
+            return Result::Match;
+        }
+        if (meter.exceeded())
+        {
+            return Result::BudgetExceeded;
+        }
+        if (anchored || position == text.size())
+        {
+            break;
+        }
+    }
+    return Result::NoMatch;
+}
+
+// Clears the bitset for a search over the current text. Successive searches
+// on one text, such as those of Matches, only clear the range the last one
+// marked, so that finding every match does not cost O(n) per match.
+void Backtracker::clearMarks(size_t words)
+{
+    if (visited.size() != words)
+    {
+        visited.assign(words, 0);
+        return;
+    }
+    size_t row = text.size() + 1;
+    for (size_t i = 0; i < memoized; ++i)
+    {
+        std::fill(visited.begin() + (i * row + markedFrom) / 64, visited.begin() + (i * row + markedTo) / 64 + 1, 0);
+    }
+}
+
+// Step limit of a search of text when the budget sets none (see above),
+// saturated rather than wrapped.
+size_t Backtracker::defaultSteps() const
+{
+    size_t states = code.size() * stepsPerState;
+    if (states && text.size() + 1 > SIZE_MAX / states)
+    {
+        return SIZE_MAX - 1;
+    }
+    return std::max(defaultBudget, states * (text.size() + 1));
+}
+
+// Bytes of scratch held by the memo, the stack and the lookaround tables.
+size_t Backtracker::footprint() const
+{
+    size_t bytes = visited.size() * sizeof(uint64_t) + seen.size() * sizeof(size_t)
+        + stack.capacity() * sizeof(Frame);
+    for (const std::vector<uint8_t>& h : holds)
+    {
+        bytes += h.size();
+    }
+    return bytes;
+}
+
+inline bool Backtracker::matchAt(const Matcher& matcher, size_t position, size_t& length) const
+{
+    // 无效的 UTF-8 字节不匹配任何类
+    char32_t c = text.decode(position, length);
+    return (length > 1 || (length && c < 0x80)) && matcher.match(Char(static_cast<int>(c)));
+}
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(SWEETIE_NO_THREADED_CODE)
+#define SWEETIE_THREADED_CODE 1
+#endif
+
+// Explores every thread of a match beginning at start, in priority order.
+bool Backtracker::explore(size_t start)
+{
+    // Moves to the thread (pc, position): fails it if it has been explored,
+    // otherwise runs its operation
+#ifdef SWEETIE_THREADED_CODE
+    static const void* const labels[] = {
+        &&op_Jump, &&op_Split, &&op_Match, &&op_String, &&op_Repeat, &&op_Loop, &&op_Atomic,
+        &&op_Commit, &&op_Anchor, &&op_Capture, &&op_Assert, &&op_Ref, &&op_Accept, &&op_Fail,
+        &&op_Star, &&op_Plus, &&op_PossessiveStar, &&op_PossessivePlus
+    };
+#define CASE(name) op_##name
+#define DISPATCH()                                                              \
+    do                                                                          \
+    {                                                                           \
+        if (!meter.tick() && !meter.check(footprint())) return false;           \
+        if (!mark(pc, position)) goto fail;                                     \
+        goto *labels[static_cast<size_t>(code[pc].op)];                         \
+    } while (0)
+#else
+#define CASE(name) case Op::name
+#define DISPATCH()                                                              \
+    do                                                                          \
+    {                                                                           \
+        if (!meter.tick() && !meter.check(footprint())) return false;           \
+        if (!mark(pc, position)) goto fail;                                     \
+        goto dispatch;                                                          \
+    } while (0)
+#endif
+
+    size_t pc = 0;
+    size_t position = start;
+    const char* data = text.data();
+    stack.clear();
+    stack.push_back({ 0, start, VM::npos, 0 });
+
+fail:
+    while (!stack.empty())
+    {
+        Frame frame = stack.back();
+        stack.pop_back();
+        if (frame.slot != VM::npos)
+        {
+            slots[frame.slot] = frame.value;
+            continue;
+        }
+        pc = frame.pc;
+        position = frame.position;
+        if (frame.value)
+        {
+            size_t slot = frame.value - 1;
+            stack.push_back({ 0, 0, slot, slots[slot] });
+            slots[slot] = 0;
+        }
+        DISPATCH();
+    }
+    return false;
+
+#ifndef SWEETIE_THREADED_CODE
+dispatch:
+    switch (code[pc].op)
+    {
+#endif
+    CASE(Jump):
+        pc = code[pc].operand_1;
+        DISPATCH();
+    CASE(Split):
+        stack.push_back({ code[pc].operand_2, position, VM::npos, 0 });
+        pc = code[pc].operand_1;
+        DISPATCH();
+    CASE(Match):
+    {
+        size_t length;
+        if (!matchAt(*code[pc].matcher, position, length))
+        {
+            goto fail;
+        }
+        position += length;
+        pc++;
+        DISPATCH();
+    }
+    CASE(String):
+    {
+        size_t length = code[pc].operand_1;
+        if (length > text.size() - position || std::memcmp(data + position, code[pc].literal, length) != 0)
+        {
+            goto fail;
+        }
+        position += length;
+        pc++;
+        DISPATCH();
+    }
+    CASE(Repeat):
+    {
+        const Counter& counter = program->counters[code[pc].operand_1];
+        size_t slot = counterSlots + code[pc].operand_1;
+        size_t count = slots[slot];
+        if (count < counter.min)
+        {
+            pc++;
+            DISPATCH();
+        }
+        bool optional = counter.max == Counter::unbounded || count < counter.max;
+        if (optional && !counter.lazy)
+        {
+            stack.push_back({ code[pc].operand_2, position, VM::npos, slot + 1 });
+            pc++;
+            DISPATCH();
+        }
+        if (optional)
+        {
+            stack.push_back({ pc + 1, position, VM::npos, 0 });
+        }
+        stack.push_back({ 0, 0, slot, count });
+        slots[slot] = 0;
+        pc = code[pc].operand_2;
+        DISPATCH();
+    }
+    CASE(Loop):
+    {
+        size_t slot = counterSlots + code[pc].operand_1;
+        if (slots[slot] < program->counters[code[pc].operand_1].limit())
+        {
+            stack.push_back({ 0, 0, slot, slots[slot] });
+            slots[slot]++;
+        }
+        pc = code[pc].operand_2;
+        DISPATCH();
+    }
+    CASE(Atomic):
+    {
+        // The frame that restores the slot marks where the group was entered
+        size_t slot = atomicSlots + code[pc].operand_1;
+        stack.push_back({ 0, 0, slot, slots[slot] });
+        slots[slot] = position;
+        pc++;
+        DISPATCH();
+    }
+    CASE(Commit):
+    {
+        // Drops the threads pushed inside the group but keeps the restore
+        // frames, which must still undo its captures if what follows fails
+        size_t slot = atomicSlots + code[pc].operand_1;
+        size_t bottom = stack.size();
+        while (stack[--bottom].slot != slot)
+        {
+        }
+        size_t kept = bottom + 1;
+        for (size_t i = bottom + 1; i < stack.size(); ++i)
+        {
+            if (stack[i].slot != VM::npos)
+            {
+                stack[kept++] = stack[i];
+            }
+        }
+        stack.resize(kept);
+        slots[slot] = VM::npos;
+        pc++;
+        DISPATCH();
+    }
+    CASE(Anchor):
+        if (code[pc].operand_1 == static_cast<size_t>(AnchorType::Begin)
+            ? position != 0 : position != text.size())
+        {
+            goto fail;
+        }
+        pc++;
+        DISPATCH();
+    CASE(Capture):
+    {
+        size_t slot = code[pc].operand_1;
+        if (slots[slot] != position)
+        {
+            stack.push_back({ 0, 0, slot, slots[slot] });
+            slots[slot] = position;
+        }
+        pc++;
+        DISPATCH();
+    }
+    CASE(Assert):
+        if (!holds[code[pc].operand_1][position])
+        {
+            goto fail;
+        }
+        pc++;
+        DISPATCH();
+    CASE(Ref):
+    {
+        // 引用未参与匹配的组时匹配失败（与 Perl 一致）
+        size_t begin = slots[2 * code[pc].operand_1];
+        size_t end = slots[2 * code[pc].operand_1 + 1];
+        if (begin == VM::npos || end == VM::npos || end < begin)
+        {
+            goto fail;
+        }
+        size_t length = end - begin;
+        if (length > text.size() - position || std::memcmp(data + position, data + begin, length) != 0)
+        {
+            goto fail;
+        }
+        position += length;
+        pc++;
+        DISPATCH();
+    }
+    CASE(Accept):
+        return true;
+    CASE(Fail):
+        goto fail;
+    CASE(Star):
+    {
+        // The Split at pc has been recorded; each turn records it again at
+        // the next position
+        const Operation& operation = code[pc];
+        while (true)
+        {
+            stack.push_back({ operation.operand_1, position, VM::npos, 0 });
+            size_t length;
+            if (!matchAt(*operation.matcher, position, length))
+            {
+                goto fail;
+            }
+            position += length;
+            if (!meter.tick() && !meter.check(footprint()))
+            {
+                return false;
+            }
+            if (!mark(pc, position))
+            {
+                goto fail;
+            }
+        }
+    }
+    CASE(Plus):
+    {
+        const Operation& operation = code[pc];
+        while (true)
+        {
+            size_t length;
+            if (!matchAt(*operation.matcher, position, length))
+            {
+                goto fail;
+            }
+            position += length;
+            if (!meter.tick() && !meter.check(footprint()))
+            {
+                return false;
+            }
+            if (!mark(operation.operand_2, position))
+            {
+                goto fail;
+            }
+            stack.push_back({ operation.operand_1, position, VM::npos, 0 });
+            if (!mark(pc, position))
+            {
+                goto fail;
+            }
+        }
+    }
+    CASE(PossessiveStar):
+    {
+        const Operation& operation = code[pc];
+        size_t length;
+        while (matchAt(*operation.matcher, position, length))
+        {
+            position += length;
+            if (!meter.tick() && !meter.check(footprint()))
+            {
+                return false;
+            }
+            if (!mark(pc, position))
+            {
+                goto fail;
+            }
+        }
+        pc = operation.operand_1;
+        DISPATCH();
+    }
+    CASE(PossessivePlus):
+    {
+        const Operation& operation = code[pc];
+        size_t length;
+        if (!matchAt(*operation.matcher, position, length))
+        {
+            goto fail;
+        }
+        do
+        {
+            position += length;
+            if (!meter.tick() && !meter.check(footprint()))
+            {
+                return false;
+            }
+            if (!mark(operation.operand_2, position))
+            {
+                goto fail;
+            }
+        } while (matchAt(*operation.matcher, position, length));
+        pc = operation.operand_1;
+        DISPATCH();
+    }
+#ifndef SWEETIE_THREADED_CODE
+    }
+    return false;
+#endif
+#undef CASE
+#undef DISPATCH
+}
@@ -0,0 +1,141 @@
+#ifndef _BACKTRACK_HH_
+#define _BACKTRACK_HH_
+
+#include "vm.hh"
+
+// Backtracking engine, for programs with backreferences or atomic groups.
+//
+// Runs the program depth first with an explicit stack, so it finds the same
+// match as the VM. Whether a thread at (pc, position) can still reach Accept
+// only depends on the captures if a Ref is reachable from pc. For every other
+// pc the pair is recorded in a bitset when first explored and never explored
+// again, which keeps the parts of a pattern before and around backreferences
+// linear. Other states are recorded together with the captures that are read
+// later, in a hash set. What is left is bounded by a Budget, where a step is
+// one operation. A budget without a step limit, the default, still gets one:
+// stepsPerState steps for every instruction and position of the text, and at
+// least defaultBudget, so that it grows with the work the memo allows.
+//
+// The counts of counted loops are kept as extra slots. Inside a loop the
+// outcome depends on them, so those pcs are recorded with the counts too.
+//
+// So is where each atomic group was entered. The frame that restores it
+// marks the bottom of the group's backtrack points, and Commit drops the
+// threads above it. A state inside a group may have led to a Commit that
+// cut the alternatives of one entry into the group, which says nothing of
+// another entry, so the pcs of a group are recorded with that slot. Loops
+// over a class that never have to give characters back (see
+// Compiler::isPossessive()) run without backtrack points, and atomic groups
+// left without any choice cost nothing.
+//
+// Lookarounds are evaluated with tables, as in VM.
+//
+// The program is first translated into operations that carry their matcher
+// or literal with them. Loops over a single class, x* and x+, become one
+// operation that runs the loop itself. With GCC and Clang every operation
+// ends with its own computed goto to the next, so the CPU predicts each
+// dispatch from where it came from, rather than sending all of them through
+// one switch; other compilers, or SWEETIE_NO_THREADED_CODE, get the switch.
+class Backtracker
+{
+    friend class Pattern;
+
+public:
+    using Result = VM::Result;
+
+    static constexpr size_t defaultBudget = 1 << 20;
+    static constexpr size_t stepsPerState = 8;
+
+    Backtracker(std::shared_ptr<const Program> _program, const Budget& _budget = {});
+    Backtracker(Program _program, const Budget& _budget = {});
+
+    // Finds the leftmost match that begins at or after start, as
+    // VM::search() does, unless the budget runs out first.
+    Result search(StringView _text, Captures& captures, size_t start = 0, bool anchored = false);
+
+    void setBudget(const Budget& _budget) { budget = _budget; }
+
+private:
+    // Work item: a thread to explore, or a slot to restore once the branch
+    // that set it has failed. A thread that leaves a counted loop carries the
+    // slot of the loop's count plus one in value, and resets the count first.
+    struct Frame
+    {
+        size_t pc;
+        size_t position;
+        size_t slot;
+        size_t value;
+    };
+
+    enum class Op : uint8_t
+    {
+        Jump, Split, Match, String, Repeat, Loop, Atomic, Commit, Anchor, Capture, Assert, Ref,
+        Accept, Fail,
+        // Split L + 1, exit / L + 1: Match / L + 2: Jump L
+        Star,
+        // Match / L + 1: Split L, exit
+        Plus,
+        // Star and Plus that never give characters back
+        PossessiveStar,
+        PossessivePlus
+    };
+
+    struct Operation
+    {
+        Op op;
+        // Jump, Split: targets; String: length; Star, Plus: exit, and for
+        // Plus the pc of its Split; other opcodes as in Instruction
+        uint32_t operand_1;
+        uint32_t operand_2;
+        const Matcher* matcher;
+        const char* literal;
+    };
+
+    std::shared_ptr<const Program> program;
+    std::vector<Operation> code;
+    Budget budget;
+    Meter meter;
+    StringView text;
+
+    // Index of each memoizable pc into the bitset, or VM::npos.
+    std::vector<size_t> memo;
+    size_t memoized;
+    std::vector<uint64_t> visited;
+    // Bits may be set only for positions marked in [markedFrom, markedTo],
+    // which is all the next search clears when the text has the same size
+    size_t markedFrom;
+    size_t markedTo;
+
+    // For other pcs the outcome also depends on the slots that some Ref
+    // reads, so the state recorded is (pc, position, referenced slots). These
+    // are kept in an open-addressing hash table of fixed-width entries.
+    std::vector<size_t> referenced;
+    std::vector<size_t> seen;
+    size_t seenCount;
+    std::vector<size_t> key;
+
+    size_t defaultSteps() const;
+    bool mark(size_t pc, size_t position);
+    bool visit(size_t pc, size_t position);
+    bool matchAt(const Matcher& matcher, size_t position, size_t& length) const;
+    size_t footprint() const;
+    void clearMarks(size_t words);
+    void translate();
+    void grow();
+
+    std::vector<Frame> stack;
+    // The capture slots, then the count of every counted loop, then where
+    // every atomic group was entered
+    std::vector<size_t> slots;
+    size_t counterSlots;
+    size_t atomicSlots;
+    std::vector<std::unique_ptr<VM>> lookarounds;
+    std::vector<std::vector<uint8_t>> holds;
+    StringView evaluated;
+    // Set by Pattern for the next search only, as for VM
+    bool continuing = false;
+
+    bool explore(size_t start);
+};
+
+#endif // !_BACKTRACK_HH_
@@ -0,0 +1,42 @@
+#include "budget.hh"
+#include <algorithm>
+
+void Meter::start(const Budget& budget)
+{
+    used = 0;
+    steps = budget.steps;
+    memory = budget.memory;
+    timed = budget.time.count() > 0;
+    over = false;
+    if (timed)
+    {
+        deadline = std::chrono::steady_clock::now() + budget.time;
+    }
+    schedule();
+}
+
+// Sets the next checkpoint: the step after the last one allowed, and no
+// later than checkInterval steps from now if the clock or the memory has to
+// be looked at.
+void Meter::schedule()
+{
+    checkpoint = timed || memory ? used + checkInterval : SIZE_MAX;
+    if (steps)
+    {
+        checkpoint = std::min(checkpoint, steps + 1);
+    }
+}
+
+bool Meter::check(size_t held)
+{
+    if (over || (steps && used > steps) || (memory && held > memory)
+        || (timed && std::chrono::steady_clock::now() >= deadline))
+    {
+        // Every later tick() fails at once
+        over = true;
+        checkpoint = 0;
+        return false;
+    }
+    schedule();
+    return true;
+}
@@ -0,0 +1,75 @@
+#ifndef _BUDGET_HH_
+#define _BUDGET_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Limits on the work of one search, so that no pattern and text can keep a
+// thread busy for long. A limit of 0 means there is none, except that the
+// backtracker then sets its own step limit (see Backtracker).
+//
+// Steps count the work of the engine that runs the search: a character
+// read by one thread of the VM, an operation of the backtracker, a byte
+// scanned by a DFA. States count the DFA states built. Memory bounds the
+// bytes of scratch an engine holds: thread lists, lookaround tables, the
+// backtracker's stack and memo, the DFA cache (which is flushed rather than
+// grown past it). Time is wall-clock time.
+struct Budget
+{
+    size_t steps = 0;
+    size_t states = 0;
+    size_t memory = 0;
+    std::chrono::nanoseconds time{ 0 };
+};
+
+// Thrown by Pattern when a search runs out of its budget.
+class BudgetExceeded : public std::runtime_error
+{
+public:
+    BudgetExceeded() : std::runtime_error("Search budget exceeded") {}
+};
+
+// Counts the work of one search against a Budget.
+//
+// Inner loops only call tick(), an add and a compare against the next
+// checkpoint. Checkpoints come every checkInterval steps when there is a
+// deadline or a memory limit, and at the step limit; only there does the
+// engine call check(), which reads the clock and takes the bytes of scratch
+// the engine holds. Without limits there are no checkpoints at all.
+class Meter
+{
+public:
+    static constexpr size_t checkInterval = 1 << 12;
+
+    void start(const Budget& budget);
+
+    // Counts n steps. Returns false when a checkpoint is reached.
+    bool tick(size_t n = 1)
+    {
+        used += n;
+        return used < checkpoint;
+    }
+
+    // Returns false, for good, once the budget is exceeded.
+    bool check(size_t held);
+
+    // Whether there are checkpoints, i.e. any limit besides states.
+    bool limited() const { return checkpoint != SIZE_MAX; }
+
+    bool exceeded() const { return over; }
+
+private:
+    size_t used = 0;
+    size_t checkpoint = SIZE_MAX;
+    size_t steps = 0;
+    size_t memory = 0;
+    bool timed = false;
+    bool over = false;
+    std::chrono::steady_clock::time_point deadline;
+
+    void schedule();
+};
+
+#endif // !_BUDGET_HH_
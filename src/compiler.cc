@@ -0,0 +1,1064 @@
+#include "compiler.hh"
+#include <algorithm>
+#include <stdexcept>
+
+Compiler::Compiler(bool _reverse) : groupCount(1), reverse(_reverse)
+{
+}
+
+size_t Compiler::emit(Instruction instruction)
+{
+    program.instructions.emplace_back(std::move(instruction));
+    return program.size() - 1;
+}
+
+size_t Compiler::here() const
+{
+    return program.size();
+}
+
+// Emits a Match. Copies of the same atom, as made by quantifiers, share their
+// entry in the class table.
+size_t Compiler::emitMatch(const AST* node, Matcher matcher)
+{
+    auto it = matcherIndex.find(node);
+    if (it == matcherIndex.end())
+    {
+        it = matcherIndex.emplace(node, program.matchers.size()).first;
+        program.matchers.push_back(std::move(matcher));
+    }
+    return emit(Instruction(ByteCode::Match, it->second));
+}
+
+Program Compiler::compile(const String& pattern)
+{
+    Lexer lexer(pattern);
+    Parser parser(lexer.tokenize());
+    auto regex = parser.parse();
+    return Compiler().compile(*regex);
+}
+
+// Gives every capturing group its number before any code is emitted, so that
+// groups inside repeated, unrolled or dropped atoms keep the numbers they have
+// in the pattern.
+void Compiler::numberGroups(const AST* node)
+{
+    if (!node)
+    {
+        return;
+    }
+    if (auto regex = dynamic_cast<const Regex*>(node))
+    {
+        numberGroups(regex->expression.get());
+    }
+    else if (auto expression = dynamic_cast<const Expression*>(node))
+    {
+        for (auto& term : expression->terms) numberGroups(term.get());
+    }
+    else if (auto term = dynamic_cast<const Term*>(node))
+    {
+        for (auto& factor : term->factors) numberGroups(factor.get());
+    }
+    else if (auto factor = dynamic_cast<const Factor*>(node))
+    {
+        numberGroups(factor->type == Factor::Type::Assertion
+            ? factor->assertion.get() : factor->atom_quantifier.first.get());
+    }
+    else if (auto atom = dynamic_cast<const Atom*>(node))
+    {
+        numberGroups(atom->atom.get());
+    }
+    else if (auto group = dynamic_cast<const CapturingGroup*>(node))
+    {
+        groupNumbers[node] = groupCount++;
+        groupNames.emplace_back();
+        numberGroups(group->expression.get());
+    }
+    else if (auto group = dynamic_cast<const NamedCapturingGroup*>(node))
+    {
+        for (const String& name : groupNames)
+        {
+            if (name == group->name)
+            {
+                throw std::runtime_error("Duplicate group name: " + group->name.toUTF8());
+            }
+        }
+        groupNumbers[node] = groupCount++;
+        groupNames.emplace_back(group->name);
+        numberGroups(group->expression.get());
+    }
+    else if (auto group = dynamic_cast<const NonCapturingGroup*>(node))
+    {
+        numberGroups(group->expression.get());
+    }
+    else if (auto group = dynamic_cast<const AtomicGroup*>(node))
+    {
+        numberGroups(group->expression.get());
+    }
+    else if (auto assertion = dynamic_cast<const LookaheadAssertion*>(node))
+    {
+        numberGroups(assertion->expression.get());
+    }
+    else if (auto assertion = dynamic_cast<const LookbehindAssertion*>(node))
+    {
+        numberGroups(assertion->expression.get());
+    }
+}
+
+Program Compiler::compile(const AST& regex)
+{
+    program = Program();
+    matcherIndex.clear();
+    groupNumbers.clear();
+    groupCount = 1;
+    groupNames = { "" };
+
+    numberGroups(&regex);
+
+    emit(Instruction(ByteCode::Capture, reverse ? 1 : 0));
+    compileNode(&regex);
+    emit(Instruction(ByteCode::Capture, reverse ? 0 : 1));
+    emit(Instruction(ByteCode::Accept));
+
+    finish(program);
+    return std::move(program);
+}
+
+Program Compiler::compileSet(const std::vector<const AST*>& regexes)
+{
+    program = Program();
+    matcherIndex.clear();
+    groupNumbers.clear();
+    groupCount = 1;
+    std::vector<String> names = { "" };
+
+    // 与选择分支的编译相同，但每个分支以自己的 Accept 结束，不再跳到共同的出口
+    for (size_t i = 0; i < regexes.size(); ++i)
+    {
+        // 各模式的组名互不相干
+        groupNames = { "" };
+        numberGroups(regexes[i]);
+        names.insert(names.end(), groupNames.begin() + 1, groupNames.end());
+
+        size_t split = i + 1 < regexes.size() ? emit(Instruction(ByteCode::Split, here() + 1)) : VM::npos;
+        compileNode(regexes[i]);
+        emit(Instruction(ByteCode::Accept, i));
+        if (split != VM::npos)
+        {
+            program[split].operand_2 = static_cast<uint32_t>(here());
+        }
+    }
+    if (regexes.empty())
+    {
+        emit(Instruction(ByteCode::Halt));
+    }
+    groupNames = std::move(names);
+
+    finish(program);
+    return std::move(program);
+}
+
+void Compiler::finish(Program& target)
+{
+    target.groups = groupCount;
+    target.names = groupNames;
+    optimize(target);
+    for (Lookaround& lookaround : target.lookarounds)
+    {
+        finish(*lookaround.body);
+        // Lookarounds are evaluated with tables, before the search has
+        // captured anything, and the tables cannot cut alternatives
+        if (lookaround.body->hasBackreferences)
+        {
+            throw std::runtime_error("Backreferences are not supported in lookarounds");
+        }
+        if (lookaround.body->atomicGroups)
+        {
+            throw std::runtime_error("Atomic groups that can backtrack are not supported in lookarounds");
+        }
+    }
+}
+
+void Compiler::compileNode(const AST* node)
+{
+    if (auto regex = dynamic_cast<const Regex*>(node))
+    {
+        compileNode(regex->expression.get());
+    }
+    else if (auto expression = dynamic_cast<const Expression*>(node))
+    {
+        compileExpression(expression);
+    }
+    else if (auto term = dynamic_cast<const Term*>(node))
+    {
+        compileTerm(term);
+    }
+    else if (auto factor = dynamic_cast<const Factor*>(node))
+    {
+        compileFactor(factor);
+    }
+    else if (auto atom = dynamic_cast<const Atom*>(node))
+    {
+        compileNode(atom->atom.get());
+    }
+    else if (auto literal = dynamic_cast<const Literal*>(node))
+    {
+        // The empty literal stands for an empty term, e.g. in "a|"
+        if (!literal->value.empty())
+        {
+            emitMatch(node, Matcher(literal->value));
+        }
+    }
+    else if (auto characterClass = dynamic_cast<const CharacterClass*>(node))
+    {
+        emitMatch(node, toMatcher(characterClass));
+    }
+    else if (dynamic_cast<const AnyCharacter*>(node))
+    {
+        emitMatch(node, Matcher());
+    }
+    else if (auto group = dynamic_cast<const CapturingGroup*>(node))
+    {
+        size_t n = groupNumbers.at(node);
+        emit(Instruction(ByteCode::Capture, reverse ? 2 * n + 1 : 2 * n));
+        compileNode(group->expression.get());
+        emit(Instruction(ByteCode::Capture, reverse ? 2 * n : 2 * n + 1));
+    }
+    else if (auto group = dynamic_cast<const NamedCapturingGroup*>(node))
+    {
+        size_t n = groupNumbers.at(node);
+        emit(Instruction(ByteCode::Capture, reverse ? 2 * n + 1 : 2 * n));
+        compileNode(group->expression.get());
+        emit(Instruction(ByteCode::Capture, reverse ? 2 * n : 2 * n + 1));
+    }
+    else if (auto group = dynamic_cast<const NonCapturingGroup*>(node))
+    {
+        compileNode(group->expression.get());
+    }
+    else if (auto group = dynamic_cast<const AtomicGroup*>(node))
+    {
+        size_t atomic = emit(Instruction(ByteCode::Atomic, program.atomicGroups++));
+        compileNode(group->expression.get());
+        program[atomic].operand_2 = static_cast<uint32_t>(emit(Instruction(ByteCode::Commit, program[atomic].operand_1)));
+    }
+    else if (auto assertion = dynamic_cast<const LookaheadAssertion*>(node))
+    {
+        compileLookaround(assertion->expression.get(), true, assertion->isPositive);
+    }
+    else if (auto assertion = dynamic_cast<const LookbehindAssertion*>(node))
+    {
+        compileLookaround(assertion->expression.get(), false, assertion->isPositive);
+    }
+    else if (auto reference = dynamic_cast<const Backreference*>(node))
+    {
+        size_t n = reference->id;
+        if (!n)
+        {
+            auto it = std::find(groupNames.begin() + 1, groupNames.end(), reference->reference);
+            if (it == groupNames.end())
+            {
+                throw std::runtime_error("Reference to an undefined group: " + reference->reference.toUTF8());
+            }
+            n = it - groupNames.begin();
+        }
+        if (n >= groupCount)
+        {
+            throw std::runtime_error("Reference to an undefined group: " + std::to_string(n));
+        }
+        emit(Instruction(ByteCode::Ref, n));
+        program.hasBackreferences = true;
+    }
+    else if (auto anchor = dynamic_cast<const Anchor*>(node))
+    {
+        emit(Instruction(ByteCode::Anchor, static_cast<size_t>(
+            anchor->anchorType == Anchor::Type::Begin ? AnchorType::Begin : AnchorType::End)));
+    }
+    else
+    {
+        throw std::runtime_error("Unsupported syntax: " + node->toString().toUTF8());
+    }
+}
+
+void Compiler::compileExpression(const Expression* expression)
+{
+    const auto& terms = expression->terms;
+    std::vector<size_t> jumps;
+    for (size_t i = 0; i < terms.size(); ++i)
+    {
+        if (i + 1 == terms.size())
+        {
+            compileNode(terms[i].get());
+            break;
+        }
+        size_t split = emit(Instruction(ByteCode::Split, here() + 1));
+        compileNode(terms[i].get());
+        jumps.push_back(emit(Instruction(ByteCode::Jump)));
+        program[split].operand_2 = here();
+    }
+    for (size_t jump : jumps)
+    {
+        program[jump].operand_1 = here();
+    }
+}
+
+void Compiler::compileTerm(const Term* term)
+{
+    // 反向编译时因子逆序排列；锚点检查的是绝对位置，只需交换先后
+    if (reverse ? term->hasEndAnchor : term->hasBeginAnchor)
+    {
+        emit(Instruction(ByteCode::Anchor, static_cast<size_t>(reverse ? AnchorType::End : AnchorType::Begin)));
+    }
+    if (reverse)
+    {
+        for (auto it = term->factors.rbegin(); it != term->factors.rend(); ++it)
+        {
+            compileNode(it->get());
+        }
+    }
+    else
+    {
+        for (auto& factor : term->factors)
+        {
+            compileNode(factor.get());
+        }
+    }
+    if (reverse ? term->hasBeginAnchor : term->hasEndAnchor)
+    {
+        emit(Instruction(ByteCode::Anchor, static_cast<size_t>(reverse ? AnchorType::Begin : AnchorType::End)));
+    }
+}
+
+void Compiler::compileFactor(const Factor* factor)
+{
+    if (factor->type == Factor::Type::Assertion)
+    {
+        compileNode(factor->assertion.get());
+        return;
+    }
+    auto quantifier = dynamic_cast<const Quantifier*>(factor->atom_quantifier.second.get());
+    compileQuantified(factor->atom_quantifier.first.get(), quantifier);
+}
+
+void Compiler::compileQuantified(const AST* atom, const Quantifier* quantifier)
+{
+    // "Once" and "{1}" need no code of their own
+    if (!quantifier || quantifier->type == Quantifier::Type::Once)
+    {
+        compileNode(atom);
+        return;
+    }
+
+    // e*+ is (?>e*)
+    if (quantifier->possessive)
+    {
+        Quantifier greedy(quantifier->values.first, quantifier->values.second);
+        size_t atomic = emit(Instruction(ByteCode::Atomic, program.atomicGroups++));
+        compileQuantified(atom, &greedy);
+        program[atomic].operand_2 = static_cast<uint32_t>(emit(Instruction(ByteCode::Commit, program[atomic].operand_1)));
+        return;
+    }
+
+    int min = quantifier->values.first;
+    int max = quantifier->values.second;
+    bool lazy = quantifier->lazy;
+
+    // 试编译一次原子以得知其大小，展开后过大时改用计数循环
+    int bound = max == -1 ? min : max;
+    if (bound > 1)
+    {
+        size_t start = here();
+        size_t lookarounds = program.lookarounds.size();
+        size_t counters = program.counters.size();
+        size_t atomicGroups = program.atomicGroups;
+        compileNode(atom);
+        size_t size = here() - start;
+        program.instructions.erase(program.instructions.begin() + start, program.instructions.end());
+        program.lookarounds.resize(lookarounds);
+        program.counters.resize(counters);
+        program.atomicGroups = atomicGroups;
+        if (size * bound > unrollLimit)
+        {
+            size_t counter = program.counters.size();
+            program.counters.push_back({ static_cast<uint32_t>(min),
+                max == -1 ? Counter::unbounded : static_cast<uint32_t>(max), lazy });
+            size_t head = emit(Instruction(ByteCode::Repeat, counter));
+            compileNode(atom);
+            emit(Instruction(ByteCode::Loop, counter, head));
+            program[head].operand_2 = static_cast<uint32_t>(here());
+            return;
+        }
+    }
+
+    auto setSplit = [&](size_t split, size_t preferred, size_t other) {
+        program[split].operand_1 = lazy ? other : preferred;
+        program[split].operand_2 = lazy ? preferred : other;
+    };
+
+    for (int i = 0; i < min; ++i)
+    {
+        if (i + 1 == min && max == -1)
+        {
+            // The last mandatory copy loops: e{n,} is e{n-1}e+
+            size_t start = here();
+            compileNode(atom);
+            size_t split = emit(Instruction(ByteCode::Split));
+            setSplit(split, start, here());
+            return;
+        }
+        compileNode(atom);
+    }
+
+    if (max == -1)
+    {
+        size_t split = emit(Instruction(ByteCode::Split));
+        compileNode(atom);
+        emit(Instruction(ByteCode::Jump, split));
+        setSplit(split, split + 1, here());
+        return;
+    }
+
+    std::vector<size_t> splits;
+    for (int i = min; i < max; ++i)
+    {
+        splits.push_back(emit(Instruction(ByteCode::Split)));
+        compileNode(atom);
+    }
+    for (size_t split : splits)
+    {
+        setSplit(split, split + 1, here());
+    }
+}
+
+void Compiler::compileLookaround(const AST* expression, bool ahead, bool positive)
+{
+    // A lookahead is scanned backwards from the end of the text, so its body
+    // is compiled in reverse, whichever way the outer program runs.
+    Program outer = std::move(program);
+    auto outerMatchers = std::move(matcherIndex);
+    bool outerReverse = reverse;
+    program = Program();
+    matcherIndex.clear();
+    reverse = ahead;
+    compileNode(expression);
+    emit(Instruction(ByteCode::Accept));
+    auto body = std::make_shared<Program>(std::move(program));
+    program = std::move(outer);
+    matcherIndex = std::move(outerMatchers);
+    reverse = outerReverse;
+
+    program.lookarounds.push_back({ ahead, positive, body });
+    emit(Instruction(ByteCode::Assert, program.lookarounds.size() - 1));
+}
+
+// Resolves a class, with its nested classes and negations, into one set.
+Matcher Compiler::toMatcher(const CharacterClass* characterClass)
+{
+    Matcher matcher = Matcher::empty();
+    for (const auto& range : characterClass->ranges)
+    {
+        matcher += range;
+    }
+    for (const Char& ch : characterClass->chars)
+    {
+        matcher += ch;
+    }
+    for (const auto& nested : characterClass->classes)
+    {
+        matcher |= toMatcher(nested.get());
+    }
+    if (characterClass->isNegative)
+    {
+        matcher.complement();
+    }
+    return matcher;
+}
+
+// Drops the instructions marked in removed and renumbers jump targets.
+// A removed instruction's address becomes that of the next one kept.
+static void compact(Program& program, const std::vector<bool>& removed)
+{
+    size_t n = program.size();
+    std::vector<size_t> newIndex(n + 1);
+    size_t kept = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        newIndex[i] = kept;
+        if (!removed[i]) kept++;
+    }
+    newIndex[n] = kept;
+
+    std::vector<Instruction> instructions;
+    instructions.reserve(kept);
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (removed[i]) continue;
+        Instruction& instruction = program[i];
+        if (instruction.code == ByteCode::Jump || instruction.code == ByteCode::Split)
+        {
+            instruction.operand_1 = newIndex[instruction.operand_1];
+        }
+        if (instruction.code == ByteCode::Split || instruction.code == ByteCode::Repeat
+            || instruction.code == ByteCode::Loop || instruction.code == ByteCode::Atomic)
+        {
+            instruction.operand_2 = newIndex[instruction.operand_2];
+        }
+        instructions.emplace_back(std::move(instruction));
+    }
+    program.instructions = std::move(instructions);
+}
+
+// See Compiler::isPossessive(). The Commit of an atomic group around the
+// loop ends all giving back if cut is set, and is passed through otherwise,
+// as are the Commits of groups entered after the loop.
+static bool isPossessive(const Program& program, size_t loop, bool cut)
+{
+    size_t n = program.size();
+    const Instruction& instruction = program[loop];
+    size_t exit;
+    const Matcher* matcher;
+    if (instruction.code == ByteCode::Split && instruction.operand_1 == loop + 1 && loop + 2 < n
+        && program[loop + 1].code == ByteCode::Match
+        && program[loop + 2].code == ByteCode::Jump && program[loop + 2].operand_1 == loop)
+    {
+        exit = instruction.operand_2;
+        matcher = &program.matcher(program[loop + 1]);
+    }
+    else if (instruction.code == ByteCode::Match && loop + 1 < n
+        && program[loop + 1].code == ByteCode::Split && program[loop + 1].operand_1 == loop)
+    {
+        exit = program[loop + 1].operand_2;
+        matcher = &program.matcher(instruction);
+    }
+    else
+    {
+        return false;
+    }
+
+    // 在让出字符后的位置上，下一个字符属于该类：此后的路径若要消耗它就必须与类
+    // 相交，不消耗的路径则必须与位置无关，那样它在最长处已经试过
+    std::vector<bool> enclosing(n, false);
+    for (size_t pc = 0; cut && pc < loop; ++pc)
+    {
+        if (program[pc].code == ByteCode::Atomic && program[pc].operand_2 > loop)
+        {
+            enclosing[program[pc].operand_2] = true;
+        }
+    }
+    std::vector<bool> seen(n, false);
+    std::vector<size_t> pending = { exit };
+    while (!pending.empty())
+    {
+        size_t pc = pending.back();
+        pending.pop_back();
+        if (seen[pc])
+        {
+            continue;
+        }
+        seen[pc] = true;
+        const Instruction& next = program[pc];
+        switch (next.code)
+        {
+        case ByteCode::Jump:
+            pending.push_back(next.operand_1);
+            break;
+        case ByteCode::Split:
+            pending.push_back(next.operand_1);
+            pending.push_back(next.operand_2);
+            break;
+        case ByteCode::Capture:
+        case ByteCode::Atomic:
+            pending.push_back(pc + 1);
+            break;
+        case ByteCode::Commit:
+            if (!enclosing[pc])
+            {
+                pending.push_back(pc + 1);
+            }
+            break;
+        case ByteCode::Match:
+            if (!(program.matcher(next) & *matcher).getRanges().empty())
+            {
+                return false;
+            }
+            break;
+        case ByteCode::String:
+        {
+            char32_t c;
+            std::string_view literal = program.literal(next);
+            decodeUTF8(literal.data(), literal.size(), c);
+            if (matcher->match(Char(static_cast<int>(c))))
+            {
+                return false;
+            }
+            break;
+        }
+        case ByteCode::Anchor:
+            // $ cannot hold before a character; ^ can, at the start
+            if (next.operand_1 == static_cast<size_t>(AnchorType::Begin))
+            {
+                return false;
+            }
+            break;
+        case ByteCode::Accept:
+        case ByteCode::Halt:
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Compiler::isPossessive(const Program& program, size_t loop)
+{
+    return ::isPossessive(program, loop, true);
+}
+
+// Drops the atomic groups whose bodies cannot backtrack once left: those
+// without any choice, and those that are a possessive loop anyway. Inner
+// groups are looked at first. The groups kept are numbered again.
+static void dropAtomicGroups(Program& program)
+{
+    if (!program.atomicGroups)
+    {
+        return;
+    }
+    size_t n = program.size();
+    std::vector<bool> removed(n, false);
+    for (size_t atomic = n; atomic-- > 0;)
+    {
+        if (program[atomic].code != ByteCode::Atomic)
+        {
+            continue;
+        }
+        size_t commit = program[atomic].operand_2;
+        bool choices = false;
+        for (size_t pc = atomic + 1; pc < commit; ++pc)
+        {
+            ByteCode code = program[pc].code;
+            choices = choices || (!removed[pc] && (code == ByteCode::Split || code == ByteCode::Repeat
+                || code == ByteCode::Loop || code == ByteCode::Atomic));
+        }
+        size_t size = commit - atomic - 1;
+        bool loop = (size == 3 || size == 2) && isPossessive(program, atomic + 1, false)
+            && program[atomic + 1].code == (size == 3 ? ByteCode::Split : ByteCode::Match);
+        if (!choices || loop)
+        {
+            removed[atomic] = removed[commit] = true;
+        }
+    }
+
+    std::vector<size_t> number(program.atomicGroups, VM::npos);
+    size_t kept = 0;
+    for (size_t pc = 0; pc < n; ++pc)
+    {
+        Instruction& instruction = program[pc];
+        if (!removed[pc] && instruction.code == ByteCode::Atomic)
+        {
+            number[instruction.operand_1] = kept++;
+        }
+        if (!removed[pc] && (instruction.code == ByteCode::Atomic || instruction.code == ByteCode::Commit))
+        {
+            instruction.operand_1 = static_cast<uint32_t>(number[instruction.operand_1]);
+        }
+    }
+    program.atomicGroups = kept;
+    compact(program, removed);
+}
+
+static bool isLiteralMatch(const Program& program, const Instruction& instruction)
+{
+    return instruction.code == ByteCode::Match
+        && program.matcher(instruction).getType() == Matcher::Type::Literal;
+}
+
+// Peephole pass:
+//   - atomic groups that cannot backtrack are dropped,
+//   - jumps to jumps are redirected to the final target,
+//   - a Split with two equal targets becomes a Jump,
+//   - jumps to the next instruction are dropped,
+//   - runs of single-character matches become one String instruction.
+void Compiler::optimize(Program& program)
+{
+    dropAtomicGroups(program);
+    size_t n = program.size();
+
+    auto resolve = [&](size_t target) {
+        for (size_t hops = 0; hops < n && program[target].code == ByteCode::Jump; ++hops)
+        {
+            target = program[target].operand_1;
+        }
+        return target;
+    };
+
+    std::vector<bool> removed(n, false);
+    for (size_t i = 0; i < n; ++i)
+    {
+        Instruction& instruction = program[i];
+        if (instruction.code == ByteCode::Split)
+        {
+            instruction.operand_1 = resolve(instruction.operand_1);
+            instruction.operand_2 = resolve(instruction.operand_2);
+            if (instruction.operand_1 == instruction.operand_2)
+            {
+                instruction.code = ByteCode::Jump;
+            }
+        }
+        if (instruction.code == ByteCode::Jump)
+        {
+            instruction.operand_1 = resolve(instruction.operand_1);
+            removed[i] = instruction.operand_1 == i + 1;
+        }
+    }
+    compact(program, removed);
+
+    n = program.size();
+    std::vector<bool> isTarget(n, false);
+    for (const Instruction& instruction : program.instructions)
+    {
+        if (instruction.code == ByteCode::Jump || instruction.code == ByteCode::Split)
+        {
+            isTarget[instruction.operand_1] = true;
+        }
+        if (instruction.code == ByteCode::Split || instruction.code == ByteCode::Repeat
+            || instruction.code == ByteCode::Loop)
+        {
+            isTarget[instruction.operand_2] = true;
+        }
+    }
+
+    removed.assign(n, false);
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!isLiteralMatch(program, program[i]))
+        {
+            continue;
+        }
+        size_t j = i + 1;
+        while (j < n && !isTarget[j] && isLiteralMatch(program, program[j]))
+        {
+            j++;
+        }
+        if (j - i < 2)
+        {
+            continue;
+        }
+        std::string literal;
+        for (size_t k = i; k < j; ++k)
+        {
+            literal += program.matcher(program[k]).getLiteral().toUTF8();
+            removed[k] = k != i;
+        }
+        program[i] = Instruction(ByteCode::String, program.literals.size(), literal.size());
+        program.literals += literal;
+        i = j - 1;
+    }
+    compact(program, removed);
+
+    // Drop the classes no Match refers to any more
+    std::vector<Matcher> matchers;
+    std::map<size_t, size_t> renumbered;
+    for (Instruction& instruction : program.instructions)
+    {
+        if (instruction.code == ByteCode::Match)
+        {
+            auto [it, added] = renumbered.emplace(instruction.operand_1, matchers.size());
+            if (added)
+            {
+                matchers.push_back(std::move(program.matchers[instruction.operand_1]));
+            }
+            instruction.operand_1 = static_cast<uint32_t>(it->second);
+        }
+    }
+    program.matchers = std::move(matchers);
+}
+
+using ByteSequence = std::vector<std::pair<uint8_t, uint8_t>>;
+
+// Splits the code points [first, last] into ranges whose encodings are all
+// the same length and run through whole ranges of every byte, and appends the
+// byte sequence of each.
+static void utf8Sequences(int first, int last, std::vector<ByteSequence>& sequences)
+{
+    std::vector<std::pair<int, int>> pending = { { first, last } };
+    while (!pending.empty())
+    {
+        auto [start, end] = pending.back();
+        pending.pop_back();
+        if (start > end)
+        {
+            continue;
+        }
+        // 代理项没有 UTF-8 编码
+        if (start <= 0xDFFF && end >= 0xD800)
+        {
+            pending.push_back({ 0xE000, end });
+            pending.push_back({ start, 0xD7FF });
+            continue;
+        }
+
+        bool split = false;
+        for (int limit : { 0x7F, 0x7FF, 0xFFFF })
+        {
+            if (start <= limit && end > limit)
+            {
+                pending.push_back({ limit + 1, end });
+                pending.push_back({ start, limit });
+                split = true;
+                break;
+            }
+        }
+        // The last i continuation bytes must run from 80 to BF unless the
+        // bytes before them are the same at both ends
+        for (int i = 1; i < 4 && !split && end > 0x7F; ++i)
+        {
+            int mask = (1 << (6 * i)) - 1;
+            if ((start & ~mask) == (end & ~mask))
+            {
+                continue;
+            }
+            if (start & mask)
+            {
+                pending.push_back({ (start | mask) + 1, end });
+                pending.push_back({ start, start | mask });
+                split = true;
+            }
+            else if ((end & mask) != mask)
+            {
+                pending.push_back({ end & ~mask, end });
+                pending.push_back({ start, (end & ~mask) - 1 });
+                split = true;
+            }
+        }
+        if (split)
+        {
+            continue;
+        }
+
+        std::string low, high;
+        appendUTF8(low, static_cast<char32_t>(start));
+        appendUTF8(high, static_cast<char32_t>(end));
+        ByteSequence sequence;
+        for (size_t k = 0; k < low.size(); ++k)
+        {
+            sequence.emplace_back(static_cast<uint8_t>(low[k]), static_cast<uint8_t>(high[k]));
+        }
+        sequences.push_back(std::move(sequence));
+    }
+}
+
+// Trie of the byte sequences of a class. Two edges of a node are either the
+// same range or disjoint. An edge without a child ends a character.
+struct ByteTrie
+{
+    struct Edge
+    {
+        uint8_t low;
+        uint8_t high;
+        size_t child;
+    };
+
+    std::vector<std::vector<Edge>> nodes = { {} };
+
+    void insert(const ByteSequence& sequence)
+    {
+        size_t node = 0;
+        for (size_t k = 0; k < sequence.size(); ++k)
+        {
+            bool last = k + 1 == sequence.size();
+            auto [low, high] = sequence[k];
+            auto& edges = nodes[node];
+            auto it = std::find_if(edges.begin(), edges.end(),
+                [&](const Edge& edge) { return edge.low == low && edge.high == high; });
+            if (it == edges.end())
+            {
+                edges.push_back({ low, high, last ? VM::npos : nodes.size() });
+                if (!last)
+                {
+                    nodes.emplace_back();
+                }
+                node = nodes.size() - 1;
+            }
+            else
+            {
+                node = it->child;
+            }
+        }
+    }
+};
+
+// Emits the code of a trie node after that of its children and returns where
+// it begins. Nodes with the same edges to the same code share it, which
+// merges the common suffixes of the sequences. The Jumps that leave the class
+// are appended to exits.
+static size_t emitNode(Program& target, const ByteTrie& trie, size_t node,
+    std::map<std::vector<size_t>, size_t>& shared, std::vector<size_t>& exits)
+{
+    std::vector<ByteTrie::Edge> edges = trie.nodes[node];
+    std::sort(edges.begin(), edges.end(),
+        [](const ByteTrie::Edge& a, const ByteTrie::Edge& b) { return a.low < b.low; });
+
+    std::vector<size_t> key;
+    for (const ByteTrie::Edge& edge : edges)
+    {
+        size_t next = edge.child == VM::npos ? VM::npos : emitNode(target, trie, edge.child, shared, exits);
+        key.insert(key.end(), { edge.low, edge.high, next });
+    }
+    auto it = shared.find(key);
+    if (it != shared.end())
+    {
+        return it->second;
+    }
+
+    size_t begin = target.size();
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        size_t split = VM::npos;
+        if (i + 1 < edges.size())
+        {
+            split = target.size();
+            target.instructions.emplace_back(ByteCode::Split, target.size() + 1);
+        }
+        target.instructions.emplace_back(ByteCode::ByteRange, edges[i].low, edges[i].high);
+        if (key[3 * i + 2] == VM::npos)
+        {
+            exits.push_back(target.size());
+        }
+        target.instructions.emplace_back(ByteCode::Jump, key[3 * i + 2]);
+        if (split != VM::npos)
+        {
+            target[split].operand_2 = target.size();
+        }
+    }
+    shared.emplace(std::move(key), begin);
+    return begin;
+}
+
+Program Compiler::toBytes(const Program& program, bool reverse)
+{
+    Program result;
+    result.literals = program.literals;
+    result.groups = program.groups;
+    result.names = program.names;
+    result.lookarounds = program.lookarounds;
+    result.counters = program.counters;
+    result.atomicGroups = program.atomicGroups;
+    result.hasBackreferences = program.hasBackreferences;
+
+    // Where each instruction went, and the instructions whose targets are
+    // still those of program
+    std::vector<size_t> moved(program.size() + 1);
+    std::vector<size_t> unresolved;
+
+    for (size_t pc = 0; pc < program.size(); ++pc)
+    {
+        moved[pc] = result.size();
+        const Instruction& instruction = program[pc];
+        if (instruction.code != ByteCode::Match)
+        {
+            result.instructions.push_back(instruction);
+            if (instruction.code == ByteCode::Jump || instruction.code == ByteCode::Split
+                || instruction.code == ByteCode::Repeat || instruction.code == ByteCode::Loop
+                || instruction.code == ByteCode::Atomic)
+            {
+                unresolved.push_back(result.size() - 1);
+            }
+            if (instruction.code == ByteCode::String && reverse)
+            {
+                auto literal = result.literals.begin() + instruction.operand_1;
+                for (size_t k = 0; k < instruction.operand_2;)
+                {
+                    char32_t codepoint;
+                    size_t length = std::max<size_t>(1,
+                        decodeUTF8(&*literal + k, instruction.operand_2 - k, codepoint));
+                    std::reverse(literal + k, literal + k + length);
+                    k += length;
+                }
+            }
+            continue;
+        }
+
+        std::vector<ByteSequence> sequences;
+        for (auto [first, last] : program.matcher(instruction).getRanges())
+        {
+            utf8Sequences(first, last, sequences);
+        }
+        if (sequences.empty())
+        {
+            result.instructions.emplace_back(ByteCode::Halt);
+            continue;
+        }
+        ByteTrie trie;
+        for (ByteSequence& sequence : sequences)
+        {
+            if (reverse)
+            {
+                std::reverse(sequence.begin(), sequence.end());
+            }
+            trie.insert(sequence);
+        }
+
+        size_t entry = result.size();
+        result.instructions.emplace_back(ByteCode::Jump);
+        std::map<std::vector<size_t>, size_t> shared;
+        std::vector<size_t> exits;
+        result[entry].operand_1 = emitNode(result, trie, 0, shared, exits);
+        for (size_t exit : exits)
+        {
+            result[exit].operand_1 = pc + 1;
+            unresolved.push_back(exit);
+        }
+    }
+    moved[program.size()] = result.size();
+
+    for (size_t at : unresolved)
+    {
+        Instruction& instruction = result[at];
+        if (instruction.code == ByteCode::Jump || instruction.code == ByteCode::Split)
+        {
+            instruction.operand_1 = moved[instruction.operand_1];
+        }
+        if (instruction.code != ByteCode::Jump)
+        {
+            instruction.operand_2 = moved[instruction.operand_2];
+        }
+    }
+    optimize(result);
+    return result;
+}
+
+std::array<uint8_t, 256> Compiler::byteClasses(const Program& program)
+{
+    // boundaries[b]: b and b - 1 are told apart
+    std::array<bool, 257> boundaries{};
+    auto split = [&](size_t low, size_t high) {
+        boundaries[low] = true;
+        boundaries[high + 1] = true;
+    };
+    for (const Instruction& instruction : program.instructions)
+    {
+        if (instruction.code == ByteCode::ByteRange)
+        {
+            split(instruction.operand_1, instruction.operand_2);
+        }
+        else if (instruction.code == ByteCode::String)
+        {
+            for (unsigned char c : program.literal(instruction))
+            {
+                split(c, c);
+            }
+        }
+    }
+
+    std::array<uint8_t, 256> classes;
+    uint8_t current = 0;
+    for (size_t b = 0; b < 256; ++b)
+    {
+        if (b > 0 && boundaries[b])
+        {
+            current++;
+        }
+        classes[b] = current;
+    }
+    return classes;
+}
@@ -0,0 +1,125 @@
+#ifndef _COMPILER_HH_
+#define _COMPILER_HH_
+
+#include <array>
+#include <map>
+#include "vm.hh"
+
+// Lowers the AST built by Parser into Thompson-style bytecode.
+//
+//   e1 | e2      Split L1, L2
+//                L1: e1
+//                    Jump L3
+//                L2: e2
+//                L3:
+//
+//   e*           L1: Split L2, L3
+//                L2: e
+//                    Jump L1
+//                L3:
+//
+//   e+           L1: e
+//                    Split L1, L2
+//                L2:
+//
+//   e?           Split L1, L2
+//                L1: e
+//                L2:
+//
+// Lazy quantifiers swap the two targets of their Split.
+//
+// e{n,m} is unrolled into n copies of e followed by m - n optional ones,
+// unless that would take more than unrollLimit instructions. Then e is
+// compiled once, as a counted loop:
+//
+//   e{n,m}       L1: Repeat c, L2
+//                    e
+//                    Loop c, L1
+//                L2:
+//
+// where the counter c holds n and m (see Program::counters). The engines
+// keep the count of every thread, so the program stays the size of the
+// pattern: .{1,5000} takes a few instructions rather than 10000.
+//
+// An atomic group is bracketed by Atomic and Commit, and a possessive
+// quantifier is an atomic group around its greedy form: e*+ is (?>e*).
+//
+//   (?>e)        Atomic g, L1
+//                    e
+//                L1: Commit g
+//
+// The result is then cleaned up by a peephole pass (see optimize()), which
+// also drops the atomic groups that could not backtrack anyway, so that
+// \d++\. runs on the DFA like \d+\. does.
+//
+// A reverse compiler emits the factors of every term in reverse order, for
+// engines that scan the text backwards from the end of a match.
+class Compiler
+{
+public:
+    static constexpr size_t unrollLimit = 256;
+
+    Compiler(bool _reverse = false);
+
+    Program compile(const AST& regex);
+
+    // Compiles the union of regexes, in which a match of regexes[i] ends
+    // with Accept i rather than with a common Accept, and records no
+    // captures. Engines that keep every thread (DFA::scanAccepts() and
+    // VM::scanAccepts()) then tell which of the patterns match, in one pass.
+    Program compileSet(const std::vector<const AST*>& regexes);
+
+    // Lexes, parses and compiles a pattern.
+    static Program compile(const String& pattern);
+
+    // Lowers every Match of a program to an automaton over the UTF-8 bytes
+    // of the characters it matches, made of ByteRange instructions. The
+    // class is split into ranges of code points whose encodings are the same
+    // length and differ only in bytes that run through whole ranges (as in
+    // RE2 and Rust's utf8-ranges), and those byte sequences are merged into a
+    // trie whose identical subtrees are emitted once. A reverse program reads
+    // the bytes of each character last to first.
+    static Program toBytes(const Program& program, bool reverse);
+
+    // Partitions the bytes into classes that no instruction of a lowered
+    // program tells apart, and returns the class of each byte. Classes are
+    // numbered from 0 in byte order, so the last byte has the highest.
+    static std::array<uint8_t, 256> byteClasses(const Program& program);
+
+    // Whether the greedy loop over one class at loop (the Split of e* or the
+    // Match of e+, as compiled above) never has to give characters back:
+    // nothing that can follow it begins with a character of the class, or
+    // could hold a character earlier. Such a loop, as in \d+\., can run
+    // possessively, as if it were \d++\.; the backtracker does.
+    static bool isPossessive(const Program& program, size_t loop);
+
+private:
+    Program program;
+
+    // Group number of each capturing group node, assigned in pattern order.
+    std::map<const AST*, size_t> groupNumbers;
+    // Entry of each atom in the class table of the program being compiled.
+    std::map<const AST*, size_t> matcherIndex;
+    size_t groupCount;
+    std::vector<String> groupNames;
+
+    bool reverse;
+
+    size_t emit(Instruction instruction);
+    size_t here() const;
+    size_t emitMatch(const AST* node, Matcher matcher);
+
+    void compileNode(const AST* node);
+    void compileExpression(const Expression* expression);
+    void compileTerm(const Term* term);
+    void compileFactor(const Factor* factor);
+    void compileQuantified(const AST* atom, const Quantifier* quantifier);
+    void compileLookaround(const AST* expression, bool ahead, bool positive);
+    Matcher toMatcher(const CharacterClass* characterClass);
+    void numberGroups(const AST* node);
+    void finish(Program& target);
+
+    static void optimize(Program& program);
+};
+
+#endif // !_COMPILER_HH_
@@ -0,0 +1,1484 @@
+#ifndef _CT_REGEX_HH_
+#define _CT_REGEX_HH_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+// Regular expressions compiled by the C++ compiler.
+//
+// sweetie::ct_regex<"pattern"> parses its pattern and builds the program
+// during constant evaluation, so a malformed pattern is a compile error and
+// nothing is parsed, allocated or set up at run time. Matching is constexpr
+// too:
+//
+//     using Date = sweetie::ct_regex<"[0-9]{4}-[0-9]{2}-[0-9]{2}">;
+//     static_assert(Date::match("2024-01-31"));
+//
+// The program is a byte-level NFA like the one the DFA runs, with classes
+// lowered to UTF-8 sequences. The subset construction runs at compile time
+// too and turns it into static transition tables, so that matching is one
+// table lookup per byte. Priorities are leftmost-first, so find() reports
+// the same match as Pattern::find(); a reverse table finds where it begins.
+// A pattern that needs more than 4096 states in a table does not compile.
+//
+// The parser and compiler here are separate from Lexer and Parser, and
+// accept what Pattern accepts minus the parts that need captures or
+// lookaround: literals, ., classes with ranges, \d \s \w and their
+// negations, escapes, groups (which only group), |, the greedy and lazy
+// forms of * + ? {m,n}, and ^ $. Lookaround, atomic groups, possessive
+// quantifiers, backreferences, \p and \b are rejected.
+namespace sweetie
+{
+    // A string literal usable as a template argument
+    template <size_t N>
+    struct fixed_string
+    {
+        char data[N] {};
+
+        constexpr fixed_string(const char (&s)[N])
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                data[i] = s[i];
+            }
+        }
+
+        constexpr std::string_view view() const { return { data, N - 1 }; }
+    };
+
+    namespace detail
+    {
+        // Bytes consumes one byte of the set; Split prefers x over y
+        enum class CtOp : uint8_t { Bytes, Split, Jump, Begin, End, Accept };
+
+        struct CtInstruction
+        {
+            CtOp op = CtOp::Accept;
+            uint32_t x = 0;
+            uint32_t y = 0;
+            uint64_t bytes[4] {};
+
+            constexpr void add(unsigned lo, unsigned hi)
+            {
+                for (unsigned b = lo; b <= hi; ++b)
+                {
+                    bytes[b >> 6] |= uint64_t(1) << (b & 63);
+                }
+            }
+
+            constexpr bool has(unsigned char b) const
+            {
+                return bytes[b >> 6] >> (b & 63) & 1;
+            }
+        };
+
+        // A set of code points as ranges, sorted by their lower bound
+        struct CtClass
+        {
+            static constexpr size_t capacity = 128;
+
+            uint32_t low[capacity] {};
+            uint32_t high[capacity] {};
+            size_t count = 0;
+
+            constexpr void add(uint32_t lo, uint32_t hi)
+            {
+                if (count == capacity)
+                {
+                    throw std::runtime_error("Too many ranges in a character class");
+                }
+                size_t i = count++;
+                for (; i > 0 && low[i - 1] > lo; --i)
+                {
+                    low[i] = low[i - 1];
+                    high[i] = high[i - 1];
+                }
+                low[i] = lo;
+                high[i] = hi;
+            }
+
+            constexpr void add(const CtClass& other)
+            {
+                for (size_t i = 0; i < other.count; ++i)
+                {
+                    add(other.low[i], other.high[i]);
+                }
+            }
+
+            // Merges overlapping and adjacent ranges and takes the surrogates
+            // out, which UTF-8 cannot encode
+            constexpr void normalize()
+            {
+                CtClass merged;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    size_t last = merged.count - 1;
+                    if (merged.count && low[i] <= merged.high[last] + 1)
+                    {
+                        merged.high[last] = high[i] > merged.high[last] ? high[i] : merged.high[last];
+                    }
+                    else
+                    {
+                        merged.low[merged.count] = low[i];
+                        merged.high[merged.count++] = high[i];
+                    }
+                }
+                count = 0;
+                for (size_t i = 0; i < merged.count; ++i)
+                {
+                    if (merged.high[i] < 0xD800 || merged.low[i] > 0xDFFF)
+                    {
+                        add(merged.low[i], merged.high[i]);
+                        continue;
+                    }
+                    if (merged.low[i] < 0xD800)
+                    {
+                        add(merged.low[i], 0xD7FF);
+                    }
+                    if (merged.high[i] > 0xDFFF)
+                    {
+                        add(0xE000, merged.high[i]);
+                    }
+                }
+            }
+
+            constexpr void negate()
+            {
+                normalize();
+                CtClass complement;
+                uint32_t next = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (low[i] > next)
+                    {
+                        complement.add(next, low[i] - 1);
+                    }
+                    next = high[i] + 1;
+                }
+                if (next <= 0x10FFFF)
+                {
+                    complement.add(next, 0x10FFFF);
+                }
+                *this = complement;
+                normalize();
+            }
+        };
+
+        // A run of bytes low[i]..high[i] for each of length bytes
+        struct CtSequence
+        {
+            uint8_t low[4] {};
+            uint8_t high[4] {};
+            size_t length = 0;
+        };
+
+        struct CtSequences
+        {
+            static constexpr size_t capacity = 256;
+
+            CtSequence items[capacity] {};
+            size_t count = 0;
+        };
+
+        constexpr size_t utf8Length(uint32_t c)
+        {
+            return c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+        }
+
+        constexpr void encodeUTF8(uint32_t c, uint8_t* out)
+        {
+            switch (utf8Length(c))
+            {
+            case 1:
+                out[0] = static_cast<uint8_t>(c);
+                break;
+            case 2:
+                out[0] = static_cast<uint8_t>(0xC0 | c >> 6);
+                out[1] = static_cast<uint8_t>(0x80 | (c & 0x3F));
+                break;
+            case 3:
+                out[0] = static_cast<uint8_t>(0xE0 | c >> 12);
+                out[1] = static_cast<uint8_t>(0x80 | (c >> 6 & 0x3F));
+                out[2] = static_cast<uint8_t>(0x80 | (c & 0x3F));
+                break;
+            default:
+                out[0] = static_cast<uint8_t>(0xF0 | c >> 18);
+                out[1] = static_cast<uint8_t>(0x80 | (c >> 12 & 0x3F));
+                out[2] = static_cast<uint8_t>(0x80 | (c >> 6 & 0x3F));
+                out[3] = static_cast<uint8_t>(0x80 | (c & 0x3F));
+                break;
+            }
+        }
+
+        // Splits lo..hi into ranges whose encodings differ only in runs of
+        // bytes, the same way Compiler::toBytes() does
+        constexpr void utf8Sequences(uint32_t lo, uint32_t hi, CtSequences& out)
+        {
+            for (uint32_t limit : { 0x7Fu, 0x7FFu, 0xFFFFu })
+            {
+                if (lo <= limit && hi > limit)
+                {
+                    utf8Sequences(lo, limit, out);
+                    utf8Sequences(limit + 1, hi, out);
+                    return;
+                }
+            }
+            size_t length = utf8Length(lo);
+            for (size_t i = 1; i < length; ++i)
+            {
+                uint32_t mask = (1u << (6 * i)) - 1;
+                if ((lo & ~mask) != (hi & ~mask))
+                {
+                    if ((lo & mask) != 0)
+                    {
+                        utf8Sequences(lo, lo | mask, out);
+                        utf8Sequences((lo | mask) + 1, hi, out);
+                        return;
+                    }
+                    if ((hi & mask) != mask)
+                    {
+                        utf8Sequences(lo, (hi & ~mask) - 1, out);
+                        utf8Sequences(hi & ~mask, hi, out);
+                        return;
+                    }
+                }
+            }
+            if (out.count == CtSequences::capacity)
+            {
+                throw std::runtime_error("Character class is too large");
+            }
+            CtSequence& sequence = out.items[out.count++];
+            encodeUTF8(lo, sequence.low);
+            encodeUTF8(hi, sequence.high);
+            sequence.length = length;
+        }
+
+        // Parses a pattern and emits its program into code, or only counts
+        // the instructions when code is nullptr
+        class CtCompiler
+        {
+        public:
+            constexpr CtCompiler(std::string_view _pattern, CtInstruction* _code)
+                : pattern(_pattern), code(_code)
+            {
+            }
+
+            // Returns the number of instructions
+            constexpr size_t compile()
+            {
+                parseExpression();
+                if (position < pattern.size())
+                {
+                    fail("Unmatched ')'");
+                }
+                emit({ CtOp::Accept });
+                return size;
+            }
+
+        private:
+            static constexpr uint32_t infinity = UINT32_MAX;
+
+            std::string_view pattern;
+            CtInstruction* code;
+            size_t position = 0;
+            size_t size = 0;
+
+            // Set while a piece is parsed only to find its length
+            bool dry = false;
+
+            // Not constexpr, so reaching it while the compiler evaluates a
+            // pattern is a compile error that shows the message
+            [[noreturn]] static void fail(const char* message)
+            {
+                throw std::runtime_error(message);
+            }
+
+            constexpr bool end() const { return position >= pattern.size(); }
+            constexpr char peek() const { return pattern[position]; }
+
+            constexpr size_t emit(CtInstruction instruction)
+            {
+                if (code && !dry)
+                {
+                    code[size] = instruction;
+                }
+                return size++;
+            }
+
+            constexpr void patch(size_t at, size_t x, size_t y = 0)
+            {
+                if (code && !dry)
+                {
+                    code[at].x = static_cast<uint32_t>(x);
+                    code[at].y = static_cast<uint32_t>(y);
+                }
+            }
+
+            constexpr void branch(size_t at, size_t preferred, size_t other, bool lazy)
+            {
+                lazy ? patch(at, other, preferred) : patch(at, preferred, other);
+            }
+
+            // Runs a parse without emitting anything and returns how many
+            // instructions it would emit; position is left after it
+            template <typename Parse>
+            constexpr size_t measure(Parse parse)
+            {
+                size_t start = size;
+                bool wasDry = dry;
+                dry = true;
+                (this->*parse)();
+                dry = wasDry;
+                size_t length = size - start;
+                size = start;
+                return length;
+            }
+
+            constexpr void parseExpression()
+            {
+                size_t begin = position;
+                measure(&CtCompiler::parseSequence);
+                if (end() || peek() != '|')
+                {
+                    position = begin;
+                    parseSequence();
+                    return;
+                }
+                position = begin;
+                size_t split = emit({ CtOp::Split });
+                parseSequence();
+                size_t jump = emit({ CtOp::Jump });
+                position++;
+                patch(split, split + 1, size);
+                parseExpression();
+                patch(jump, size);
+            }
+
+            constexpr void parseSequence()
+            {
+                while (!end() && peek() != '|' && peek() != ')')
+                {
+                    parsePiece();
+                }
+            }
+
+            constexpr uint32_t parseNumber()
+            {
+                if (end() || peek() < '0' || peek() > '9')
+                {
+                    fail("Expected a number in a quantifier");
+                }
+                uint32_t n = 0;
+                while (!end() && peek() >= '0' && peek() <= '9')
+                {
+                    n = n * 10 + (pattern[position++] - '0');
+                    if (n > 100000)
+                    {
+                        fail("Quantifier is too large");
+                    }
+                }
+                return n;
+            }
+
+            constexpr void parsePiece()
+            {
+                size_t begin = position;
+                size_t length = measure(&CtCompiler::parseAtom);
+
+                uint32_t min = 1, max = 1;
+                bool quantified = !end();
+                switch (quantified ? peek() : 0)
+                {
+                case '*': min = 0; max = infinity; position++; break;
+                case '+': min = 1; max = infinity; position++; break;
+                case '?': min = 0; max = 1; position++; break;
+                case '{':
+                    position++;
+                    min = max = parseNumber();
+                    if (!end() && peek() == ',')
+                    {
+                        position++;
+                        max = !end() && peek() == '}' ? infinity : parseNumber();
+                    }
+                    if (end() || peek() != '}')
+                    {
+                        fail("Missing '}' in a quantifier");
+                    }
+                    if (min > max)
+                    {
+                        fail("Quantifier range out of order");
+                    }
+                    position++;
+                    break;
+                default:
+                    quantified = false;
+                    break;
+                }
+                bool lazy = quantified && !end() && peek() == '?';
+                if (lazy)
+                {
+                    position++;
+                }
+                else if (quantified && !end() && peek() == '+')
+                {
+                    fail("Possessive quantifiers are not supported by ct_regex");
+                }
+                size_t after = position;
+
+                auto atom = [&] {
+                    position = begin;
+                    parseAtom();
+                };
+                if (!quantified)
+                {
+                    atom();
+                }
+                else
+                {
+                    emitQuantified(atom, length, min, max, lazy);
+                }
+                position = after;
+            }
+
+            // Same shape as the runtime compiler: min copies, then a loop or
+            // max - min optional copies that all skip to the end
+            template <typename Atom>
+            constexpr void emitQuantified(Atom atom, size_t length, uint32_t min, uint32_t max, bool lazy)
+            {
+                for (uint32_t i = 0; i < min; ++i)
+                {
+                    if (i + 1 == min && max == infinity)
+                    {
+                        size_t start = size;
+                        atom();
+                        size_t split = emit({ CtOp::Split });
+                        branch(split, start, size, lazy);
+                        return;
+                    }
+                    atom();
+                }
+                if (max == infinity)
+                {
+                    size_t split = emit({ CtOp::Split });
+                    atom();
+                    emit({ CtOp::Jump, static_cast<uint32_t>(split) });
+                    branch(split, split + 1, size, lazy);
+                    return;
+                }
+                size_t exit = size + (max - min) * (length + 1);
+                for (uint32_t i = min; i < max; ++i)
+                {
+                    size_t split = emit({ CtOp::Split });
+                    atom();
+                    branch(split, split + 1, exit, lazy);
+                }
+            }
+
+            constexpr void parseAtom()
+            {
+                if (end())
+                {
+                    fail("Unexpected end of pattern");
+                }
+                switch (peek())
+                {
+                case '(':
+                    parseGroup();
+                    return;
+                case '[':
+                    emitClass(parseClass());
+                    return;
+                case '.': {
+                    position++;
+                    CtClass dot;
+                    dot.add('\n', '\n');
+                    dot.add('\r', '\r');
+                    dot.add(0x2028, 0x2029);
+                    dot.negate();
+                    emitClass(dot);
+                    return;
+                }
+                case '^':
+                    position++;
+                    emit({ CtOp::Begin });
+                    return;
+                case '$':
+                    position++;
+                    emit({ CtOp::End });
+                    return;
+                case '*': case '+': case '?': case '{':
+                    fail("Nothing to repeat before a quantifier");
+                    return;
+                case '\\': {
+                    CtClass set;
+                    uint32_t c = parseEscape(set);
+                    if (c == infinity)
+                    {
+                        emitClass(set);
+                    }
+                    else
+                    {
+                        emitCharacter(c);
+                    }
+                    return;
+                }
+                default:
+                    emitCharacter(parseCharacter());
+                    return;
+                }
+            }
+
+            constexpr void parseGroup()
+            {
+                position++;
+                if (!end() && peek() == '?')
+                {
+                    position++;
+                    char kind = end() ? 0 : peek();
+                    char next = position + 1 < pattern.size() ? pattern[position + 1] : 0;
+                    if (kind == ':')
+                    {
+                        position++;
+                    }
+                    else if (kind == '<' && next != '=' && next != '!')
+                    {
+                        while (!end() && peek() != '>')
+                        {
+                            position++;
+                        }
+                        if (end())
+                        {
+                            fail("Missing '>' after a group name");
+                        }
+                        position++;
+                    }
+                    else if (kind == '=' || kind == '!' || kind == '<')
+                    {
+                        fail("Lookaround is not supported by ct_regex");
+                    }
+                    else if (kind == '>')
+                    {
+                        fail("Atomic groups are not supported by ct_regex");
+                    }
+                    else
+                    {
+                        fail("Invalid group");
+                    }
+                }
+                parseExpression();
+                if (end() || peek() != ')')
+                {
+                    fail("Missing ')'");
+                }
+                position++;
+            }
+
+            // Decodes one UTF-8 character of the pattern
+            constexpr uint32_t parseCharacter()
+            {
+                uint8_t lead = static_cast<uint8_t>(pattern[position++]);
+                size_t length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+                uint32_t c = length == 1 ? lead : lead & (0x7F >> length);
+                for (size_t i = 1; i < length; ++i)
+                {
+                    if (end())
+                    {
+                        fail("Invalid UTF-8 in pattern");
+                    }
+                    c = c << 6 | (static_cast<uint8_t>(pattern[position++]) & 0x3F);
+                }
+                return c;
+            }
+
+            constexpr uint32_t parseHex(size_t digits)
+            {
+                uint32_t c = 0;
+                for (size_t i = 0; i < digits || digits == 0; ++i)
+                {
+                    char h = end() ? 0 : peek();
+                    int value = h >= '0' && h <= '9' ? h - '0'
+                        : h >= 'a' && h <= 'f' ? h - 'a' + 10
+                        : h >= 'A' && h <= 'F' ? h - 'A' + 10 : -1;
+                    if (value < 0)
+                    {
+                        if (digits == 0 && i > 0)
+                        {
+                            break;
+                        }
+                        fail("Expected a hexadecimal digit");
+                    }
+                    c = c * 16 + value;
+                    if (c > 0x10FFFF)
+                    {
+                        fail("Code point is above 0x10FFFF");
+                    }
+                    position++;
+                }
+                return c;
+            }
+
+            // Returns the escaped character, or infinity after storing the
+            // escaped class (\d \s \w and their negations) in set
+            constexpr uint32_t parseEscape(CtClass& set)
+            {
+                position++;
+                if (end())
+                {
+                    fail("Unexpected end of pattern after '\\'");
+                }
+                char e = pattern[position++];
+                switch (e)
+                {
+                case 'd': case 'D':
+                    set.add('0', '9');
+                    break;
+                case 'w': case 'W':
+                    set.add('0', '9');
+                    set.add('A', 'Z');
+                    set.add('a', 'z');
+                    set.add('_', '_');
+                    break;
+                case 's': case 'S':
+                    // Same members as the runtime \s
+                    set.add('\t', '\r');
+                    set.add(0x20, 0x20);
+                    set.add(0xA0, 0xA0);
+                    set.add(0x1680, 0x1680);
+                    set.add(0x2000, 0x200A);
+                    set.add(0x2028, 0x2029);
+                    set.add(0x202F, 0x202F);
+                    set.add(0x205F, 0x205F);
+                    set.add(0x3000, 0x3000);
+                    set.add(0xFEFF, 0xFEFF);
+                    break;
+                case 'n': return '\n';
+                case 'r': return '\r';
+                case 't': return '\t';
+                case 'f': return '\f';
+                case 'v': return '\v';
+                case 'c': {
+                    char letter = end() ? 0 : peek();
+                    if (!(letter >= 'a' && letter <= 'z') && !(letter >= 'A' && letter <= 'Z'))
+                    {
+                        fail("Expected a letter after \\c");
+                    }
+                    position++;
+                    return letter % 32;
+                }
+                case 'x':
+                    return parseHex(2);
+                case 'u':
+                    if (!end() && peek() == '{')
+                    {
+                        position++;
+                        uint32_t c = parseHex(0);
+                        if (end() || peek() != '}')
+                        {
+                            fail("Missing '}' after \\u{");
+                        }
+                        position++;
+                        return c;
+                    }
+                    return parseHex(4);
+                case 'p': case 'P':
+                    fail("\\p and \\P are not supported by ct_regex");
+                    break;
+                case 'b': case 'B':
+                    fail("\\b and \\B are not implemented");
+                    break;
+                default:
+                    if (e >= '1' && e <= '9')
+                    {
+                        fail("Backreferences are not supported by ct_regex");
+                    }
+                    if ((e >= '0' && e <= '9') || (e >= 'a' && e <= 'z') || (e >= 'A' && e <= 'Z')
+                        || static_cast<uint8_t>(e) >= 0x80)
+                    {
+                        fail("Invalid escape sequence");
+                    }
+                    return static_cast<uint8_t>(e);
+                }
+                if (e >= 'A' && e <= 'Z')
+                {
+                    set.negate();
+                }
+                return infinity;
+            }
+
+            constexpr CtClass parseClass()
+            {
+                position++;
+                bool negative = !end() && peek() == '^';
+                if (negative)
+                {
+                    position++;
+                }
+                CtClass set;
+                while (true)
+                {
+                    if (end())
+                    {
+                        fail("Missing ']'");
+                    }
+                    if (peek() == ']')
+                    {
+                        break;
+                    }
+                    CtClass escaped;
+                    uint32_t lo = peek() == '\\' ? parseEscape(escaped) : parseCharacter();
+                    if (lo == infinity)
+                    {
+                        set.add(escaped);
+                        continue;
+                    }
+                    uint32_t hi = lo;
+                    if (position + 1 < pattern.size() && peek() == '-' && pattern[position + 1] != ']')
+                    {
+                        position++;
+                        hi = peek() == '\\' ? parseEscape(escaped) : parseCharacter();
+                        if (hi == infinity)
+                        {
+                            fail("Invalid range in character class");
+                        }
+                        if (hi < lo)
+                        {
+                            fail("Range out of order in character class");
+                        }
+                    }
+                    set.add(lo, hi);
+                }
+                position++;
+                if (negative)
+                {
+                    set.negate();
+                }
+                return set;
+            }
+
+            constexpr void emitCharacter(uint32_t c)
+            {
+                uint8_t bytes[4] {};
+                encodeUTF8(c, bytes);
+                for (size_t i = 0; i < utf8Length(c); ++i)
+                {
+                    CtInstruction instruction { CtOp::Bytes };
+                    instruction.add(bytes[i], bytes[i]);
+                    emit(instruction);
+                }
+            }
+
+            // One alternative for the ASCII members, then one per multi-byte
+            // sequence; they are disjoint, so their order does not matter
+            constexpr void emitClass(CtClass set)
+            {
+                set.normalize();
+                CtSequences sequences;
+                for (size_t i = 0; i < set.count; ++i)
+                {
+                    utf8Sequences(set.low[i], set.high[i], sequences);
+                }
+
+                CtInstruction ascii { CtOp::Bytes };
+                size_t asciiCount = 0;
+                size_t alternatives = 0, total = 0;
+                for (size_t i = 0; i < sequences.count; ++i)
+                {
+                    const CtSequence& sequence = sequences.items[i];
+                    if (sequence.length == 1)
+                    {
+                        ascii.add(sequence.low[0], sequence.high[0]);
+                        asciiCount++;
+                        continue;
+                    }
+                    alternatives++;
+                    total += sequence.length;
+                }
+                if (asciiCount || alternatives == 0)
+                {
+                    alternatives++;
+                    total++;
+                }
+
+                size_t exit = size + total + 2 * (alternatives - 1);
+                size_t remaining = alternatives;
+                auto alternative = [&](size_t length, auto body) {
+                    if (--remaining == 0)
+                    {
+                        body();
+                        return;
+                    }
+                    size_t split = emit({ CtOp::Split });
+                    body();
+                    emit({ CtOp::Jump, static_cast<uint32_t>(exit) });
+                    patch(split, split + 1, split + length + 2);
+                };
+
+                if (asciiCount || sequences.count == 0)
+                {
+                    alternative(1, [&] { emit(ascii); });
+                }
+                for (size_t i = 0; i < sequences.count; ++i)
+                {
+                    const CtSequence& sequence = sequences.items[i];
+                    if (sequence.length == 1)
+                    {
+                        continue;
+                    }
+                    alternative(sequence.length, [&] {
+                        for (size_t j = 0; j < sequence.length; ++j)
+                        {
+                            CtInstruction instruction { CtOp::Bytes };
+                            instruction.add(sequence.low[j], sequence.high[j]);
+                            emit(instruction);
+                        }
+                    });
+                }
+            }
+        };
+
+        // Flags of a DFA state: a match ends there (begins there, in the
+        // reverse automaton), and a match ends there if the text ends there
+        // too (begins there if it begins there)
+        constexpr uint8_t ctMatch = 1;
+        constexpr uint8_t ctEdgeMatch = 2;
+
+        // A DFA built by CtBuilder. Each state has a row of 1 << shift
+        // transitions, one per byte class. State 0 is dead; starts holds the
+        // start state for a scan that does not (0) or does (1) begin at the
+        // edge of the text it runs towards the other end of.
+        struct CtAutomaton
+        {
+            std::vector<uint16_t> next;
+            std::vector<uint8_t> flags;
+            uint16_t starts[2] {};
+        };
+
+        struct CtShape
+        {
+            size_t shift;
+            size_t forward;
+            size_t reverse;
+            size_t full;
+        };
+
+        // Turns a program into DFAs by subset construction, during constant
+        // evaluation, the way the lazy DFA builds its states at run time: a
+        // state is the list of threads alive after some text, ^ and $ wait in
+        // it until the scan knows whether it is at the edge of the text, and
+        // rows are indexed by byte classes. The vectors only live while the
+        // compiler evaluates; ct_regex copies the result into arrays.
+        //
+        // Constant evaluation is slow, so the loops that run per transition
+        // only walk flat arrays: the closure of every pc and which Bytes
+        // instructions take which class are worked out once, and states are
+        // found again through a hash table.
+        class CtBuilder
+        {
+        public:
+            static constexpr size_t maxStates = 4096;
+
+            std::array<uint8_t, 256> byteClass {};
+            size_t classes = 0;
+            size_t shift = 0;
+
+            // Unanchored and leftmost-first: an Accept cuts the threads below
+            // it, as in the Pike VM. Runs test() and finds where the match of
+            // find() ends.
+            CtAutomaton forward;
+            // The program backwards from its Accept, with every thread kept.
+            // Run back from the end of the match, it finds where it begins.
+            CtAutomaton reverse;
+            // Anchored, with every thread kept. Runs match().
+            CtAutomaton full;
+
+            constexpr CtBuilder(const CtInstruction* _code, size_t _size) : code(_code), size(_size)
+            {
+                if (size > UINT16_MAX)
+                {
+                    fail("Pattern is too large for ct_regex");
+                }
+                predecessors.resize(size);
+                for (size_t pc = 0; pc < size; ++pc)
+                {
+                    const CtInstruction& instruction = code[pc];
+                    if (instruction.op == CtOp::Jump || instruction.op == CtOp::Split)
+                    {
+                        predecessors[instruction.x].push_back(static_cast<uint16_t>(pc));
+                    }
+                    if (instruction.op == CtOp::Split)
+                    {
+                        predecessors[instruction.y].push_back(static_cast<uint16_t>(pc));
+                    }
+                    if (instruction.op == CtOp::Accept)
+                    {
+                        accept = pc;
+                    }
+                }
+                seen.assign(size, 0);
+                buffer.assign(size, 0);
+                splitClasses();
+
+                // 每个 pc 在文本中间的闭包
+                closures(Kind::Forward, forwardClosures, forwardClosureBegin);
+                closures(Kind::Reverse, reverseClosures, reverseClosureBegin);
+                // A pattern that can only start at the beginning of the text
+                // need not restart anywhere else
+                restarts = forwardClosureBegin[1] != 0;
+
+                build(forward, Kind::Forward);
+                build(reverse, Kind::Reverse);
+                build(full, Kind::Full);
+            }
+
+            constexpr CtShape shape() const
+            {
+                return { shift, forward.flags.size(), reverse.flags.size(), full.flags.size() };
+            }
+
+        private:
+            enum class Kind { Forward, Reverse, Full };
+
+            static constexpr uint8_t edgeBit = 1;
+            static constexpr uint8_t restartBit = 2;
+
+            const CtInstruction* code;
+            size_t size;
+            size_t accept = 0;
+            bool restarts = false;
+            // The pcs whose Jump or Split leads to each pc
+            std::vector<std::vector<uint16_t>> predecessors;
+            // A byte of each class
+            std::array<uint8_t, 256> representative {};
+            // Whether the instruction at pc takes class c, at pc * classes + c
+            std::vector<uint8_t> takes;
+            // The threads reached from each pc a step can go to, in the
+            // middle of the text, forwards and in reverse, from
+            // closureBegin[pc] to closureBegin[pc + 1]
+            std::vector<uint16_t> forwardClosures;
+            std::vector<uint32_t> forwardClosureBegin;
+            std::vector<uint16_t> reverseClosures;
+            std::vector<uint32_t> reverseClosureBegin;
+            std::vector<uint32_t> seen;
+            uint32_t generation = 0;
+            std::vector<uint32_t> stack;
+            // The threads of the state being made
+            std::vector<uint16_t> buffer;
+
+            // The states of the automaton being built: the threads of state i
+            // are pool[begins[i]] to pool[begins[i + 1]]
+            std::vector<uint16_t> pool;
+            std::vector<uint32_t> begins;
+            std::vector<uint8_t> bits;
+            std::vector<uint32_t> hashes;
+            // Open addressing over hashes, at most half full
+            std::vector<uint16_t> table;
+
+            [[noreturn]] static void fail(const char* message)
+            {
+                throw std::runtime_error(message);
+            }
+
+            // A class is a run of bytes between two boundaries, where some
+            // Bytes instruction takes one byte and not the one before, as in
+            // Compiler::byteClasses()
+            constexpr void splitClasses()
+            {
+                uint64_t boundaries[4] {};
+                for (size_t pc = 0; pc < size; ++pc)
+                {
+                    if (code[pc].op != CtOp::Bytes)
+                    {
+                        continue;
+                    }
+                    const uint64_t* bytes = code[pc].bytes;
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        boundaries[i] |= bytes[i] ^ (bytes[i] << 1 | (i ? bytes[i - 1] >> 63 : 0));
+                    }
+                }
+                boundaries[0] &= ~uint64_t(1);
+
+                classes = 0;
+                for (unsigned b = 0; b < 256; ++b)
+                {
+                    if (boundaries[b >> 6] >> (b & 63) & 1)
+                    {
+                        classes++;
+                    }
+                    byteClass[b] = static_cast<uint8_t>(classes);
+                    representative[classes] = static_cast<uint8_t>(b);
+                }
+                classes++;
+                while ((size_t(1) << shift) < classes)
+                {
+                    shift++;
+                }
+
+                takes.assign(size * classes, 0);
+                for (size_t pc = 0; pc < size; ++pc)
+                {
+                    if (code[pc].op == CtOp::Bytes)
+                    {
+                        for (size_t c = 0; c < classes; ++c)
+                        {
+                            takes[pc * classes + c] = code[pc].has(representative[c]);
+                        }
+                    }
+                }
+            }
+
+            // Whether thread is the Accept, or in reverse, the start of the
+            // program
+            constexpr bool isFinal(Kind kind, size_t thread) const
+            {
+                return kind == Kind::Reverse ? thread == 0 : code[thread].op == CtOp::Accept;
+            }
+
+            // Appends the threads reached from pc by empty transitions, in
+            // priority order. A reverse thread is a pc the program reaches
+            // after a byte, a ^ or the start; it follows the program's
+            // transitions backwards.
+            constexpr void closure(Kind kind, size_t pc, bool atBegin, bool atEnd, std::vector<uint16_t>& threads)
+            {
+                generation++;
+                stack.clear();
+                stack.push_back(static_cast<uint32_t>(pc));
+                while (!stack.empty())
+                {
+                    pc = stack.back();
+                    stack.pop_back();
+                    if (kind == Kind::Reverse)
+                    {
+                        if (seen[pc] == generation)
+                        {
+                            continue;
+                        }
+                        seen[pc] = generation;
+                        CtOp before = pc ? code[pc - 1].op : CtOp::Accept;
+                        if (pc == 0 || before == CtOp::Bytes || (before == CtOp::Begin && !atBegin))
+                        {
+                            threads.push_back(static_cast<uint16_t>(pc));
+                        }
+                        if ((before == CtOp::Begin && atBegin) || (before == CtOp::End && atEnd))
+                        {
+                            stack.push_back(static_cast<uint32_t>(pc - 1));
+                        }
+                        for (uint16_t predecessor : predecessors[pc])
+                        {
+                            stack.push_back(predecessor);
+                        }
+                        continue;
+                    }
+                    while (seen[pc] != generation)
+                    {
+                        seen[pc] = generation;
+                        const CtInstruction& instruction = code[pc];
+                        if (instruction.op == CtOp::Jump)
+                        {
+                            pc = instruction.x;
+                        }
+                        else if (instruction.op == CtOp::Split)
+                        {
+                            stack.push_back(instruction.y);
+                            pc = instruction.x;
+                        }
+                        else if ((instruction.op == CtOp::Begin && atBegin) || (instruction.op == CtOp::End && atEnd))
+                        {
+                            pc++;
+                        }
+                        else
+                        {
+                            // 不在文本开头时 ^ 不会再成立，$ 则等到扫描知道是否到了结尾
+                            if (instruction.op != CtOp::Begin)
+                            {
+                                threads.push_back(static_cast<uint16_t>(pc));
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+
+            constexpr void closures(Kind kind, std::vector<uint16_t>& reached, std::vector<uint32_t>& begin)
+            {
+                std::vector<uint16_t> threads;
+                begin.push_back(0);
+                for (size_t pc = 0; pc < size; ++pc)
+                {
+                    // 只有开头和字节之后的 pc 会用到
+                    bool used = kind == Kind::Reverse ? code[pc].op == CtOp::Bytes
+                        : pc == 0 || code[pc - 1].op == CtOp::Bytes;
+                    threads.clear();
+                    if (used)
+                    {
+                        closure(kind, pc, false, false, threads);
+                    }
+                    reached.insert(reached.end(), threads.begin(), threads.end());
+                    begin.push_back(static_cast<uint32_t>(reached.size()));
+                }
+            }
+
+            constexpr void build(CtAutomaton& automaton, Kind kind)
+            {
+                pool.clear();
+                begins.assign(2, 0);
+                bits.assign(1, 0);
+                hashes.assign(1, 0);
+                table.assign(16, 0);
+                automaton.flags.assign(1, 0);
+
+                std::vector<uint16_t> threads;
+                for (bool edge : { false, true })
+                {
+                    threads.clear();
+                    if (kind == Kind::Reverse)
+                    {
+                        closure(kind, accept, false, edge, threads);
+                    }
+                    else
+                    {
+                        closure(kind, 0, edge, false, threads);
+                    }
+                    std::copy(threads.begin(), threads.end(), buffer.begin());
+                    bool restart = kind == Kind::Forward && restarts;
+                    automaton.starts[edge] = intern(automaton, kind, threads.size(), edge, restart);
+                }
+                for (size_t i = 0; i < bits.size(); ++i)
+                {
+                    automaton.next.resize((i + 1) << shift, 0);
+                    for (size_t c = 0; c < classes; ++c)
+                    {
+                        automaton.next[(i << shift) + c] = step(automaton, kind, i, c);
+                    }
+                }
+            }
+
+            // Returns the state that state from goes to on class c
+            constexpr uint16_t step(CtAutomaton& automaton, Kind kind, size_t from, size_t c)
+            {
+                const uint16_t* threads = pool.data();
+                const uint8_t* take = takes.data();
+                const uint16_t* reached = (kind == Kind::Reverse ? reverseClosures : forwardClosures).data();
+                const uint32_t* reachedBegin = (kind == Kind::Reverse ? reverseClosureBegin : forwardClosureBegin).data();
+                uint32_t* marks = seen.data();
+                uint16_t* next = buffer.data();
+                size_t count = 0;
+                bool cut = false;
+
+                // 只标记线程；同一个 pc 的闭包整个都已经在里面了
+                generation++;
+                for (uint32_t i = begins[from]; i < begins[from + 1]; ++i)
+                {
+                    size_t thread = threads[i];
+                    size_t pc = thread;
+                    size_t target = thread + 1;
+                    if (kind == Kind::Reverse)
+                    {
+                        if (thread == 0)
+                        {
+                            continue;
+                        }
+                        pc = target = thread - 1;
+                    }
+                    else if (code[pc].op == CtOp::Accept)
+                    {
+                        if (kind == Kind::Forward)
+                        {
+                            cut = true;
+                            break;
+                        }
+                        continue;
+                    }
+                    if (!take[pc * classes + c])
+                    {
+                        continue;
+                    }
+                    for (uint32_t k = reachedBegin[target]; k < reachedBegin[target + 1]; ++k)
+                    {
+                        uint16_t other = reached[k];
+                        if (marks[other] != generation)
+                        {
+                            marks[other] = generation;
+                            next[count++] = other;
+                        }
+                    }
+                }
+                bool restart = (bits[from] & restartBit) && !cut;
+                if (restart)
+                {
+                    for (uint32_t k = reachedBegin[0]; k < reachedBegin[1]; ++k)
+                    {
+                        uint16_t other = reached[k];
+                        if (marks[other] != generation)
+                        {
+                            marks[other] = generation;
+                            next[count++] = other;
+                        }
+                    }
+                }
+                return intern(automaton, kind, count, false, restart);
+            }
+
+            // Returns the state of the count threads in buffer, adding it if
+            // it is new
+            constexpr uint16_t intern(CtAutomaton& automaton, Kind kind, size_t count, bool edge, bool restart)
+            {
+                if (count == 0 && !restart)
+                {
+                    return 0;
+                }
+                uint16_t* threads = buffer.data();
+                // 只有最左优先的自动机要保留线程的顺序
+                if (kind != Kind::Forward)
+                {
+                    std::sort(threads, threads + count);
+                }
+                uint8_t key = (edge ? edgeBit : 0) | (restart ? restartBit : 0);
+                uint32_t hash = key;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    hash = hash * 31 + threads[i];
+                }
+
+                size_t mask = table.size() - 1;
+                size_t slot = hash & mask;
+                for (; table[slot]; slot = (slot + 1) & mask)
+                {
+                    size_t state = table[slot];
+                    if (hashes[state] != hash || bits[state] != key || begins[state + 1] - begins[state] != count)
+                    {
+                        continue;
+                    }
+                    const uint16_t* other = pool.data() + begins[state];
+                    size_t i = 0;
+                    while (i < count && other[i] == threads[i])
+                    {
+                        i++;
+                    }
+                    if (i == count)
+                    {
+                        return static_cast<uint16_t>(state);
+                    }
+                }
+                if (bits.size() == maxStates)
+                {
+                    fail("Pattern needs too many DFA states for ct_regex");
+                }
+
+                uint8_t flags = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (isFinal(kind, threads[i]))
+                    {
+                        flags = ctMatch | ctEdgeMatch;
+                    }
+                }
+                // A waiting $ (^ in reverse) holds at the edge of the text
+                std::vector<uint16_t> reached;
+                for (size_t i = 0; i < count && !flags; ++i)
+                {
+                    size_t thread = threads[i];
+                    bool waits = kind == Kind::Reverse ? code[thread - 1].op == CtOp::Begin : code[thread].op == CtOp::End;
+                    if (!waits)
+                    {
+                        continue;
+                    }
+                    reached.clear();
+                    if (kind == Kind::Reverse)
+                    {
+                        closure(kind, thread - 1, true, edge, reached);
+                    }
+                    else
+                    {
+                        closure(kind, thread + 1, edge, true, reached);
+                    }
+                    for (uint16_t other : reached)
+                    {
+                        if (isFinal(kind, other))
+                        {
+                            flags = ctEdgeMatch;
+                        }
+                    }
+                }
+
+                pool.insert(pool.end(), threads, threads + count);
+                begins.push_back(static_cast<uint32_t>(pool.size()));
+                bits.push_back(key);
+                hashes.push_back(hash);
+                automaton.flags.push_back(flags);
+                uint16_t state = static_cast<uint16_t>(bits.size() - 1);
+                table[slot] = state;
+                if (2 * bits.size() > table.size())
+                {
+                    // 表保持至少一半是空的
+                    table.assign(2 * table.size(), 0);
+                    mask = table.size() - 1;
+                    for (size_t i = 1; i < bits.size(); ++i)
+                    {
+                        for (slot = hashes[i] & mask; table[slot]; slot = (slot + 1) & mask)
+                        {
+                        }
+                        table[slot] = static_cast<uint16_t>(i);
+                    }
+                }
+                return state;
+            }
+        };
+
+        template <size_t Shift, size_t States>
+        struct CtDFA
+        {
+            std::array<uint16_t, (States << Shift)> next {};
+            std::array<uint8_t, States> flags {};
+            uint16_t starts[2] {};
+
+            constexpr void fill(const CtAutomaton& automaton)
+            {
+                for (size_t i = 0; i < next.size(); ++i)
+                {
+                    next[i] = automaton.next[i];
+                }
+                for (size_t i = 0; i < States; ++i)
+                {
+                    flags[i] = automaton.flags[i];
+                }
+                starts[0] = automaton.starts[0];
+                starts[1] = automaton.starts[1];
+            }
+        };
+
+        template <CtShape Shape>
+        struct CtTables
+        {
+            std::array<uint8_t, 256> byteClass {};
+            CtDFA<Shape.shift, Shape.forward> forward;
+            CtDFA<Shape.shift, Shape.reverse> reverse;
+            CtDFA<Shape.shift, Shape.full> full;
+        };
+    }
+
+    template <fixed_string Source>
+    class ct_regex
+    {
+    public:
+        // Returns true if the pattern matches anywhere in text.
+        static constexpr bool test(std::string_view text)
+        {
+            size_t end = 0;
+            return scanForward(text, 0, true, end);
+        }
+
+        // Finds the leftmost match that begins at or after from and stores
+        // its bounds, as byte offsets, in start and end.
+        static constexpr bool find(std::string_view text, size_t& start, size_t& end, size_t from = 0)
+        {
+            if (from > text.size() || !scanForward(text, from, false, end))
+            {
+                return false;
+            }
+            start = scanReverse(text, from, end);
+            return true;
+        }
+
+        // Returns true if the pattern matches the whole of text.
+        static constexpr bool match(std::string_view text)
+        {
+            const auto& dfa = tables.full;
+            uint16_t state = dfa.starts[1];
+            for (char c : text)
+            {
+                state = dfa.next[size_t(state) << shape.shift | tables.byteClass[static_cast<unsigned char>(c)]];
+                if (!state)
+                {
+                    return false;
+                }
+            }
+            return dfa.flags[state] & detail::ctEdgeMatch;
+        }
+
+        static constexpr std::string_view pattern() { return Source.view(); }
+
+    private:
+        static constexpr size_t size = detail::CtCompiler(Source.view(), nullptr).compile();
+
+        static constexpr std::array<detail::CtInstruction, size> code = [] {
+            std::array<detail::CtInstruction, size> program {};
+            detail::CtCompiler(Source.view(), program.data()).compile();
+            return program;
+        }();
+
+        static constexpr detail::CtShape shape = detail::CtBuilder(code.data(), size).shape();
+
+        static constexpr detail::CtTables<shape> tables = [] {
+            detail::CtTables<shape> result {};
+            detail::CtBuilder builder(code.data(), size);
+            result.byteClass = builder.byteClass;
+            result.forward.fill(builder.forward);
+            result.reverse.fill(builder.reverse);
+            result.full.fill(builder.full);
+            return result;
+        }();
+
+        // Scans forward from from and stores where the leftmost-first match
+        // ends in end, or where the first match found ends if earliest is true
+        static constexpr bool scanForward(std::string_view text, size_t from, bool earliest, size_t& end)
+        {
+            const auto& dfa = tables.forward;
+            bool found = false;
+            uint16_t state = dfa.starts[from == 0];
+            for (size_t p = from; ; ++p)
+            {
+                if (dfa.flags[state] & (p == text.size() ? detail::ctEdgeMatch : detail::ctMatch))
+                {
+                    end = p;
+                    found = true;
+                    if (earliest)
+                    {
+                        return true;
+                    }
+                }
+                if (p == text.size())
+                {
+                    return found;
+                }
+                state = dfa.next[size_t(state) << shape.shift | tables.byteClass[static_cast<unsigned char>(text[p])]];
+                if (!state)
+                {
+                    return found;
+                }
+            }
+        }
+
+        // Scans back from the end of a match to from and returns the first
+        // position where a match ending there begins
+        static constexpr size_t scanReverse(std::string_view text, size_t from, size_t end)
+        {
+            const auto& dfa = tables.reverse;
+            size_t start = end;
+            uint16_t state = dfa.starts[end == text.size()];
+            for (size_t p = end; ; --p)
+            {
+                if (dfa.flags[state] & (p == 0 ? detail::ctEdgeMatch : detail::ctMatch))
+                {
+                    start = p;
+                }
+                if (p == from)
+                {
+                    return start;
+                }
+                state = dfa.next[size_t(state) << shape.shift | tables.byteClass[static_cast<unsigned char>(text[p - 1])]];
+                if (!state)
+                {
+                    return start;
+                }
+            }
+        }
+    };
+}
+
+#endif // !_CT_REGEX_HH_
@@ -0,0 +1,684 @@
+#include "dfa.hh"
+#include "compiler.hh"
+#include <algorithm>
+#include <tuple>
+
+DFA::DFA(const Program& _program, bool _reverse, size_t _cacheSize, bool _overlapping)
+    : program(Compiler::toBytes(_program, _reverse)), reverse(_reverse), overlapping(_overlapping),
+    cacheSize(_cacheSize), memory(0), flushes(0), epoch(0), lastFlush(0), searches(0), built(0),
+    sweeps(0), generation(0)
+{
+    // Threads are numbered as the VM numbers its states. The lowered program
+    // can have many more than the VM's, and a DFA with too many only gives up.
+    oversized = program.states(VM::maxStates) > VM::maxStates;
+    std::vector<size_t> copies = oversized ? std::vector<size_t>(program.size(), 0) : program.copies(radix);
+    base.resize(program.size());
+    for (size_t pc = 0; pc < program.size(); ++pc)
+    {
+        base[pc] = pcOf.size();
+        size_t width = program[pc].code == ByteCode::String ? program[pc].operand_2 : 1;
+        pcOf.insert(pcOf.end(), width * copies[pc], pc);
+    }
+    restart = static_cast<uint32_t>(pcOf.size());
+    byteClass = Compiler::byteClasses(program);
+    shift = 0;
+    while ((size_t(1) << shift) < size_t(byteClass[255]) + 1)
+    {
+        shift++;
+    }
+    seen.resize(pcOf.size() + 1, 0);
+    flush();
+}
+
+DFA::DFA(const DFA& seed)
+    : program(seed.program), reverse(seed.reverse), overlapping(seed.overlapping), cacheSize(seed.cacheSize),
+    oversized(seed.oversized), base(seed.base), pcOf(seed.pcOf), radix(seed.radix), restart(seed.restart),
+    byteClass(seed.byteClass), shift(seed.shift), memory(0), flushes(0), epoch(0), lastFlush(0), searches(0),
+    budget(seed.budget), built(0), sweeps(0), generation(0)
+{
+    seen.resize(pcOf.size() + 1, 0);
+    flush();
+}
+
+bool DFA::supports(const Program& program)
+{
+    if (!program.lookarounds.empty())
+    {
+        return false;
+    }
+    for (const Instruction& instruction : program.instructions)
+    {
+        switch (instruction.code)
+        {
+        case ByteCode::Jump:
+        case ByteCode::Split:
+        case ByteCode::Match:
+        case ByteCode::String:
+        case ByteCode::Anchor:
+        case ByteCode::Capture:
+        case ByteCode::Repeat:
+        case ByteCode::Loop:
+        case ByteCode::Accept:
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t DFA::Hash::operator()(const std::vector<uint32_t>& threads) const
+{
+    size_t h = 14695981039346656037ull;
+    for (uint32_t thread : threads)
+    {
+        h = (h ^ thread) * 1099511628211ull;
+    }
+    return h;
+}
+
+void DFA::nextGeneration()
+{
+    if (++generation == 0)
+    {
+        std::fill(seen.begin(), seen.end(), 0);
+        generation = 1;
+    }
+}
+
+void DFA::flush()
+{
+    states.clear();
+    table.clear();
+    cache.clear();
+    memory = 0;
+    std::fill(std::begin(starts), std::end(starts), unknown);
+    epoch++;
+    jit.reset();
+
+    states.push_back({ {}, false, 0, {} });
+    table.resize(size_t(1) << shift, dead);
+    matches.assign(1, false);
+    cache.emplace(std::vector<uint32_t>(), dead);
+}
+
+// Returns the state for threads, building it if needed. Flushes the cache
+// when it is full, and gives up when that happens too often: the last flush
+// must have been followed by at least ten bytes of text per state built.
+int32_t DFA::intern(const std::vector<uint32_t>& threads, size_t position)
+{
+    auto it = cache.find(threads);
+    if (it != cache.end())
+    {
+        return it->second;
+    }
+
+    if (budget.states && built == budget.states)
+    {
+        return overBudget;
+    }
+    size_t cost = sizeof(State) + (sizeof(int32_t) << shift) + 2 * threads.size() * sizeof(uint32_t) + 64;
+    size_t capacity = budget.memory ? std::min(cacheSize, budget.memory) : cacheSize;
+    if (memory + cost > capacity)
+    {
+        size_t distance = position > lastFlush ? position - lastFlush : lastFlush - position;
+        if (++flushes >= 3 && distance < 10 * states.size())
+        {
+            return gaveUp;
+        }
+        lastFlush = position;
+        flush();
+    }
+
+    bool isMatch = false;
+    std::vector<uint32_t> accepts;
+    for (uint32_t thread : threads)
+    {
+        if (thread != restart && program[pcOf[thread]].code == ByteCode::Accept)
+        {
+            isMatch = true;
+            if (overlapping)
+            {
+                accepts.push_back(program[pcOf[thread]].operand_1);
+            }
+        }
+    }
+
+    int32_t id = static_cast<int32_t>(states.size());
+    states.push_back({ threads, isMatch, isMatch ? 1 : -1, std::move(accepts) });
+    table.resize(table.size() + (size_t(1) << shift), unknown);
+    matches.push_back(isMatch);
+    cache.emplace(threads, id);
+    memory += cost;
+    built++;
+    return id;
+}
+
+// Splits a thread at pc into the offset of its counts and the progress k
+// inside a literal, as VM::offsetOf() does.
+size_t DFA::offsetOf(uint32_t thread, size_t pc, size_t& k) const
+{
+    k = thread - base[pc];
+    size_t width = program[pc].code == ByteCode::String ? program[pc].operand_2 : 1;
+    if (k < width)
+    {
+        return 0;
+    }
+    size_t offset = k / width;
+    k -= offset * width;
+    return offset;
+}
+
+// Adds to set the threads reachable from pc, with the counts in offset,
+// without consuming input, in priority order. Anchors at the near end of the scan hold only if near is
+// set; those at the far end hold if far is set, and otherwise stay in the
+// set until the scan reaches the end of the text (see endMatches()).
+//
+// Returns true if Accept was reached. A forward DFA keeps leftmost-first
+// priorities, so threads of lower priority than Accept are cut, unless it
+// is overlapping.
+bool DFA::closure(std::vector<uint32_t>& set, size_t pc, size_t offset, bool near, bool far)
+{
+    bool matched = false;
+    stack.clear();
+    stack.push_back({ pc, offset });
+    while (!stack.empty())
+    {
+        std::tie(pc, offset) = stack.back();
+        stack.pop_back();
+        while (true)
+        {
+            size_t width = program[pc].code == ByteCode::String ? program[pc].operand_2 : 1;
+            uint32_t thread = static_cast<uint32_t>(base[pc] + offset * width);
+            if (seen[thread] == generation)
+            {
+                break;
+            }
+            seen[thread] = generation;
+
+            const Instruction& instruction = program[pc];
+            switch (instruction.code)
+            {
+            case ByteCode::Jump:
+                pc = instruction.operand_1;
+                continue;
+            case ByteCode::Split:
+                stack.push_back({ instruction.operand_2, offset });
+                pc = instruction.operand_1;
+                continue;
+            case ByteCode::Repeat:
+            {
+                const Counter& counter = program.counters[instruction.operand_1];
+                size_t weight = radix[instruction.operand_1];
+                size_t count = offset / weight % (counter.limit() + size_t(1));
+                size_t exit = offset - count * weight;
+                if (count < counter.min)
+                {
+                    pc++;
+                }
+                else if (counter.max != Counter::unbounded && count == counter.max)
+                {
+                    pc = instruction.operand_2;
+                    offset = exit;
+                }
+                else if (counter.lazy)
+                {
+                    stack.push_back({ pc + 1, offset });
+                    pc = instruction.operand_2;
+                    offset = exit;
+                }
+                else
+                {
+                    stack.push_back({ instruction.operand_2, exit });
+                    pc++;
+                }
+                continue;
+            }
+            case ByteCode::Loop:
+            {
+                const Counter& counter = program.counters[instruction.operand_1];
+                size_t weight = radix[instruction.operand_1];
+                if (offset / weight % (counter.limit() + size_t(1)) < counter.limit())
+                {
+                    offset += weight;
+                }
+                pc = instruction.operand_2;
+                continue;
+            }
+            case ByteCode::Capture:
+                pc++;
+                continue;
+            case ByteCode::Anchor:
+            {
+                bool isNear = (instruction.operand_1 == static_cast<size_t>(AnchorType::Begin)) != reverse;
+                if (isNear ? near : far)
+                {
+                    pc++;
+                    continue;
+                }
+                if (!isNear)
+                {
+                    set.push_back(thread);
+                }
+                break;
+            }
+            case ByteCode::Accept:
+                set.push_back(thread);
+                matched = true;
+                if (!reverse && !overlapping)
+                {
+                    stack.clear();
+                }
+                break;
+            default:
+                set.push_back(thread);
+                break;
+            }
+            break;
+        }
+    }
+    return matched;
+}
+
+int32_t DFA::startState(bool near, bool far, size_t position)
+{
+    if (oversized)
+    {
+        return gaveUp;
+    }
+    int index = (near ? 1 : 0) | (far ? 2 : 0);
+    if (starts[index] != unknown)
+    {
+        return starts[index];
+    }
+
+    nextGeneration();
+    next.clear();
+    bool matched = closure(next, 0, 0, near, far);
+    if ((!matched || overlapping) && !reverse)
+    {
+        next.push_back(restart);
+    }
+    int32_t state = intern(next, position);
+    if (state >= 0)
+    {
+        starts[index] = state;
+    }
+    return state;
+}
+
+int32_t DFA::transition(int32_t from, uint8_t byte, size_t position)
+{
+    std::vector<uint32_t> threads = states[from].threads;
+    nextGeneration();
+    next.clear();
+    for (uint32_t thread : threads)
+    {
+        bool matched = false;
+        if (thread == restart)
+        {
+            matched = closure(next, 0, 0, false, false);
+            if (!matched || overlapping)
+            {
+                next.push_back(restart);
+            }
+        }
+        else
+        {
+            size_t pc = pcOf[thread];
+            const Instruction& instruction = program[pc];
+            size_t k;
+            size_t offset = offsetOf(thread, pc, k);
+            if (instruction.code == ByteCode::ByteRange)
+            {
+                if (instruction.operand_1 <= byte && byte <= instruction.operand_2)
+                {
+                    matched = closure(next, pc + 1, offset, false, false);
+                }
+            }
+            else if (instruction.code == ByteCode::String)
+            {
+                std::string_view literal = program.literal(instruction);
+                if (static_cast<uint8_t>(literal[k]) == byte)
+                {
+                    if (k + 1 == literal.size())
+                    {
+                        matched = closure(next, pc + 1, offset, false, false);
+                    }
+                    else if (seen[thread + 1] != generation)
+                    {
+                        seen[thread + 1] = generation;
+                        next.push_back(thread + 1);
+                    }
+                }
+            }
+        }
+        if (matched && !reverse && !overlapping)
+        {
+            break;
+        }
+    }
+
+    size_t before = epoch;
+    int32_t to = intern(next, position);
+    if (to < 0 || epoch != before)
+    {
+        // The cache was flushed and from is gone
+        return to;
+    }
+    table[(size_t(from) << shift) + byteClass[byte]] = to;
+    return to;
+}
+
+bool DFA::endMatches(int32_t state)
+{
+    State& s = states[state];
+    if (s.endMatch >= 0)
+    {
+        return s.endMatch;
+    }
+
+    bool matched = false;
+    nextGeneration();
+    next.clear();
+    for (uint32_t thread : s.threads)
+    {
+        if (thread == restart)
+        {
+            continue;
+        }
+        size_t pc = pcOf[thread];
+        size_t k;
+        if (program[pc].code == ByteCode::Anchor && closure(next, pc, offsetOf(thread, pc, k), false, true))
+        {
+            matched = true;
+            break;
+        }
+    }
+    s.endMatch = matched;
+    return matched;
+}
+
+// Builds every state reachable from the start states. Returns false if there
+// are more than limit of them or the cache had to be flushed.
+bool DFA::buildAll(size_t limit)
+{
+    std::array<uint8_t, 256> representative;
+    for (size_t b = 256; b-- > 0;)
+    {
+        representative[byteClass[b]] = static_cast<uint8_t>(b);
+    }
+    size_t before = epoch;
+    for (int index = 0; index < 4; ++index)
+    {
+        if (startState(index & 1, index & 2, 0) < 0 || epoch != before)
+        {
+            return false;
+        }
+    }
+    size_t classes = size_t(byteClass[255]) + 1;
+    for (size_t s = 1; s < states.size(); ++s)
+    {
+        if (states.size() > limit)
+        {
+            return false;
+        }
+        for (size_t c = 0; c < classes; ++c)
+        {
+            if (table[(s << shift) + c] == unknown
+                && (transition(static_cast<int32_t>(s), representative[c], 0) < 0 || epoch != before))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void DFA::compileNative()
+{
+    if (!buildAll(jitStates))
+    {
+        return;
+    }
+    std::vector<int32_t> transitions(256 * states.size());
+    for (size_t s = 0; s < states.size(); ++s)
+    {
+        for (size_t b = 0; b < 256; ++b)
+        {
+            transitions[256 * s + b] = table[(s << shift) + byteClass[b]];
+        }
+    }
+    jit = JIT::compile(transitions, matches, reverse);
+}
+
+bool DFA::build(Tables& tables, size_t limit)
+{
+    if (!buildAll(limit))
+    {
+        return false;
+    }
+    tables.byteClass = byteClass;
+    tables.classes = size_t(byteClass[255]) + 1;
+    tables.transitions.clear();
+    tables.endMatches.clear();
+    for (size_t s = 0; s < states.size(); ++s)
+    {
+        auto row = table.begin() + (s << shift);
+        tables.transitions.insert(tables.transitions.end(), row, row + tables.classes);
+        tables.endMatches.push_back(s != dead && endMatches(static_cast<int32_t>(s)));
+    }
+    tables.matches = matches;
+    std::copy(std::begin(starts), std::end(starts), tables.starts);
+    return true;
+}
+
+DFA::Result DFA::search(StringView text, size_t from, size_t to, bool earliest, size_t& position)
+{
+    built = 0;
+    if (searches < jitThreshold && ++searches == jitThreshold)
+    {
+        compileNative();
+    }
+    flushes = 0;
+    lastFlush = from;
+    meter.start(budget);
+
+    size_t nearEnd = reverse ? text.size() : 0;
+    size_t farEnd = reverse ? 0 : text.size();
+    int32_t s = startState(from == nearEnd, from == farEnd, from);
+    if (s < 0)
+    {
+        return s == gaveUp ? Result::GaveUp : Result::BudgetExceeded;
+    }
+
+    bool found = false;
+    if (states[s].isMatch)
+    {
+        found = true;
+        position = from;
+        if (earliest)
+        {
+            return Result::Match;
+        }
+    }
+
+    // 热循环：每字节一次查表，逆向扫描时从 p - 1 读起。有预算时按块扫描，
+    // 每块之间才计数
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    const uint8_t* classes = byteClass.data();
+    const int32_t* transitions = table.data();
+    const uint8_t* matching = matches.data();
+    const size_t rowShift = shift;
+    const bool backward = reverse;
+    const size_t block = meter.limited() ? Meter::checkInterval : VM::npos;
+    size_t p = from;
+    while (p != to && s != dead)
+    {
+        size_t left = backward ? p - to : to - p;
+        size_t stop = left <= block ? to : backward ? p - block : p + block;
+        size_t begin = p;
+        if (jit)
+        {
+            size_t end = VM::npos;
+            p = jit->run(data, p, stop, end, s, earliest);
+            if (end != VM::npos)
+            {
+                found = true;
+                position = end;
+                if (earliest)
+                {
+                    return Result::Match;
+                }
+            }
+        }
+        while (p != stop && s != dead)
+        {
+            unsigned char b = backward ? data[p - 1] : data[p];
+            int32_t t = transitions[(size_t(s) << rowShift) + classes[b]];
+            if (t == unknown)
+            {
+                t = transition(s, b, p);
+                if (t < 0)
+                {
+                    return t == gaveUp ? Result::GaveUp : Result::BudgetExceeded;
+                }
+                // The tables may have grown or been flushed
+                transitions = table.data();
+                matching = matches.data();
+            }
+            s = t;
+            p = backward ? p - 1 : p + 1;
+            if (matching[s])
+            {
+                found = true;
+                position = p;
+                if (earliest)
+                {
+                    return Result::Match;
+                }
+            }
+        }
+        if (!meter.tick(backward ? begin - p : p - begin) && !meter.check(memory))
+        {
+            return Result::BudgetExceeded;
+        }
+    }
+
+    if (p == farEnd && s != dead && endMatches(s))
+    {
+        found = true;
+        position = p;
+    }
+    return found ? Result::Match : Result::NoMatch;
+}
+
+DFA::Result DFA::scanAccepts(StringView text, std::vector<uint8_t>& accepted)
+{
+    built = 0;
+    flushes = 0;
+    lastFlush = 0;
+    meter.start(budget);
+    sweeps++;
+
+    size_t pending = std::count(accepted.begin(), accepted.end(), 0);
+    bool found = false;
+    // Sets the entries of the patterns whose Accepts are in state, once per scan
+    auto report = [&](int32_t state) {
+        State& s = states[state];
+        if (s.reported == sweeps)
+        {
+            return;
+        }
+        s.reported = sweeps;
+        found = true;
+        for (uint32_t pattern : s.accepts)
+        {
+            if (!accepted[pattern])
+            {
+                accepted[pattern] = 1;
+                pending--;
+            }
+        }
+    };
+
+    int32_t s = startState(true, text.size() == 0, 0);
+    if (s < 0)
+    {
+        return s == gaveUp ? Result::GaveUp : Result::BudgetExceeded;
+    }
+    if (matches[s])
+    {
+        report(s);
+    }
+
+    // 与 search() 的热循环相同，只是匹配后继续扫描，直到所有模式都已匹配
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    const uint8_t* classes = byteClass.data();
+    const int32_t* transitions = table.data();
+    const uint8_t* matching = matches.data();
+    const size_t rowShift = shift;
+    const size_t block = meter.limited() ? Meter::checkInterval : VM::npos;
+    size_t p = 0;
+    while (p != text.size() && s != dead && pending)
+    {
+        size_t stop = text.size() - p <= block ? text.size() : p + block;
+        size_t begin = p;
+        while (p != stop && s != dead)
+        {
+            unsigned char b = data[p];
+            int32_t t = transitions[(size_t(s) << rowShift) + classes[b]];
+            if (t == unknown)
+            {
+                t = transition(s, b, p);
+                if (t < 0)
+                {
+                    return t == gaveUp ? Result::GaveUp : Result::BudgetExceeded;
+                }
+                transitions = table.data();
+                matching = matches.data();
+            }
+            s = t;
+            p++;
+            if (matching[s])
+            {
+                report(s);
+                if (!pending)
+                {
+                    return Result::Match;
+                }
+            }
+        }
+        if (!meter.tick(p - begin) && !meter.check(memory))
+        {
+            return Result::BudgetExceeded;
+        }
+    }
+
+    // $ 只在文本结尾成立，此时才能到达的 Accept
+    if (p == text.size() && s != dead && pending)
+    {
+        std::vector<uint32_t> threads = states[s].threads;
+        nextGeneration();
+        next.clear();
+        for (uint32_t thread : threads)
+        {
+            size_t pc = thread == restart ? 0 : pcOf[thread];
+            size_t k;
+            if (thread != restart && program[pc].code == ByteCode::Anchor)
+            {
+                closure(next, pc, offsetOf(thread, pc, k), false, true);
+            }
+        }
+        for (uint32_t thread : next)
+        {
+            const Instruction& instruction = program[pcOf[thread]];
+            if (instruction.code == ByteCode::Accept && !accepted[instruction.operand_1])
+            {
+                accepted[instruction.operand_1] = 1;
+                found = true;
+            }
+        }
+    }
+    return found ? Result::Match : Result::NoMatch;
+}
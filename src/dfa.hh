@@ -0,0 +1,184 @@
+#ifndef _DFA_HH_
+#define _DFA_HH_
+
+#include <array>
+#include <unordered_map>
+#include "jit.hh"
+#include "vm.hh"
+
+// Lazily built DFA.
+//
+// A DFA state is the ordered set of NFA states (as numbered by VM) that are
+// alive after reading some text. States and transitions are only built when
+// a scan first needs them, and are kept in a cache of bounded size.
+//
+// The DFA reads bytes, not characters: its program is first lowered by
+// Compiler::toBytes(), so that every class becomes a small automaton over
+// UTF-8 bytes. Once built, a transition is one table lookup for any byte,
+// and the text is never decoded. Bytes that are not valid UTF-8 are simply
+// not matched by any class.
+//
+// Most patterns only tell a few groups of bytes apart: for [a-z]+\d every
+// letter behaves the same, and so do all bytes that are neither letters nor
+// digits. Rows are indexed by these byte classes (see
+// Compiler::byteClasses()) rather than by byte, which typically makes them
+// up to 50 times smaller and keeps the built part of the DFA in cache.
+//
+// When the cache is full it is flushed and the scan goes on from the current
+// state. If flushes come so often that the cache no longer pays for itself,
+// the search gives up and the caller falls back to the Pike VM. So does
+// every search of a program with more states than the VM would take.
+//
+// A search is metered against a Budget, where a step is a byte scanned.
+// When there is any limit to check, the text is scanned in blocks of
+// Meter::checkInterval bytes and the meter only runs between blocks, so the
+// hot loop stays the same. A memory limit lowers the cache size, and a limit
+// of states bounds the states built by one search, including those built
+// ahead of time for the JIT.
+//
+// A DFA that has run many searches is hot: if all of its states can be
+// built within a small budget, they are, and compiled to native code by JIT,
+// which then runs the scans in place of the table loop.
+//
+// An overlapping DFA keeps every thread instead, with a restart at every
+// position, and runs the union programs of Compiler::compileSet(): a state
+// knows which patterns its Accepts belong to, so one scan tells which of
+// the patterns match anywhere in the text (see RegexSet).
+//
+// The DFA only reports where a match ends (or begins, for a reverse program
+// scanned backwards). Captures are left to the VM. Lookarounds and
+// backreferences are not supported, see supports().
+class DFA
+{
+public:
+    enum class Result { Match, NoMatch, GaveUp, BudgetExceeded };
+
+    static constexpr size_t defaultCacheSize = 2 << 20;
+
+    // Number of searches after which the DFA tries to compile itself, and
+    // the most states it compiles.
+    static constexpr size_t jitThreshold = 64;
+    static constexpr size_t jitStates = 1024;
+
+    // A forward DFA searches unanchored and finds the end of the leftmost
+    // match, with the same priorities as the VM. A reverse DFA runs a reverse
+    // program backwards from a fixed end, anchored, and finds the leftmost
+    // position where a match can begin.
+    DFA(const Program& _program, bool _reverse, size_t _cacheSize = defaultCacheSize,
+        bool _overlapping = false);
+
+    // A DFA for the program of seed, with a cache of its own, empty: one per
+    // thread without lowering the program again. Only the definition of the
+    // automaton is copied, not what seed has built or learnt.
+    explicit DFA(const DFA& seed);
+
+    static bool supports(const Program& program);
+
+    // Scans text from from towards to (to <= from for a reverse DFA) and
+    // stores the far end of the match in position. If earliest is true the
+    // scan stops as soon as any match is known.
+    Result search(StringView text, size_t from, size_t to, bool earliest, size_t& position);
+
+    // For an overlapping DFA: scans the whole of text and sets accepted[i]
+    // if a match reaches Accept i. Stops once every entry of accepted is set.
+    Result scanAccepts(StringView text, std::vector<uint8_t>& accepted);
+
+    void setBudget(const Budget& _budget) { budget = _budget; }
+
+    // The whole automaton, for sweetie-gen. Rows have classes entries,
+    // indexed by byteClass; starts is indexed as in search(), by whether the
+    // scan begins at its near end (1) and at its far end (2).
+    struct Tables
+    {
+        std::array<uint8_t, 256> byteClass;
+        size_t classes;
+        std::vector<int32_t> transitions;
+        std::vector<uint8_t> matches;
+        std::vector<uint8_t> endMatches;
+        int32_t starts[4];
+    };
+
+    // Builds every state and stores the automaton in tables. Returns false
+    // if there are more than limit states or they do not fit in the cache.
+    bool build(Tables& tables, size_t limit);
+
+private:
+    struct State
+    {
+        std::vector<uint32_t> threads;
+        bool isMatch;
+        // Whether the state matches once the text ends: -1 if unknown.
+        int endMatch;
+        // Patterns of its Accepts, in an overlapping DFA, and the last scan
+        // that has reported them.
+        std::vector<uint32_t> accepts;
+        size_t reported = 0;
+    };
+
+    struct Hash
+    {
+        size_t operator()(const std::vector<uint32_t>& threads) const;
+    };
+
+    static constexpr int32_t dead = 0;
+    static constexpr int32_t unknown = -1;
+    static constexpr int32_t gaveUp = -2;
+    static constexpr int32_t overBudget = -3;
+
+    Program program;
+    bool reverse;
+    bool overlapping;
+    size_t cacheSize;
+    // Whether the program has more states than VM::maxStates, in which case
+    // none are numbered and every search gives up
+    bool oversized;
+    std::vector<size_t> base;
+    std::vector<size_t> pcOf;
+    std::vector<size_t> radix;
+
+    // Pseudo thread that restarts the program at every position, which makes
+    // a forward search unanchored. It has the lowest priority.
+    uint32_t restart;
+
+    std::vector<State> states;
+    // Class of every byte. A state has one transition per class, in a row
+    // of 1 << shift entries so that finding the row costs a shift.
+    std::array<uint8_t, 256> byteClass;
+    size_t shift;
+    std::vector<int32_t> table;
+    std::vector<uint8_t> matches;
+    std::unordered_map<std::vector<uint32_t>, int32_t, Hash> cache;
+    int32_t starts[4];
+    size_t memory;
+
+    size_t flushes;
+    size_t epoch;
+    size_t lastFlush;
+
+    size_t searches;
+    std::unique_ptr<JIT> jit;
+
+    Budget budget;
+    Meter meter;
+    // States built by the current search
+    size_t built;
+    size_t sweeps;
+
+    std::vector<uint32_t> seen;
+    uint32_t generation;
+    std::vector<std::pair<size_t, size_t>> stack;
+    std::vector<uint32_t> next;
+
+    int32_t startState(bool near, bool far, size_t position);
+    int32_t transition(int32_t from, uint8_t byte, size_t position);
+    bool closure(std::vector<uint32_t>& set, size_t pc, size_t offset, bool near, bool far);
+    size_t offsetOf(uint32_t thread, size_t pc, size_t& k) const;
+    bool endMatches(int32_t state);
+    int32_t intern(const std::vector<uint32_t>& threads, size_t position);
+    void flush();
+    void nextGeneration();
+    bool buildAll(size_t limit);
+    void compileNative();
+};
+
+#endif // !_DFA_HH_
@@ -0,0 +1,228 @@
+#include "jit.hh"
+#include <cstring>
+
+#if defined(__x86_64__) && !defined(_WIN32) && !defined(SWEETIE_NO_JIT)
+#define SWEETIE_JIT 1
+#include <sys/mman.h>
+#endif
+
+#ifdef SWEETIE_JIT
+
+namespace
+{
+    // Just enough of an assembler: bytes, labels and 32-bit relative jumps.
+    class Assembler
+    {
+    public:
+        std::vector<uint8_t> code;
+
+        size_t label()
+        {
+            labels.push_back(SIZE_MAX);
+            return labels.size() - 1;
+        }
+
+        void bind(size_t label)
+        {
+            labels[label] = code.size();
+        }
+
+        size_t position(size_t label) const
+        {
+            return labels[label];
+        }
+
+        void emit(std::initializer_list<uint8_t> bytes)
+        {
+            code.insert(code.end(), bytes);
+        }
+
+        void emit32(uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                code.push_back(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        // An opcode followed by the rel32 of a label
+        void jump(std::initializer_list<uint8_t> opcode, size_t label)
+        {
+            emit(opcode);
+            fixups.push_back({ code.size(), label });
+            emit32(0);
+        }
+
+        void resolve()
+        {
+            for (auto [at, label] : fixups)
+            {
+                uint32_t rel = static_cast<uint32_t>(labels[label] - (at + 4));
+                std::memcpy(&code[at], &rel, 4);
+            }
+        }
+
+    private:
+        std::vector<size_t> labels;
+        std::vector<std::pair<size_t, size_t>> fixups;
+    };
+
+    struct Run
+    {
+        int low;
+        int high;
+        int32_t target;
+    };
+
+    // Branches to the block of the run that holds the byte in eax, by binary
+    // search over runs[begin, end)
+    template <typename Target>
+    void emitTree(Assembler& a, const std::vector<Run>& runs, size_t begin, size_t end, Target target)
+    {
+        if (end - begin == 1)
+        {
+            a.jump({ 0xE9 }, target(runs[begin].target));          // jmp
+            return;
+        }
+        size_t middle = (begin + end) / 2;
+        size_t left = a.label();
+        a.emit({ 0x3D });                                          // cmp eax, imm32
+        a.emit32(static_cast<uint32_t>(runs[middle].low));
+        a.jump({ 0x0F, 0x82 }, left);                              // jb
+        emitTree(a, runs, middle, end, target);
+        a.bind(left);
+        emitTree(a, runs, begin, middle, target);
+    }
+}
+
+// Register use (System V): rdi = data, rsi = p, rdx = to, rcx = &position,
+// r8 = &state, r9 = earliest; eax holds the byte, r10 the jump table.
+std::unique_ptr<JIT> JIT::compile(const std::vector<int32_t>& transitions,
+    const std::vector<uint8_t>& matches, bool reverse)
+{
+    size_t n = matches.size();
+    Assembler a;
+    std::vector<size_t> blocks(n), exits(n), enters(n);
+    for (size_t s = 0; s < n; ++s)
+    {
+        blocks[s] = a.label();
+        exits[s] = a.label();
+        enters[s] = a.label();
+    }
+    size_t table = a.label();
+
+    // 入口：按 *state 经跳转表进入对应状态
+    a.emit({ 0x41, 0x8B, 0x00 });                                  // mov eax, [r8]
+    a.jump({ 0x4C, 0x8D, 0x15 }, table);                           // lea r10, [rip + table]
+    a.emit({ 0x49, 0x63, 0x04, 0x82 });                            // movsxd rax, [r10 + rax * 4]
+    a.emit({ 0x4C, 0x01, 0xD0 });                                  // add rax, r10
+    a.emit({ 0xFF, 0xE0 });                                        // jmp rax
+
+    auto target = [&](int32_t t) {
+        return t == 0 ? exits[0] : matches[t] ? enters[t] : blocks[t];
+    };
+
+    for (size_t s = 0; s < n; ++s)
+    {
+        a.bind(exits[s]);
+        a.emit({ 0x41, 0xC7, 0x00 });                              // mov dword [r8], s
+        a.emit32(static_cast<uint32_t>(s));
+        a.emit({ 0x48, 0x89, 0xF0 });                              // mov rax, rsi
+        a.emit({ 0xC3 });                                          // ret
+        if (s == 0)
+        {
+            a.bind(blocks[s]);
+            a.jump({ 0xE9 }, exits[s]);
+            continue;
+        }
+
+        if (matches[s])
+        {
+            a.bind(enters[s]);
+            a.emit({ 0x48, 0x89, 0x31 });                          // mov [rcx], rsi
+            a.emit({ 0x4D, 0x85, 0xC9 });                          // test r9, r9
+            a.jump({ 0x0F, 0x85 }, exits[s]);                      // jnz
+        }
+
+        a.bind(blocks[s]);
+        a.emit({ 0x48, 0x39, 0xD6 });                              // cmp rsi, rdx
+        a.jump({ 0x0F, 0x84 }, exits[s]);                          // je
+        if (reverse)
+        {
+            a.emit({ 0x48, 0xFF, 0xCE });                          // dec rsi
+            a.emit({ 0x0F, 0xB6, 0x04, 0x37 });                    // movzx eax, byte [rdi + rsi]
+        }
+        else
+        {
+            a.emit({ 0x0F, 0xB6, 0x04, 0x37 });                    // movzx eax, byte [rdi + rsi]
+            a.emit({ 0x48, 0xFF, 0xC6 });                          // inc rsi
+        }
+
+        std::vector<Run> runs;
+        const int32_t* row = &transitions[256 * s];
+        for (int b = 0; b < 256; ++b)
+        {
+            if (!runs.empty() && runs.back().target == row[b])
+            {
+                runs.back().high = b;
+            }
+            else
+            {
+                runs.push_back({ b, b, row[b] });
+            }
+        }
+        emitTree(a, runs, 0, runs.size(), target);
+    }
+
+    while (a.code.size() % 4)
+    {
+        a.emit({ 0xCC });
+    }
+    a.bind(table);
+    for (size_t s = 0; s < n; ++s)
+    {
+        a.emit32(static_cast<uint32_t>(a.position(blocks[s]) - a.position(table)));
+    }
+    a.resolve();
+
+    size_t size = a.code.size();
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    std::memcpy(memory, a.code.data(), size);
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0)
+    {
+        munmap(memory, size);
+        return nullptr;
+    }
+    return std::unique_ptr<JIT>(new JIT(memory, size));
+}
+
+JIT::JIT(void* _memory, size_t _size)
+    : memory(_memory), size(_size), function(reinterpret_cast<Function>(_memory))
+{
+}
+
+JIT::~JIT()
+{
+    munmap(memory, size);
+}
+
+#else
+
+std::unique_ptr<JIT> JIT::compile(const std::vector<int32_t>&, const std::vector<uint8_t>&, bool)
+{
+    return nullptr;
+}
+
+JIT::JIT(void* _memory, size_t _size) : memory(_memory), size(_size), function(nullptr)
+{
+}
+
+JIT::~JIT()
+{
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef _JIT_HH_
+#define _JIT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Native code for a DFA whose states have all been built.
+//
+// Every state becomes a block of x86-64 code that reads the next byte and
+// branches on it through a tree of compares over the ranges of bytes that
+// lead to the same state, so a literal is a compare per byte and a class a
+// few compares, with no table in memory. The code runs in a buffer mapped
+// with mmap, written first and only then made executable.
+//
+// The JIT exists on x86-64 with a System V ABI (Linux, BSDs, macOS). It is
+// left out of builds that define SWEETIE_NO_JIT, and compile() then returns
+// nullptr: callers keep running the table-driven loop.
+class JIT
+{
+public:
+    // Transitions of state s are transitions[256 * s + b]. State 0 is dead.
+    // A reverse DFA reads the byte before p and moves p backwards.
+    static std::unique_ptr<JIT> compile(const std::vector<int32_t>& transitions,
+        const std::vector<uint8_t>& matches, bool reverse);
+
+    ~JIT();
+
+    // Runs from state (which must not be dead) until p reaches to or the
+    // state dies, and returns p. Stores p in position whenever a matching
+    // state is entered, stopping there if earliest is set, and the last state
+    // in state.
+    size_t run(const unsigned char* data, size_t p, size_t to, size_t& position,
+        int32_t& state, bool earliest) const
+    {
+        return function(data, p, to, &position, &state, earliest);
+    }
+
+private:
+    using Function = size_t (*)(const unsigned char*, size_t, size_t, size_t*, int32_t*, size_t);
+
+    void* memory;
+    size_t size;
+    Function function;
+
+    JIT(void* _memory, size_t _size);
+};
+
+#endif // !_JIT_HH_
@@ -434,6 +434,10 @@ Token Lexer::getGroupOpen()
             position++;
             t = getNamedCapturingGroupOpen('<');
             break;
+        case '>':
+            position++;
+            t = getAtomicGroupOpen();
+            break;
         case '=':
             position++;
             t = getAssertionLookahead();
@@ -497,6 +501,11 @@ Token Lexer::getNamedCapturingGroupOpen(Char mark)
     return { TokenType::NamedCapturingGroupName, { { name }, {} } };
 }
 
+Token Lexer::getAtomicGroupOpen()
+{
+    return { TokenType::AtomicGroupOpen, { "(?>", {}} };
+}
+
 Token Lexer::getAssertionLookahead()
 {
     return { TokenType::AssertionLookahead, { "(?=", {}} };
@@ -519,7 +528,9 @@ Token Lexer::getAssertionNegativeLookbehind()
 
 Token Lexer::getBackreference()
 {
-    return { TokenType::Backreference, { { input[position]}, {}} };
+    Token t = { TokenType::Backreference, { { input[position] }, {} } };
+    position++;
+    return t;
 }
 
 Token Lexer::getNamedBackreference()
@@ -728,5 +739,6 @@ Token Lexer::getUnicodeProperty(bool accept)
 
     position++;
 
-    return { TokenType::UnicodeProperty, {propertyName, propertyValue} };
+    return { accept ? TokenType::UnicodeProperty : TokenType::UnicodePropertyNegative,
+        {propertyName, propertyValue} };
 }
@@ -72,6 +72,8 @@ private:
 
     Token getNamedCapturingGroupOpen(Char mark);
 
+    Token getAtomicGroupOpen();
+
 
     Token getAssertionLookahead();
 
@@ -1,184 +1,262 @@
 #include "matcher.hh"
+#include <algorithm>
 
 
-void remove(std::vector<std::pair<int, int>>& ranges, std::pair<int, int> to_remove) {
-    std::vector<std::pair<int, int>> result;
-    for (auto& range : ranges) {
-        if (range.second < to_remove.first) {
-            result.push_back(range);
+using Ranges = std::vector<std::pair<int, int>>;
+
+// The operations below work on sorted ranges that neither overlap nor touch,
+// and return ranges of the same form, in linear time.
+
+static Ranges unite(const Ranges& a, const Ranges& b) {
+    Ranges merged;
+    merged.reserve(a.size() + b.size());
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(merged));
+    Ranges result;
+    for (auto& range : merged) {
+        if (!result.empty() && range.first <= result.back().second + 1) {
+            result.back().second = std::max(result.back().second, range.second);
         }
-        else if (range.first > to_remove.second) {
+        else {
             result.push_back(range);
         }
+    }
+    return result;
+}
+
+static Ranges intersect(const Ranges& a, const Ranges& b) {
+    Ranges result;
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        int first = std::max(a[i].first, b[j].first);
+        int second = std::min(a[i].second, b[j].second);
+        if (first <= second) {
+            result.emplace_back(first, second);
+        }
+        if (a[i].second < b[j].second) {
+            i++;
+        }
         else {
-            if (range.first < to_remove.first) {
-                result.push_back({ range.first, to_remove.first - 1 });
-            }
-            if (range.second > to_remove.second) {
-                result.push_back({ to_remove.second + 1, range.second });
-            }
+            j++;
         }
     }
-    ranges = result;
+    return result;
 }
 
+static Ranges complement(const Ranges& a) {
+    Ranges result;
+    int next = 0;
+    for (auto& range : a) {
+        if (range.first > next) {
+            result.emplace_back(next, range.first - 1);
+        }
+        next = range.second + 1;
+    }
+    if (next <= 0x10FFFF) {
+        result.emplace_back(next, 0x10FFFF);
+    }
+    return result;
+}
 
 bool canBeMatchedAsAnyCharacter(Char c) {
     return c != '\r' && c != '\n' &&
         c != fromCodepoint(0x2028) && c != fromCodepoint(0x2029);
 }
 
-Matcher::Matcher() : type(Type::AnyCharacter), isNegative(false) {
+Matcher::Matcher() : type(Type::AnyCharacter), ascii() {
 }
 
-Matcher::Matcher(const Char& c) : literal(c), type(Type::Literal), isNegative(false) {}
+Matcher::Matcher(const Char& c) : literal(c), type(Type::Literal), ascii() {}
 
 Matcher::Matcher(const Char& start, const Char& end) :
-    type(Type::CharacterClass), isNegative(false) {
+    type(Type::CharacterClass), ascii() {
     codepointRanges.emplace_back(start.toCodepoint(), end.toCodepoint());
+    normalize();
 }
 
 Matcher::Matcher(const Matcher& other)
-    : type(other.type), literal(other.literal), enumerations(other.enumerations),
-        codepointRanges(other.codepointRanges), isNegative(other.isNegative) {
+    : type(other.type), literal(other.literal), codepointRanges(other.codepointRanges) {
+    ascii[0] = other.ascii[0];
+    ascii[1] = other.ascii[1];
 }
 
-void Matcher::setNagative()
-{
-    isNegative = !isNegative;
+Matcher Matcher::empty() {
+    Matcher result;
+    result.type = Type::CharacterClass;
+    return result;
 }
 
-Matcher& Matcher::operator+=(const Char& c) {
+// Turns a literal into the class that holds it. "Any character" becomes the
+// class of everything it matches.
+void Matcher::toCharacterClass() {
     switch (type)
     {
     case Matcher::Type::Literal:
-        type = Type::CharacterClass;
-        enumerations.emplace_back(literal.toCodepoint());
+        codepointRanges = { { literal.toCodepoint(), literal.toCodepoint() } };
         literal = "";
         break;
     case Matcher::Type::AnyCharacter:
-        type = Type::CharacterClass;
+        codepointRanges = ::complement({ { 0x0A, 0x0A }, { 0x0D, 0x0D }, { 0x2028, 0x2029 } });
         break;
     default:
         break;
     }
+    type = Type::CharacterClass;
+}
+
+// Turns a class of one character into a literal, which the compiler can
+// merge into strings, and rebuilds the ASCII bitmap of any other class.
+void Matcher::normalize() {
+    if (type != Type::CharacterClass) {
+        return;
+    }
+    if (codepointRanges.size() == 1 && codepointRanges[0].first == codepointRanges[0].second) {
+        type = Type::Literal;
+        literal = Char(codepointRanges[0].first);
+        codepointRanges.clear();
+        return;
+    }
+    ascii[0] = ascii[1] = 0;
+    for (auto& range : codepointRanges) {
+        if (range.first >= 128) {
+            break;
+        }
+        for (int c = range.first; c <= std::min(range.second, 127); ++c) {
+            ascii[c >> 6] |= uint64_t(1) << (c & 63);
+        }
+    }
+}
 
-    enumerations.emplace_back(c.toCodepoint());
+Matcher& Matcher::operator|=(const Matcher& other) {
+    Matcher right = other;
+    toCharacterClass();
+    right.toCharacterClass();
+    codepointRanges = unite(codepointRanges, right.codepointRanges);
+    normalize();
     return *this;
 }
 
-Matcher& Matcher::operator+=(const std::pair<Char, Char>& range) {
-    switch (type)
-    {
-    case Matcher::Type::Literal:
-        type = Type::CharacterClass;
-        enumerations.emplace_back(literal.toCodepoint());
-        literal = "";
-        break;
-    case Matcher::Type::AnyCharacter:
-        type = Type::CharacterClass;
-        break;
-    default:
-        break;
-    }
-    std::pair<int, int> p{ range.first.toCodepoint(), range.second.toCodepoint() };
-    codepointRanges.emplace_back(p);
+Matcher& Matcher::operator&=(const Matcher& other) {
+    Matcher right = other;
+    toCharacterClass();
+    right.toCharacterClass();
+    codepointRanges = intersect(codepointRanges, right.codepointRanges);
+    normalize();
     return *this;
 }
 
-Matcher Matcher::operator+(const Char& c) {
-    Matcher result = *this;
-    result.type = Type::CharacterClass;
-    result.enumerations.emplace_back(c.toCodepoint());
-    return result;
+Matcher& Matcher::operator-=(const Matcher& other) {
+    Matcher right = other;
+    toCharacterClass();
+    right.toCharacterClass();
+    codepointRanges = intersect(codepointRanges, ::complement(right.codepointRanges));
+    normalize();
+    return *this;
 }
 
-Matcher Matcher::operator+(const std::pair<Char, Char>& range) {
+void Matcher::complement() {
+    toCharacterClass();
+    codepointRanges = ::complement(codepointRanges);
+    normalize();
+}
+
+Matcher Matcher::operator|(const Matcher& other) const {
     Matcher result = *this;
-    result.type = Type::CharacterClass;
-    std::pair<int, int> p{ range.first.toCodepoint(), range.second.toCodepoint() };
-    result.codepointRanges.emplace_back(p);
+    result |= other;
     return result;
 }
 
-Matcher Matcher::operator-(const Char& c) {
+Matcher Matcher::operator&(const Matcher& other) const {
     Matcher result = *this;
-    result -= c;
+    result &= other;
     return result;
 }
 
-Matcher Matcher::operator-(const std::pair<Char, Char>& _range) {
+Matcher Matcher::operator-(const Matcher& other) const {
     Matcher result = *this;
-    std::pair<int, int> range{ _range.first.toCodepoint(), _range.second.toCodepoint() };
-    auto newEnd = std::remove_if(result.codepointRanges.begin(),
-        result.codepointRanges.end(), [&](const std::pair<int, int>& existingRange) {
-            return existingRange.first <= range.second && range.first <= existingRange.second;
-        });
-    result.codepointRanges.erase(newEnd, result.codepointRanges.end());
+    result -= other;
     return result;
 }
 
+Matcher& Matcher::operator+=(const Char& c) {
+    return *this |= Matcher(c);
+}
+
+Matcher& Matcher::operator+=(const std::pair<Char, Char>& range) {
+    return *this |= Matcher(range.first, range.second);
+}
+
+Matcher Matcher::operator+(const Char& c) const {
+    return *this | Matcher(c);
+}
+
+Matcher Matcher::operator+(const std::pair<Char, Char>& range) const {
+    return *this | Matcher(range.first, range.second);
+}
+
+Matcher Matcher::operator-(const Char& c) const {
+    return *this - Matcher(c);
+}
+
+Matcher Matcher::operator-(const std::pair<Char, Char>& range) const {
+    return *this - Matcher(range.first, range.second);
+}
+
 Matcher& Matcher::operator-=(const Char& c) {
+    return *this -= Matcher(c);
+}
+
+Matcher& Matcher::operator-=(const std::pair<Char, Char>& range) {
+    return *this -= Matcher(range.first, range.second);
+}
+
+bool Matcher::matchOther(Char ch) const {
     if (type == Type::Literal) {
-        // This situation shouldn't be happened.
-        std::cerr << "Internal Error!\n";
-        abort();
+        return literal == ch;
     }
-
-    std::pair<int, int> p1{ 0, c.toCodepoint() - 1 };
-    std::pair<int, int> p2{ c.toCodepoint() + 1, 0x10FFFF };
     if (type == Type::AnyCharacter) {
-        type = Type::CharacterClass;
-        codepointRanges.emplace_back(p1);
-        codepointRanges.emplace_back(p2);
+        return !ch.empty() && canBeMatchedAsAnyCharacter(ch);
     }
-    else {
-        auto it = std::remove(enumerations.begin(), enumerations.end(), c.toCodepoint());
-        if (it != enumerations.end()) {
-            enumerations.erase(it, enumerations.end());
-        }
+    // 第一个起点大于 c 的区间之前的那个区间
+    int c = ch.toCodepoint();
+    auto it = std::upper_bound(codepointRanges.begin(), codepointRanges.end(), c,
+        [](int value, const std::pair<int, int>& range) { return value < range.first; });
+    return it != codepointRanges.begin() && c <= std::prev(it)->second;
+}
 
-        remove(codepointRanges, { c.toCodepoint(), c.toCodepoint() });
-    }
-    return *this;
+Matcher::Type Matcher::getType() const {
+    return type;
 }
 
-Matcher& Matcher::operator-=(const std::pair<Char, Char>& _range) {
+Char Matcher::getLiteral() const {
+    return literal;
+}
+
+std::vector<std::pair<int, int>> Matcher::getRanges() const {
     if (type == Type::CharacterClass) {
-        auto range = std::make_pair(_range.first.toCodepoint(), _range.second.toCodepoint());
-        
-        remove(codepointRanges, range);
-    }
-    else if (type == Type::AnyCharacter) {
-        type = Type::CharacterClass;
-        std::pair<int, int> p1{ 0, _range.first.toCodepoint() - 1};
-        std::pair<int, int> p2{ _range.second.toCodepoint() + 1, 0x10FFFF };
-        codepointRanges.emplace_back(p1);
-        codepointRanges.emplace_back(p2);
+        return codepointRanges;
     }
-    else if (type == Type::Literal) {
-        // This situation shouldn't be happened.
-        std::cerr << "Internal Error!\n";
-        abort();
+    Matcher copy(*this);
+    copy.toCharacterClass();
+    return copy.codepointRanges;
+}
+
+static String describe(int c) {
+    if (c > 0x20 && c < 0x7F) {
+        return String(Char(c));
     }
-    return *this;
+    return "\\u{" + toHexString(c) + "}";
 }
 
-bool Matcher::match(Char ch) const {
+String Matcher::toString() const {
     if (type == Type::Literal) {
-        return literal == ch;
+        return describe(literal.toCodepoint());
     }
     if (type == Type::AnyCharacter) {
-        return canBeMatchedAsAnyCharacter(ch);
-    }
-    int c = ch.toCodepoint();
-    for (int e : enumerations) {
-        if (e == c) return true;
+        return ".";
     }
+    String s = "[";
     for (auto p : codepointRanges) {
-        if (p.first <= c && c <= p.second) {
-            return true;
-        }
+        s += p.first == p.second ? describe(p.first) : describe(p.first) + "-" + describe(p.second);
     }
-    return false;
+    return s + "]";
 }
@@ -22,23 +22,57 @@ public:
     Matcher(const Char& c);
     Matcher(const Char& start, const Char& end);
     Matcher(const Matcher& other);
-    void setNagative();
+
+    // The class that matches nothing.
+    static Matcher empty();
+
+    // Set algebra. Every operation leaves a character class in canonical
+    // form (or a literal, if a single character is left), so negation and
+    // nesting cost nothing when matching.
+    Matcher& operator|=(const Matcher& other);
+    Matcher& operator&=(const Matcher& other);
+    Matcher& operator-=(const Matcher& other);
+    Matcher operator|(const Matcher& other) const;
+    Matcher operator&(const Matcher& other) const;
+    Matcher operator-(const Matcher& other) const;
+    // Replaces the set by every code point it does not hold.
+    void complement();
+
     Matcher& operator+=(const Char& c);
     Matcher& operator+=(const std::pair<Char, Char>& range);
-    Matcher operator+(const Char& c);
-    Matcher operator+(const std::pair<Char, Char>& range);
-    Matcher operator-(const Char& c);
-    Matcher operator-(const std::pair<Char, Char>& _range);
+    Matcher operator+(const Char& c) const;
+    Matcher operator+(const std::pair<Char, Char>& range) const;
+    Matcher operator-(const Char& c) const;
+    Matcher operator-(const std::pair<Char, Char>& range) const;
     Matcher& operator-=(const Char& c);
-    Matcher& operator-=(const std::pair<Char, Char>& _range);
-    bool match(Char ch) const;
-    bool isNegative;
+    Matcher& operator-=(const std::pair<Char, Char>& range);
+    bool match(Char ch) const {
+        // ASCII 字符在类中只需测试一位
+        unsigned c = static_cast<unsigned>(ch.toCodepoint());
+        if (type == Type::CharacterClass && c < 128) {
+            return (ascii[c >> 6] >> (c & 63)) & 1;
+        }
+        return matchOther(ch);
+    }
+    Type getType() const;
+    Char getLiteral() const;
+    // The code points matched, as sorted ranges that neither overlap nor
+    // touch.
+    std::vector<std::pair<int, int>> getRanges() const;
+    String toString() const;
 
 private:
     Type type;
     Char literal;
-    std::vector<int> enumerations;
+    // A character class is kept as sorted ranges that neither overlap nor
+    // touch, so that a code point is looked up by binary search. Its ASCII
+    // part is also kept as a bitmap: one bit test per ASCII character.
     std::vector<std::pair<int, int>> codepointRanges;
+    uint64_t ascii[2];
+
+    bool matchOther(Char ch) const;
+    void toCharacterClass();
+    void normalize();
 };
 
 #endif // !_MATCHER_HH_
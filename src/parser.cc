@@ -1,8 +1,19 @@
 #include "parser.hh"
+#include "unicode.hh"
 
 bool Parser::final() const
 {
-    return current == tokens.size() - 1;
+    return current + 1 >= tokens.size();
+}
+
+bool Parser::end() const
+{
+    return current >= tokens.size();
+}
+
+bool Parser::check(TokenType type) const
+{
+    return !end() && tokens[current].is(type);
 }
 
 Token Parser::lookahead() const
@@ -48,6 +59,7 @@ std::unique_ptr<CharacterClass> asWhitespaceCharacterClass(bool isNegative)
         { fromCodepoint(0x3000) },
         { fromCodepoint(0xfeff) },
     });
+    spaceCharacterClass->addRange({ Char(0x2000), Char(0x200a) });
 
     return spaceCharacterClass;
 }
@@ -117,17 +129,18 @@ std::unique_ptr<AST> Parser::convertSpecialSequenceToActualAST(SpecialSequenceTy
 
 std::unique_ptr<AST> Parser::parse()
 {
-    return ast<Regex>(parseExpression());
+    auto regex = ast<Regex>(parseExpression());
+    if (!end())
+    {
+        error("Unmatched \")\"");
+        return nullptr;
+    }
+    return regex;
 }
 
 
 std::unique_ptr<AST> Parser::parseExpression()
 {
-    if (here().is(TokenType::GroupClose))
-    {
-        error("Capturing group without actual directionality");
-        return nullptr;
-    }
     auto term = parseTerm();
     auto expression = ast<Expression>(std::move(term));
 
@@ -139,7 +152,7 @@ std::unique_ptr<AST> Parser::parseExpression()
 
 void Parser::parseExpressionPrime(std::unique_ptr<Expression>& expression)
 {
-    if (!final() && here().is(TokenType::BranchAlternation))
+    if (check(TokenType::BranchAlternation))
     {
         advance();
         auto term = parseTerm();
@@ -149,80 +162,53 @@ void Parser::parseExpressionPrime(std::unique_ptr<Expression>& expression)
 }
 
 
-// parseFactor 将不会在退出前自动移动索引！！！
+// 每个 parseXxx 从其第一个 token 开始，返回时索引指向其后的第一个 token
 
 std::unique_ptr<AST> Parser::parseTerm()
 {
     bool hasAnchorStart = false;
-    if (here().is(TokenType::AnchorStart))
+    if (check(TokenType::AnchorStart))
     {
         hasAnchorStart = true;
         advance();
     }
 
-    auto factor0 = parseFactor();
-
-    auto term = ast<Term>(hasAnchorStart, std::move(factor0));
-
-    // 这时 token 还是该 Factor 所对应的最后一个 token
-    // 若它也是整个正则式的最后一个 token，就结束
-
-    if (final() || lookahead().is(TokenType::GroupClose) || here().is(TokenType::GroupClose))
-    {
-        return term;
-    }
-
-    advance();
+    std::unique_ptr<Term> term;
 
-    do
+    while (!end()
+        && !check(TokenType::BranchAlternation)
+        && !check(TokenType::GroupClose)
+        && !check(TokenType::AnchorEnd))
     {
-
-        if (here().is(TokenType::GroupClose))
+        auto factor = parseFactor();
+        if (term)
         {
-            return term;
-        }
-        
-
-        if (!final() && (
-            here().is(TokenType::QuantifierBraces) ||
-            here().is(TokenType::QuantifierStar) ||
-            here().is(TokenType::QuantifierQuestion) ||
-            here().is(TokenType::QuantifierPlus)
-        ))
-        {
-            advance();
+            term->addFactor(std::move(factor));
         }
-
-        auto factor = std::move(parseFactor());
-
-        // token 是该 Factor 的最后一个 token
-
-        term->addFactor(std::move(factor));
-
-        if (!final())
+        else
         {
-            advance();
+            term = ast<Term>(hasAnchorStart, std::move(factor));
         }
+    }
 
-    } while (!final()
-        && !lookahead().is(TokenType::AnchorEnd)
-        && !lookahead().is(TokenType::BranchAlternation));
-
-    if (final()) return term;
+    // 空的匹配项，如 "a|" 或 "^$"
+    if (!term)
+    {
+        term = ast<Term>(hasAnchorStart, ast<Factor>(ast<Atom>(ast<Literal>("")), ast<Quantifier>()));
+    }
 
-    if (lookahead().is(TokenType::AnchorEnd))
+    if (check(TokenType::AnchorEnd))
     {
         term->setEndAnchor();
         advance();
-        return term;
-    }
-    if (lookahead().is(TokenType::BranchAlternation))
-    {
-        return term;
+        if (!end() && !check(TokenType::BranchAlternation) && !check(TokenType::GroupClose))
+        {
+            error("Unexpected pattern after \"$\"");
+            return nullptr;
+        }
     }
 
-    error("Internal Error from Parser::parseTerm()");
-    return nullptr;
+    return term;
 }
 
 std::unique_ptr<AST> Parser::parseFactor()
@@ -230,102 +216,102 @@ std::unique_ptr<AST> Parser::parseFactor()
     // 一个 Factor 要么是一个 Atom 及其量词，要么是一个断言
 
     bool isAssertion =
-        here().is(TokenType::AssertionLookahead) ||
-        here().is(TokenType::AssertionNegativeLookahead) ||
-        here().is(TokenType::AssertionLookbehind) ||
-        here().is(TokenType::AssertionNegativeLookbehind);
+        check(TokenType::AssertionLookahead) ||
+        check(TokenType::AssertionNegativeLookahead) ||
+        check(TokenType::AssertionLookbehind) ||
+        check(TokenType::AssertionNegativeLookbehind);
     if (isAssertion)
     {
-        Token next = lookahead();
-        switch (next.type)
+        auto assertion = ast<Factor>(parseAssertion());
+        if (checkQuantifier())
         {
-        case TokenType::QuantifierBraces:
-        case TokenType::QuantifierStar:
-        case TokenType::QuantifierPlus:
-        case TokenType::QuantifierQuestion:
             error("Unexpected quantifier after an assertion");
             return nullptr;
         }
-        auto assertion = ast<Factor>(std::move(parseAssertion()));
         return assertion;
     }
 
-    // 现在 token 是该 Atom 的第一个 token
-
     auto atom = parseAtom();
+    auto quantifier = parseQuantifier();
+    return ast<Factor>(std::move(atom), std::move(quantifier));
+}
 
-    // 现在 token 是该 Atom 的最后一个 token
-        
-    // 若 Atom 是一个字符，则显然索引没有变化
-
-    if (final())
-    {
-        auto factor = ast<Factor>(std::move(atom), std::move(ast<Quantifier>(Quantifier::Type::Once)));
-        return factor;
-    }
-
+bool Parser::checkQuantifier() const
+{
+    return check(TokenType::QuantifierBraces)
+        || check(TokenType::QuantifierStar)
+        || check(TokenType::QuantifierPlus)
+        || check(TokenType::QuantifierQuestion);
+}
 
-    // 下一个 token 会是量词吗？
-    Token l = lookahead();
-    if (l.is(TokenType::QuantifierBraces)
-        || l.is(TokenType::QuantifierStar)
-        || l.is(TokenType::QuantifierPlus)
-        || l.is(TokenType::QuantifierQuestion))
+std::unique_ptr<AST> Parser::parseQuantifier()
+{
+    if (!checkQuantifier())
     {
-        advance();
+        return ast<Quantifier>(Quantifier::Type::Once);
     }
 
     Token h = here();
+    advance();
 
-    // 下一个 token 不是量词，那么不移动索引，索引依然指向当前 Factor 的最后一个 token
-
-    // 这一个 token 会是量词吗？
+    std::unique_ptr<Quantifier> quantifier;
     if (h.is(TokenType::QuantifierBraces))
     {
-        int min = toInteger(here().value.first);
-        int max = toInteger(here().value.second);
+        int min = toInteger(h.value.first);
+        int max = toInteger(h.value.second);
         if (min > max && max != -1)
         {
             error("numbers out of order in {} quantifier");
         }
-        auto quantifier = ast<Quantifier>(min, max);
-        if (!final() && lookahead().is(TokenType::GroupClose))
-        {
-            advance();
-        }
-        return ast<Factor>(std::move(atom), std::move(quantifier));
+        quantifier = ast<Quantifier>(min, max);
     }
-    if (h.is(TokenType::QuantifierStar))
+    else if (h.is(TokenType::QuantifierStar))
     {
-        auto quantifier = ast<Quantifier>(Quantifier::Type::ZeroOrMore);
-        if (!final() && lookahead().is(TokenType::GroupClose))
-        {
-            advance();
-        }
-        return ast<Factor>(std::move(atom), std::move(quantifier));
+        quantifier = ast<Quantifier>(Quantifier::Type::ZeroOrMore);
     }
-    if (h.is(TokenType::QuantifierPlus))
+    else if (h.is(TokenType::QuantifierPlus))
     {
-        auto quantifier = ast<Quantifier>(Quantifier::Type::OneOrMore);
-        if (!final() && lookahead().is(TokenType::GroupClose))
-        {
-            advance();
-        }
-        return ast<Factor>(std::move(atom), std::move(quantifier));
+        quantifier = ast<Quantifier>(Quantifier::Type::OneOrMore);
     }
-    if (h.is(TokenType::QuantifierQuestion))
+    else
     {
-        auto quantifier = ast<Quantifier>(Quantifier::Type::ZeroOrOne);
-        if (!final() && lookahead().is(TokenType::GroupClose))
-        {
-            advance();
-        }
-        return ast<Factor>(std::move(atom), std::move(quantifier));
+        quantifier = ast<Quantifier>(Quantifier::Type::ZeroOrOne);
+    }
+
+    // "*?", "+?", "??", "{m,n}?"
+    if (check(TokenType::QuantifierQuestion))
+    {
+        quantifier->setLazy();
+        advance();
+    }
+    // "*+", "++", "?+", "{m,n}+"
+    else if (check(TokenType::QuantifierPlus))
+    {
+        quantifier->setPossessive();
+        advance();
     }
 
-    auto quantifier = ast<Quantifier>(Quantifier::Type::Once);
-    auto factor = ast<Factor>(std::move(atom), std::move(quantifier));
-    return factor;
+    if (checkQuantifier())
+    {
+        error("Nothing to repeat before a quantifier");
+        return nullptr;
+    }
+
+    return quantifier;
+}
+
+static Char escapedCharacter(const String& seq)
+{
+    // seq: "\n", get '\n'
+    switch (seq[1].toStdChar())
+    {
+    case 'n': return '\n';
+    case 'r': return '\r';
+    case 't': return '\t';
+    case 'f': return '\f';
+    case 'v': return '\v';
+    default: return seq[1];
+    }
 }
 
 std::unique_ptr<AST> Parser::parseAtom()
@@ -333,65 +319,88 @@ std::unique_ptr<AST> Parser::parseAtom()
     // 一个 Atom 可能是一个单字符、字符类、组
     // 当前 token 为 Atom 的第一个 token
 
-    if (here().is(TokenType::BranchAlternation))
+    if (end())
     {
-        advance();
+        error("Unexpected end of pattern");
+        return nullptr;
     }
 
     Token t = here();
 
     if (t.is(TokenType::LiteralCharacter) || t.is(TokenType::UnicodeCodePoint))
     {
-        auto l = ast<Literal>(t.value.first[0]);
-        if (!final() && lookahead().is(TokenType::GroupClose))
-        {
-            advance();
-        }
-        return ast<Atom>(std::move(l));
+        advance();
+        return ast<Atom>(ast<Literal>(t.value.first[0]));
+    }
+    else if (t.is(TokenType::EscapeSequence))
+    {
+        advance();
+        return ast<Atom>(ast<Literal>(escapedCharacter(t.value.first)));
     }
     else if (t.is(TokenType::SpecialSequence))
     {
+        advance();
         SpecialSequenceType type = translateSpecialSequence(t.value.first);
         return convertSpecialSequenceToActualAST(type);
     }
+    else if (t.is(TokenType::UnicodeProperty) || t.is(TokenType::UnicodePropertyNegative))
+    {
+        auto propertyCharacterClass = parseUnicodeProperty();
+        advance();
+        return ast<Atom>(std::move(propertyCharacterClass));
+    }
     else if (t.is(TokenType::AnyCharacter))
     {
-        if (!final() && lookahead().is(TokenType::GroupClose))
-        {
-            advance();
-        }
-        return ast<Atom>(std::move(ast<AnyCharacter>()));
+        advance();
+        return ast<Atom>(ast<AnyCharacter>());
     }
     else if (t.is(TokenType::CharacterClassOpen))
     {
         advance();
-        bool isNegative = here().is(TokenType::CharacterClassNegative);
+        bool isNegative = check(TokenType::CharacterClassNegative);
+        if (isNegative)
+        {
+            advance();
+        }
 
         auto characterClass = ast<CharacterClass>(isNegative);
 
-        if ((isNegative && lookahead().is(TokenType::CharacterClassClose))
-            || (!isNegative && here().is(TokenType::CharacterClassClose))) {
+        if (check(TokenType::CharacterClassClose))
+        {
             error("Character classes without actual directionality");
             return nullptr;
         }
-        
-        if (isNegative)
-        {
-            advance();
-        }
 
-        while (!here().is(TokenType::CharacterClassClose))
+        while (!check(TokenType::CharacterClassClose))
         {
+            if (end())
+            {
+                error("Expected \"]\" to close the character class");
+                return nullptr;
+            }
             t = here();
-            if (t.is(TokenType::CharacterClassLiteral) || t.is(TokenType::UnicodeCodePoint))
+            if (t.is(TokenType::CharacterClassLiteral) || t.is(TokenType::UnicodeCodePoint)
+                || t.is(TokenType::LiteralCharacter))
             {
                 characterClass->addChar(t.value.first[0]);
             }
+            else if (t.is(TokenType::EscapeSequence))
+            {
+                characterClass->addChar(escapedCharacter(t.value.first));
+            }
             else if (t.is(TokenType::CharacterClassRange))
             {
+                if (t.value.second[0] < t.value.first[0])
+                {
+                    error("Range out of order in character class");
+                }
                 characterClass->addRange({ t.value.first[0],
                                            t.value.second[0] });
             }
+            else if (t.is(TokenType::UnicodeProperty) || t.is(TokenType::UnicodePropertyNegative))
+            {
+                characterClass->addClass(parseUnicodeProperty());
+            }
             else if (t.is(TokenType::SpecialSequence))
             {
                 SpecialSequenceType type = translateSpecialSequence(t.value.first);
@@ -412,27 +421,16 @@ std::unique_ptr<AST> Parser::parseAtom()
                 case SpecialSequenceType::v:
                     characterClass->addChar("\v");
                     break;
-                case SpecialSequenceType::s: {
-                    auto chars = asWhitespaceCharacterClass(false)->getChars();
-                    for (const auto& ch : chars) characterClass->addChar(ch);
-                    auto ranges = asWhitespaceCharacterClass(false)->getRanges();
-                    for (const auto& range : ranges) characterClass->addRange(range);
+                case SpecialSequenceType::s: case SpecialSequenceType::S:
+                    characterClass->addClass(asWhitespaceCharacterClass(type == SpecialSequenceType::S));
                     break;
-                }
-                case SpecialSequenceType::w: {
-                    characterClass->addRange({ "0", "9" });
-                    characterClass->addRange({ "A", "Z" });
-                    characterClass->addRange({ "a", "z" });
-                    characterClass->addChar("_");
+                case SpecialSequenceType::w: case SpecialSequenceType::W:
+                    characterClass->addClass(asWordCharacterClass(type == SpecialSequenceType::W));
                     break;
-                }
-                case SpecialSequenceType::d: {
-                    characterClass->addRange({ "0", "9" });
+                case SpecialSequenceType::d: case SpecialSequenceType::D:
+                    characterClass->addClass(asDigitCharacterClass(type == SpecialSequenceType::D));
                     break;
                 }
-                case SpecialSequenceType::W: case SpecialSequenceType::S: case SpecialSequenceType::D:
-                    error("Internal Error: \\S and \\W and \\W are not implemented");
-                }
             }
             else
             {
@@ -440,136 +438,183 @@ std::unique_ptr<AST> Parser::parseAtom()
             }
             advance();
         }
-        if (!final() && lookahead().is(TokenType::GroupClose))
-        {
-            advance();
-            advance();
-        }
+        advance();
 
-        return characterClass;
+        return ast<Atom>(std::move(characterClass));
     }
     else if (t.is(TokenType::GroupOpen))
     {
-        return ast<Atom>(std::move(parseGroup()));
+        return ast<Atom>(parseGroup());
     }
     else if (t.is(TokenType::NamedCapturingGroupOpen))
     {
-        return ast<Atom>(std::move(parseNamedCapturingGroup()));
+        return ast<Atom>(parseNamedCapturingGroup());
     }
     else if (t.is(TokenType::NonCapturingGroupOpen))
     {
-        return ast<Atom>(std::move(parseNonCapturingGroup()));
+        return ast<Atom>(parseNonCapturingGroup());
+    }
+    else if (t.is(TokenType::AtomicGroupOpen))
+    {
+        return ast<Atom>(parseAtomicGroup());
     }
     else if (t.is(TokenType::Backreference))
     {
-        return ast<Atom>(std::move(ast<Backreference>(toInteger(t.value.first))));
+        advance();
+        return ast<Atom>(ast<Backreference>(toInteger(t.value.first)));
     }
     else if (t.is(TokenType::NamedBackreference))
     {
-        return ast<Atom>(std::move(ast<Backreference>(t.value.first)));
+        advance();
+        return ast<Atom>(ast<Backreference>(t.value.first));
     }
-    else if (  t.is(TokenType::AssertionLookahead)
-        || t.is(TokenType::AssertionNegativeLookahead)
-        || t.is(TokenType::AssertionLookbehind)
-        || t.is(TokenType::AssertionNegativeLookbehind))
+    else if (checkQuantifier())
     {
-        return ast<Atom>(std::move(parseAssertion()));
+        error("Nothing to repeat before a quantifier");
+        return nullptr;
     }
     error("Internal Error from Parser::parseAtom() - 2");
     return std::unique_ptr<AST>();
 }
 
+void Parser::expectGroupClose()
+{
+    if (!check(TokenType::GroupClose))
+    {
+        error("Expected \")\" to end the group");
+    }
+    advance();
+}
+
 std::unique_ptr<AST> Parser::parseGroup()
 {
-    if (lookahead().is(TokenType::GroupClose))
+    advance();
+    if (check(TokenType::GroupClose))
     {
         error("Capturing group without actual directionality");
         return nullptr;
     }
-    advance();
-    auto group = ast<CapturingGroup>(std::move(parseExpression()));
+    auto group = ast<CapturingGroup>(parseExpression());
+    expectGroupClose();
     return group;
 }
 
 std::unique_ptr<AST> Parser::parseNamedCapturingGroup()
 {
-    if (!lookahead().is(TokenType::NamedCapturingGroupName))
+    advance();
+    if (!check(TokenType::NamedCapturingGroupName))
     {
         error("Named capturing group without actual directionality");
         return nullptr;
     }
 
+    String name = here().value.first;
+
     advance();
 
-    if (lookahead().is(TokenType::GroupClose))
+    if (check(TokenType::GroupClose))
     {
         error("Named capturing group without actual directionality");
         return nullptr;
     }
 
-    String name = here().value.first;
-
-    advance();
-
-    auto group = ast<NamedCapturingGroup>(name, std::move(parseExpression()));
+    auto group = ast<NamedCapturingGroup>(name, parseExpression());
+    expectGroupClose();
     return group;
 }
 
 std::unique_ptr<AST> Parser::parseNonCapturingGroup()
 {
-    if (lookahead().is(TokenType::GroupClose))
+    advance();
+    if (check(TokenType::GroupClose))
     {
         error("Non-capturing group without actual directionality");
         return nullptr;
     }
 
+    auto group = ast<NonCapturingGroup>(parseExpression());
+    expectGroupClose();
+    return group;
+}
+
+std::unique_ptr<AST> Parser::parseAtomicGroup()
+{
     advance();
-    auto group = ast<NonCapturingGroup>(std::move(parseExpression()));
+    if (check(TokenType::GroupClose))
+    {
+        error("Atomic group without actual directionality");
+        return nullptr;
+    }
+
+    auto group = ast<AtomicGroup>(parseExpression());
+    expectGroupClose();
     return group;
 }
 
-std::unique_ptr<AST> Parser::parseUnicodeProperty()
+// Resolves the current \p{...} or \P{...} token into the class of the code
+// points that have the property, like \d and \w.
+std::unique_ptr<CharacterClass> Parser::parseUnicodeProperty()
 {
-    return std::unique_ptr<AST>();
+    const Token& t = here();
+    if (!t.value.second.empty())
+    {
+        error("Unicode property values are not supported: " + t.value.first + "=" + t.value.second);
+        return nullptr;
+    }
+
+    auto propertyCharacterClass = ast<CharacterClass>(t.is(TokenType::UnicodePropertyNegative));
+    try
+    {
+        for (const auto& range : propertyRanges(t.value.first.toUTF8()))
+        {
+            propertyCharacterClass->addRange({ Char(static_cast<int>(range.first)),
+                                               Char(static_cast<int>(range.second)) });
+        }
+    }
+    catch (const std::invalid_argument&)
+    {
+        error("Unknown Unicode property: " + t.value.first);
+        return nullptr;
+    }
+    return propertyCharacterClass;
 }
 
 std::unique_ptr<AST> Parser::parseAssertion()
 {
-    switch (here().type)
+    TokenType type = here().type;
+    advance();
+    if (check(TokenType::GroupClose))
     {
-    case TokenType::AssertionLookahead:
-        if (lookahead().is(TokenType::GroupClose))
+        switch (type)
         {
+        case TokenType::AssertionLookahead:
             error("Lookahead assertion without actual directionality");
-            return nullptr;
-        }
-        advance();
-        return ast<LookaheadAssertion>(std::move(parseExpression()), true);
-    case TokenType::AssertionNegativeLookahead:
-        if (lookahead().is(TokenType::GroupClose))
-        {
+            break;
+        case TokenType::AssertionNegativeLookahead:
             error("Negative lookahead assertion without actual directionality");
-            return nullptr;
-        }
-        advance();
-        return ast<LookaheadAssertion>(std::move(parseExpression()), false);
-    case TokenType::AssertionLookbehind:
-        if (lookahead().is(TokenType::GroupClose))
-        {
+            break;
+        case TokenType::AssertionLookbehind:
             error("Lookbehind assertion without actual directionality");
-            return nullptr;
-        }
-        advance();
-        return ast<LookbehindAssertion>(std::move(parseExpression()), true);
-    case TokenType::AssertionNegativeLookbehind:
-        if (lookahead().is(TokenType::GroupClose))
-        {
+            break;
+        default:
             error("Negative lookbehind assertion without actual directionality");
-            return nullptr;
+            break;
         }
-        advance();
-        return ast<LookbehindAssertion>(std::move(parseExpression()), false);
+        return nullptr;
     }
-}
 
+    auto expression = parseExpression();
+    expectGroupClose();
 
+    switch (type)
+    {
+    case TokenType::AssertionLookahead:
+        return ast<LookaheadAssertion>(std::move(expression), true);
+    case TokenType::AssertionNegativeLookahead:
+        return ast<LookaheadAssertion>(std::move(expression), false);
+    case TokenType::AssertionLookbehind:
+        return ast<LookbehindAssertion>(std::move(expression), true);
+    default:
+        return ast<LookbehindAssertion>(std::move(expression), false);
+    }
+}
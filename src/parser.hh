@@ -11,6 +11,14 @@ private:
 
     // Is current token the last one?
     bool final() const;
+
+    // Have all tokens been consumed?
+    bool end() const;
+
+    // Is the current token of the given type?
+    bool check(TokenType type) const;
+
+    bool checkQuantifier() const;
     
     // Look the next token without moving position
     Token lookahead() const;
@@ -34,10 +42,11 @@ private:
      *      → Group
      *      → NamedCapturingGroup
      *      → NonCapturingGroup
+     *      → AtomicGroup
      *      → Backreference
      *      → UnicodeProperty
      *      → UnicodeCodepoint
-     * Quantifier → "?" | "*" | "+" | "{"[Number][","[Number]] "}"
+     * Quantifier → ( "?" | "*" | "+" | "{"[Number][","[Number]] "}" ) [ "?" | "+" ]
      * Assertion → "(?=" Expression ")" (正向先行断言)
      *           → "(?!" Expression ")" (负向先行断言)
      *           → "(?<=" Expression ")" (正向后行断言)
@@ -46,6 +55,7 @@ private:
      * Group → "(" Expression ")"
      * NamedCapturingGroup → "(?P<" Name ">" Expression ")"
      * NonCapturingGroup → "(?:" Expression ")"
+     * AtomicGroup → "(?>" Expression ")"
      * Backreference → "\" Number
      *               → "\" Name
      */
@@ -55,14 +65,18 @@ private:
     std::unique_ptr<AST> parseTerm();
     std::unique_ptr<AST> parseFactor();
     std::unique_ptr<AST> parseAtom();
+    std::unique_ptr<AST> parseQuantifier();
 
     std::unique_ptr<AST> parseGroup();
     std::unique_ptr<AST> parseNamedCapturingGroup();
     std::unique_ptr<AST> parseNonCapturingGroup();
-    std::unique_ptr<AST> parseUnicodeProperty();
+    std::unique_ptr<AST> parseAtomicGroup();
+    std::unique_ptr<CharacterClass> parseUnicodeProperty();
 
     std::unique_ptr<AST> parseAssertion();
 
+    void expectGroupClose();
+
     std::unique_ptr<AST> convertSpecialSequenceToActualAST(SpecialSequenceType type);
 
 public:
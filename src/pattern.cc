@@ -0,0 +1,249 @@
+#include "pattern.hh"
+#include "compiler.hh"
+#include <stdexcept>
+
+std::unique_ptr<AST> Pattern::parse(const String& pattern)
+{
+    Lexer lexer(pattern);
+    Parser parser(lexer.tokenize());
+    return parser.parse();
+}
+
+Pattern::Pattern(const String& pattern) : Pattern(parse(pattern))
+{
+}
+
+Pattern::Pattern(std::unique_ptr<AST> regex)
+    : program(std::make_shared<const Program>(Compiler().compile(*regex))), prefilter(Prefilter::build(*regex))
+{
+    if (VM::supports(*program) && DFA::supports(*program))
+    {
+        // 反向程序里的原子组未必都能省去
+        Program reversed = Compiler(true).compile(*regex);
+        if (DFA::supports(reversed))
+        {
+            forward = std::make_unique<const DFA>(*program, false);
+            backward = std::make_unique<const DFA>(reversed, true);
+        }
+    }
+    // 构造时就建好本线程的引擎，程序不支持时在此报错
+    scratch();
+}
+
+// Takes the calling thread's engines from the pool, making them on its first
+// search, and brings their budget up to date.
+Pool<Pattern::Scratch>::Guard Pattern::scratch() const
+{
+    Pool<Scratch>::Guard engines = pool.get([this]
+    {
+        auto made = std::make_unique<Scratch>();
+        if (!VM::supports(*program))
+        {
+            made->backtracker = std::make_unique<Backtracker>(program);
+            return made;
+        }
+        made->vm = std::make_unique<VM>(program);
+        if (forward)
+        {
+            made->forward = std::make_unique<DFA>(*forward);
+            made->backward = std::make_unique<DFA>(*backward);
+        }
+        return made;
+    });
+    if (engines->budgets != budgets)
+    {
+        if (engines->backtracker)
+        {
+            engines->backtracker->setBudget(budget);
+        }
+        if (engines->vm)
+        {
+            engines->vm->setBudget(budget);
+        }
+        if (engines->forward)
+        {
+            engines->forward->setBudget(budget);
+            engines->backward->setBudget(budget);
+        }
+        engines->budgets = budgets;
+    }
+    return engines;
+}
+
+// Returns false if no match can begin at or after from. Otherwise moves
+// from to the first place where one can.
+bool Pattern::skip(StringView text, size_t& from) const
+{
+    if (!prefilter)
+    {
+        return true;
+    }
+    size_t position = prefilter->find(text, from);
+    if (position == VM::npos)
+    {
+        return false;
+    }
+    if (prefilter->isPrefix())
+    {
+        from = position;
+    }
+    return true;
+}
+
+bool Pattern::test(StringView text) const
+{
+    size_t from = 0;
+    if (!skip(text, from))
+    {
+        return false;
+    }
+    Pool<Scratch>::Guard engines = scratch();
+    if (engines->forward)
+    {
+        size_t end;
+        DFA::Result result = engines->forward->search(text, from, text.size(), true, end);
+        if (result != DFA::Result::GaveUp)
+        {
+            return matched(result);
+        }
+    }
+    if (engines->backtracker)
+    {
+        return run(*engines, text, engines->slots, from, false, false);
+    }
+    return matched(engines->vm->test(text));
+}
+
+bool Pattern::find(StringView text, size_t& start, size_t& end, size_t from) const
+{
+    return find(*scratch(), text, start, end, from, false);
+}
+
+bool Pattern::find(Scratch& engines, StringView text, size_t& start, size_t& end, size_t from,
+    bool continuing) const
+{
+    if (!skip(text, from))
+    {
+        return false;
+    }
+    if (engines.forward)
+    {
+        DFA::Result result = engines.forward->search(text, from, text.size(), false, end);
+        if (result != DFA::Result::GaveUp && !matched(result))
+        {
+            return false;
+        }
+        if (result == DFA::Result::Match)
+        {
+            DFA::Result begin = engines.backward->search(text, end, from, false, start);
+            if (begin != DFA::Result::GaveUp && matched(begin))
+            {
+                return true;
+            }
+        }
+    }
+
+    if (!run(engines, text, engines.slots, from, false, continuing))
+    {
+        return false;
+    }
+    start = engines.slots[0];
+    end = engines.slots[1];
+    return true;
+}
+
+bool Pattern::search(StringView text, Captures& captures, size_t from) const
+{
+    return search(*scratch(), text, captures, from, false);
+}
+
+bool Pattern::search(Scratch& engines, StringView text, Captures& captures, size_t from, bool continuing) const
+{
+    size_t start, end;
+    if (forward && find(engines, text, start, end, from, continuing))
+    {
+        return matched(engines.vm->search(text, captures, start, true));
+    }
+    return !forward && skip(text, from) && run(engines, text, captures, from, false, continuing);
+}
+
+// continuing tells that text is the one the engines last searched, unchanged,
+// so that their lookaround tables can be reused (see Matches).
+bool Pattern::run(Scratch& engines, StringView text, Captures& captures, size_t from, bool anchored,
+    bool continuing) const
+{
+    if (engines.vm)
+    {
+        engines.vm->continuing = continuing;
+    }
+    if (engines.backtracker)
+    {
+        engines.backtracker->continuing = continuing;
+    }
+    return matched(engines.backtracker ? engines.backtracker->search(text, captures, from, anchored)
+        : engines.vm->search(text, captures, from, anchored));
+}
+
+Matches Pattern::findIter(StringView text) const
+{
+    return Matches(*this, text);
+}
+
+void Pattern::setBudget(const Budget& _budget)
+{
+    budget = _budget;
+    budgets++;
+}
+
+template <typename Result>
+bool Pattern::matched(Result result)
+{
+    if (result == Result::BudgetExceeded)
+    {
+        throw BudgetExceeded();
+    }
+    return result == Result::Match;
+}
+
+bool Matches::next(size_t& start, size_t& end)
+{
+    while (from <= text.size() && pattern.find(*engines, text, start, end, from, searched))
+    {
+        searched = true;
+        if (take(start, end))
+        {
+            return true;
+        }
+    }
+    from = VM::npos;
+    return false;
+}
+
+bool Matches::next(Captures& captures)
+{
+    while (from <= text.size() && pattern.search(*engines, text, captures, from, searched))
+    {
+        searched = true;
+        if (take(captures[0], captures[1]))
+        {
+            return true;
+        }
+    }
+    from = VM::npos;
+    return false;
+}
+
+// Returns true if the match found from `from` is the next one. Otherwise it
+// is empty and where the last one ended, and from moves one character on.
+bool Matches::take(size_t start, size_t end)
+{
+    if (start == end && end == lastEnd)
+    {
+        size_t length;
+        text.decode(end, length);
+        from = length ? end + length : VM::npos;
+        return false;
+    }
+    from = lastEnd = end;
+    return true;
+}
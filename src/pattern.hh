@@ -0,0 +1,142 @@
+#ifndef _PATTERN_HH_
+#define _PATTERN_HH_
+
+#include "backtrack.hh"
+#include "dfa.hh"
+#include "pool.hh"
+#include "prefilter.hh"
+
+class Matches;
+
+// A compiled regular expression together with the engines that run it.
+//
+// When the program allows it, searches run on lazy DFAs: a forward scan
+// finds where the leftmost match ends, then a backward scan of the reverse
+// program finds where it begins. The Pike VM only runs over the match itself,
+// when captures are wanted, or over the whole text if a DFA gives up.
+//
+// Before any engine runs, texts that lack the literals every match needs
+// are rejected by a Prefilter.
+//
+// Programs the VM does not support run on the backtracker instead, which
+// stops after a number of steps that grows with the program and the text
+// unless the budget sets one (see Backtracker): those with
+// backreferences or atomic groups, and those whose counted loops nest so
+// deep that the VM would need more than VM::maxStates states. The
+// backtracker keeps the count of every loop in a slot of its own.
+//
+// Each engine a search runs on is metered against the budget set with
+// setBudget(); a search that runs out of it throws BudgetExceeded.
+//
+// A Pattern does not change once compiled, and any number of threads can
+// search with it at once. What a search writes to, the engines with their
+// thread lists, stacks and DFA caches, is Scratch kept in a Pool, one per
+// thread. Only setBudget() must not run during a search.
+class Pattern
+{
+    friend class Matches;
+
+public:
+    Pattern(const String& pattern);
+
+    // Returns true if the pattern matches anywhere in text.
+    bool test(StringView text) const;
+
+    // Finds the leftmost match that begins at or after from and stores its
+    // bounds, as byte offsets, in start and end.
+    bool find(StringView text, size_t& start, size_t& end, size_t from = 0) const;
+
+    // Same as find(), but also fills in the capture slots (see VM).
+    bool search(StringView text, Captures& captures, size_t from = 0) const;
+
+    // Successive matches in text (see Matches).
+    Matches findIter(StringView text) const;
+
+    // Limits every later search (see Budget). Without a step limit, the
+    // backtracker keeps its own default, so a budget of states, memory or
+    // time alone only adds limits.
+    void setBudget(const Budget& _budget);
+
+    const Program& getProgram() const { return *program; }
+
+private:
+    // The engines of one thread, over the shared program
+    struct Scratch
+    {
+        std::unique_ptr<VM> vm;
+        std::unique_ptr<Backtracker> backtracker;
+        std::unique_ptr<DFA> forward;
+        std::unique_ptr<DFA> backward;
+        // Capture slots for searches that only report bounds, kept so that
+        // they do not allocate
+        Captures slots;
+        // Value of Pattern::budgets when the budget was last set
+        size_t budgets = 0;
+    };
+
+    // Shared by the VMs or backtrackers, which do not copy it
+    std::shared_ptr<const Program> program;
+    std::unique_ptr<Prefilter> prefilter;
+    // The DFAs of every Scratch are copied from these, which never search,
+    // or are null if the program cannot run on a DFA
+    std::unique_ptr<const DFA> forward;
+    std::unique_ptr<const DFA> backward;
+    Budget budget;
+    // Number of calls to setBudget()
+    size_t budgets = 0;
+    mutable Pool<Scratch> pool;
+
+    Pattern(std::unique_ptr<AST> regex);
+    static std::unique_ptr<AST> parse(const String& pattern);
+    Pool<Scratch>::Guard scratch() const;
+    bool skip(StringView text, size_t& from) const;
+    bool find(Scratch& engines, StringView text, size_t& start, size_t& end, size_t from, bool continuing) const;
+    bool search(Scratch& engines, StringView text, Captures& captures, size_t from, bool continuing) const;
+    bool run(Scratch& engines, StringView text, Captures& captures, size_t from, bool anchored,
+        bool continuing) const;
+    template <typename Result>
+    static bool matched(Result result);
+};
+
+// Successive non-overlapping matches of a Pattern in a text, leftmost
+// first: each search starts where the previous match ended. An empty match
+// there is skipped, and the search goes on from the next character, so that
+// the iteration always moves forward.
+//
+// Nothing is allocated per match. Bounds are stored in the caller's
+// variables and capture slots in the caller's buffer, which keeps its
+// capacity from one match to the next, and the engines reuse their scratch.
+// A Matches holds the engines of its thread while it lives, so the lookaround
+// tables of its first search serve all later ones; other searches on that
+// thread meanwhile get engines of their own.
+//
+// The pattern and the text must outlive the iteration, and the text must not
+// change during it. Threads can each iterate over their own Matches of one
+// pattern at once.
+class Matches
+{
+public:
+    Matches(const Pattern& _pattern, StringView _text)
+        : pattern(_pattern), text(_text), engines(_pattern.scratch()) {}
+
+    // Finds the next match and stores its bounds in start and end. Returns
+    // false once there are no more.
+    bool next(size_t& start, size_t& end);
+
+    // Same as next(), but fills in the capture slots of the match.
+    bool next(Captures& captures);
+
+private:
+    const Pattern& pattern;
+    StringView text;
+    Pool<Pattern::Scratch>::Guard engines;
+    // Whether a search has run over text, so that the next one continues it
+    bool searched = false;
+    // Where the next search starts, or VM::npos once the text is done
+    size_t from = 0;
+    size_t lastEnd = VM::npos;
+
+    bool take(size_t start, size_t end);
+};
+
+#endif // !_PATTERN_HH_
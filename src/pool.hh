@@ -0,0 +1,97 @@
+#ifndef _POOL_HH_
+#define _POOL_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+// Scratch objects for an engine that many threads search with at once.
+//
+// Each thread has a slot of its own, picked by a number it is given the
+// first time it uses a pool. get() takes the object out of the slot and the
+// guard it returns puts it back, with one atomic exchange each, so a thread
+// never waits for another and, once its object exists, never allocates.
+// Slots are a cache line apart, so that threads do not share lines either.
+//
+// With more threads than slots, some threads share a slot: one that finds
+// it empty makes a new object, and one that finds it taken when it is done
+// drops its object.
+template <typename T>
+class Pool
+{
+public:
+    // Holds an object taken from the pool, and puts it back when destroyed.
+    class Guard
+    {
+    public:
+        Guard(Pool& _pool, size_t _slot, std::unique_ptr<T> _value)
+            : pool(&_pool), slot(_slot), value(std::move(_value)) {}
+        Guard(Guard&& other) = default;
+        ~Guard()
+        {
+            if (value)
+            {
+                pool->put(slot, std::move(value));
+            }
+        }
+
+        T& operator*() const { return *value; }
+        T* operator->() const { return value.get(); }
+
+    private:
+        Pool* pool;
+        size_t slot;
+        std::unique_ptr<T> value;
+    };
+
+    Pool() : count(std::max(1u, std::thread::hardware_concurrency())), slots(new Slot[count]) {}
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+    ~Pool()
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            delete slots[i].value.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Takes the calling thread's object, or makes one with create() if its
+    // slot is empty.
+    template <typename Create>
+    Guard get(Create create)
+    {
+        size_t slot = thread() % count;
+        T* value = slots[slot].value.exchange(nullptr, std::memory_order_acquire);
+        return Guard(*this, slot, value ? std::unique_ptr<T>(value) : create());
+    }
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<T*> value{ nullptr };
+    };
+
+    size_t count;
+    std::unique_ptr<Slot[]> slots;
+
+    void put(size_t slot, std::unique_ptr<T> value)
+    {
+        T* empty = nullptr;
+        if (slots[slot].value.compare_exchange_strong(empty, value.get(), std::memory_order_release,
+            std::memory_order_relaxed))
+        {
+            value.release();
+        }
+    }
+
+    // Numbers the threads in the order they first use a pool
+    static size_t thread()
+    {
+        static std::atomic<size_t> threads{ 0 };
+        thread_local size_t index = threads.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+};
+
+#endif // !_POOL_HH_
@@ -0,0 +1,548 @@
+#include "prefilter.hh"
+#include "simd.hh"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+    using Set = std::optional<std::set<std::string>>;
+
+    // Larger sets cost more to search for than they save.
+    constexpr size_t maxLiterals = 16;
+
+    // Length of the shortest string, or -1 if nothing is known.
+    long score(const Set& set)
+    {
+        if (!set || set->empty())
+        {
+            return -1;
+        }
+        size_t shortest = SIZE_MAX;
+        for (const std::string& s : *set)
+        {
+            shortest = std::min(shortest, s.size());
+        }
+        return static_cast<long>(shortest);
+    }
+
+    // Returns whichever set is cheaper to search for and rejects more text.
+    const Set& best(const Set& a, const Set& b)
+    {
+        long x = score(a), y = score(b);
+        if (x != y)
+        {
+            return x > y ? a : b;
+        }
+        return x >= 0 && b->size() < a->size() ? b : a;
+    }
+
+    Set cross(const Set& a, const Set& b)
+    {
+        if (!a || !b || a->size() * b->size() > maxLiterals)
+        {
+            return std::nullopt;
+        }
+        std::set<std::string> result;
+        for (const std::string& x : *a)
+        {
+            for (const std::string& y : *b)
+            {
+                result.insert(x + y);
+            }
+        }
+        return result;
+    }
+
+    Set unite(const Set& a, const Set& b)
+    {
+        if (!a || !b)
+        {
+            return std::nullopt;
+        }
+        std::set<std::string> result = *a;
+        result.insert(b->begin(), b->end());
+        if (result.size() > maxLiterals)
+        {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    // A code point only ever matches its own UTF-8 form, but surrogates have
+    // none.
+    bool searchable(int codepoint)
+    {
+        return codepoint < 0xD800 || codepoint > 0xDFFF;
+    }
+}
+
+Prefilter::Info Prefilter::concatenate(const Info& left, const Info& right)
+{
+    Info result;
+    result.exact = cross(left.exact, right.exact);
+
+    result.prefixes = left.prefixes;
+    if (left.exact)
+    {
+        if (Set longer = cross(left.exact, right.prefixes))
+        {
+            result.prefixes = longer;
+        }
+    }
+    result.suffixes = right.suffixes;
+    if (right.exact)
+    {
+        if (Set longer = cross(left.suffixes, right.exact))
+        {
+            result.suffixes = longer;
+        }
+    }
+
+    // 跨越两个因子边界的字面量，如 "a+bc" 中的 "abc"
+    result.inner = best(left.inner, right.inner);
+    result.inner = best(result.inner, cross(left.suffixes, right.prefixes));
+    result.inner = best(result.inner, best(result.prefixes, result.suffixes));
+    result.inner = best(result.inner, result.exact);
+    return result;
+}
+
+Prefilter::Info Prefilter::alternate(const Info& left, const Info& right)
+{
+    return {
+        unite(left.exact, right.exact),
+        unite(left.prefixes, right.prefixes),
+        unite(left.suffixes, right.suffixes),
+        unite(left.inner, right.inner),
+    };
+}
+
+Prefilter::Info Prefilter::analyzeQuantified(const AST* atom, const Quantifier* quantifier)
+{
+    Info info = analyze(atom);
+    if (!quantifier || quantifier->type == Quantifier::Type::Once)
+    {
+        return info;
+    }
+
+    int min = quantifier->values.first;
+    int max = quantifier->values.second;
+    Set empty = std::set<std::string>{ "" };
+    if (max == 0)
+    {
+        return { empty, empty, empty, empty };
+    }
+    if (min == 0)
+    {
+        // "colou?r"
+        Set exact = max == 1 ? unite(info.exact, empty) : std::nullopt;
+        return { exact, exact, exact, exact };
+    }
+
+    // Every match begins and ends with min copies of the atom
+    Set power = info.exact;
+    for (int i = 1; i < min && power; ++i)
+    {
+        power = cross(power, info.exact);
+    }
+    Info result;
+    result.exact = min == max ? power : std::nullopt;
+    result.prefixes = power ? power : info.prefixes;
+    result.suffixes = power ? power : info.suffixes;
+    result.inner = best(info.inner, power);
+    return result;
+}
+
+Prefilter::Info Prefilter::analyze(const AST* node)
+{
+    Set empty = std::set<std::string>{ "" };
+    if (auto regex = dynamic_cast<const Regex*>(node))
+    {
+        return analyze(regex->expression.get());
+    }
+    else if (auto expression = dynamic_cast<const Expression*>(node))
+    {
+        Info result = analyze(expression->terms.front().get());
+        for (size_t i = 1; i < expression->terms.size(); ++i)
+        {
+            result = alternate(result, analyze(expression->terms[i].get()));
+        }
+        return result;
+    }
+    else if (auto term = dynamic_cast<const Term*>(node))
+    {
+        Info result = { empty, empty, empty, empty };
+        for (auto& factor : term->factors)
+        {
+            result = concatenate(result, analyze(factor.get()));
+        }
+        return result;
+    }
+    else if (auto factor = dynamic_cast<const Factor*>(node))
+    {
+        if (factor->type == Factor::Type::Assertion)
+        {
+            return analyze(factor->assertion.get());
+        }
+        return analyzeQuantified(factor->atom_quantifier.first.get(),
+            dynamic_cast<const Quantifier*>(factor->atom_quantifier.second.get()));
+    }
+    else if (auto atom = dynamic_cast<const Atom*>(node))
+    {
+        return analyze(atom->atom.get());
+    }
+    else if (auto literal = dynamic_cast<const Literal*>(node))
+    {
+        if (literal->value.empty())
+        {
+            return { empty, empty, empty, empty };
+        }
+        if (searchable(literal->value.toCodepoint()))
+        {
+            Set exact = std::set<std::string>{ literal->value.toUTF8() };
+            return { exact, exact, exact, exact };
+        }
+    }
+    else if (auto characterClass = dynamic_cast<const CharacterClass*>(node))
+    {
+        // A small class such as [aA] is a set of one-character strings
+        std::set<std::string> exact;
+        bool small = !characterClass->isNegative && characterClass->classes.empty();
+        for (const auto& range : characterClass->ranges)
+        {
+            for (int c = range.first.toCodepoint(); small && c <= range.second.toCodepoint(); ++c)
+            {
+                small = searchable(c) && exact.size() < maxLiterals;
+                exact.insert(Char(c).toUTF8());
+            }
+        }
+        for (const Char& ch : characterClass->chars)
+        {
+            small = small && searchable(ch.toCodepoint()) && exact.size() < maxLiterals;
+            exact.insert(ch.toUTF8());
+        }
+        if (small && !exact.empty())
+        {
+            return { exact, exact, exact, exact };
+        }
+    }
+    else if (auto group = dynamic_cast<const CapturingGroup*>(node))
+    {
+        return analyze(group->expression.get());
+    }
+    else if (auto group = dynamic_cast<const NamedCapturingGroup*>(node))
+    {
+        return analyze(group->expression.get());
+    }
+    else if (auto group = dynamic_cast<const NonCapturingGroup*>(node))
+    {
+        return analyze(group->expression.get());
+    }
+    else if (auto group = dynamic_cast<const AtomicGroup*>(node))
+    {
+        // Matches part of what its body matches, which needs the same literals
+        return analyze(group->expression.get());
+    }
+    else if (dynamic_cast<const LookaheadAssertion*>(node) || dynamic_cast<const LookbehindAssertion*>(node)
+        || dynamic_cast<const Anchor*>(node))
+    {
+        // Consumes nothing
+        return { empty, empty, empty, empty };
+    }
+    // Anything else, e.g. '.' or a backreference, could match any text
+    return {};
+}
+
+std::unique_ptr<Prefilter> Prefilter::build(const AST& regex)
+{
+    Info info = analyze(&regex);
+    bool prefix = &best(info.prefixes, info.inner) == &info.prefixes;
+    const Set& chosen = prefix ? info.prefixes : info.inner;
+    if (score(chosen) < 1)
+    {
+        return nullptr;
+    }
+    return std::unique_ptr<Prefilter>(new Prefilter({ chosen->begin(), chosen->end() }, prefix));
+}
+
+Prefilter::Prefilter(std::vector<std::string> _literals, bool _prefix)
+    : literals(std::move(_literals)), prefix(_prefix), low(), high()
+{
+    fingerprint = literals.front().size();
+    for (size_t i = 0; i < literals.size(); ++i)
+    {
+        fingerprint = std::min<size_t>({ fingerprint, literals[i].size(), 2 });
+        buckets[i % 8].push_back(i);
+    }
+    for (size_t i = 0; i < literals.size(); ++i)
+    {
+        for (size_t k = 0; k < fingerprint; ++k)
+        {
+            unsigned char b = static_cast<unsigned char>(literals[i][k]);
+            low[k][b & 0x0F] |= 1 << (i % 8);
+            high[k][b >> 4] |= 1 << (i % 8);
+        }
+    }
+}
+
+namespace
+{
+    inline unsigned char at(const char* s, size_t i)
+    {
+        return static_cast<unsigned char>(s[i]);
+    }
+
+    // Finds needle (at least two bytes long) in s[from, n) by testing the
+    // first and last bytes of many positions at once and comparing the middle
+    // of the candidates. Stops where fewer than a vector of positions is
+    // left and stores that position in next.
+#ifdef SWEETIE_X86
+    SWEETIE_TARGET("avx2")
+    size_t findAVX2(const char* s, size_t n, size_t from, const std::string& needle, size_t& next)
+    {
+        size_t m = needle.size();
+        const __m256i first = _mm256_set1_epi8(needle.front());
+        const __m256i last = _mm256_set1_epi8(needle.back());
+        size_t i = from;
+        for (; i + m - 1 + 32 <= n; i += 32)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + m - 1));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+            while (mask)
+            {
+                size_t j = i + SWEETIE_CTZ(mask);
+                if (std::memcmp(s + j + 1, needle.data() + 1, m - 2) == 0)
+                {
+                    return j;
+                }
+                mask &= mask - 1;
+            }
+        }
+        next = i;
+        return VM::npos;
+    }
+
+    SWEETIE_TARGET("sse4.2")
+    size_t findSSE42(const char* s, size_t n, size_t from, const std::string& needle, size_t& next)
+    {
+        size_t m = needle.size();
+        const __m128i first = _mm_set1_epi8(needle.front());
+        const __m128i last = _mm_set1_epi8(needle.back());
+        size_t i = from;
+        for (; i + m - 1 + 16 <= n; i += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+            while (mask)
+            {
+                size_t j = i + SWEETIE_CTZ(mask);
+                if (std::memcmp(s + j + 1, needle.data() + 1, m - 2) == 0)
+                {
+                    return j;
+                }
+                mask &= mask - 1;
+            }
+        }
+        next = i;
+        return VM::npos;
+    }
+
+    // Returns the first position in s[from, n) whose fingerprint falls into
+    // some bucket, and the buckets in mask. Stops like findAVX2().
+    SWEETIE_TARGET("avx2")
+    size_t teddyAVX2(const char* s, size_t n, size_t from, size_t fingerprint,
+        const uint8_t (&low)[2][16], const uint8_t (&high)[2][16], unsigned& buckets, size_t& next)
+    {
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        __m256i lowTable[2], highTable[2];
+        for (size_t k = 0; k < fingerprint; ++k)
+        {
+            lowTable[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(low[k])));
+            highTable[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(high[k])));
+        }
+        size_t i = from;
+        for (; i + fingerprint - 1 + 32 <= n; i += 32)
+        {
+            __m256i result = _mm256_set1_epi8(-1);
+            for (size_t k = 0; k < fingerprint; ++k)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + k));
+                __m256i lo = _mm256_shuffle_epi8(lowTable[k], _mm256_and_si256(v, nibble));
+                __m256i hi = _mm256_shuffle_epi8(highTable[k], _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+                result = _mm256_and_si256(result, _mm256_and_si256(lo, hi));
+            }
+            uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(result, _mm256_setzero_si256())));
+            if (mask)
+            {
+                alignas(32) uint8_t bytes[32];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(bytes), result);
+                size_t j = SWEETIE_CTZ(mask);
+                buckets = bytes[j];
+                return i + j;
+            }
+        }
+        next = i;
+        return VM::npos;
+    }
+
+    SWEETIE_TARGET("sse4.2")
+    size_t teddySSE42(const char* s, size_t n, size_t from, size_t fingerprint,
+        const uint8_t (&low)[2][16], const uint8_t (&high)[2][16], unsigned& buckets, size_t& next)
+    {
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        __m128i lowTable[2], highTable[2];
+        for (size_t k = 0; k < fingerprint; ++k)
+        {
+            lowTable[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low[k]));
+            highTable[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high[k]));
+        }
+        size_t i = from;
+        for (; i + fingerprint - 1 + 16 <= n; i += 16)
+        {
+            __m128i result = _mm_set1_epi8(-1);
+            for (size_t k = 0; k < fingerprint; ++k)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + k));
+                __m128i lo = _mm_shuffle_epi8(lowTable[k], _mm_and_si128(v, nibble));
+                __m128i hi = _mm_shuffle_epi8(highTable[k], _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+                result = _mm_and_si128(result, _mm_and_si128(lo, hi));
+            }
+            uint32_t mask = 0xFFFF & ~static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(result, _mm_setzero_si128())));
+            if (mask)
+            {
+                alignas(16) uint8_t bytes[16];
+                _mm_store_si128(reinterpret_cast<__m128i*>(bytes), result);
+                size_t j = SWEETIE_CTZ(mask);
+                buckets = bytes[j];
+                return i + j;
+            }
+        }
+        next = i;
+        return VM::npos;
+    }
+#endif
+}
+
+size_t Prefilter::find(StringView text, size_t from) const
+{
+    return literals.size() == 1 ? findOne(text, from) : findMany(text, from);
+}
+
+size_t Prefilter::findOne(StringView text, size_t from) const
+{
+    const std::string& needle = literals.front();
+    const char* s = text.data();
+    size_t n = text.size();
+    size_t m = needle.size();
+    if (from > n || m > n - from)
+    {
+        return VM::npos;
+    }
+
+    size_t i = from;
+#ifdef SWEETIE_X86
+    if (m >= 2)
+    {
+        size_t found = VM::npos;
+        switch (SIMD::level())
+        {
+        case SIMD::Level::AVX2:
+            found = findAVX2(s, n, from, needle, i);
+            break;
+        case SIMD::Level::SSE42:
+            found = findSSE42(s, n, from, needle, i);
+            break;
+        default:
+            break;
+        }
+        if (found != VM::npos)
+        {
+            return found;
+        }
+    }
+#endif
+
+    // memchr 本身已经向量化
+    while (i + m <= n)
+    {
+        const void* p = std::memchr(s + i, needle.front(), n - m + 1 - i);
+        if (!p)
+        {
+            break;
+        }
+        i = static_cast<const char*>(p) - s;
+        if (std::memcmp(s + i + 1, needle.data() + 1, m - 1) == 0)
+        {
+            return i;
+        }
+        i++;
+    }
+    return VM::npos;
+}
+
+// Returns position if one of the literals in the given buckets occurs there.
+size_t Prefilter::verify(StringView text, size_t position, unsigned mask) const
+{
+    for (; mask; mask &= mask - 1)
+    {
+        for (size_t i : buckets[SWEETIE_CTZ(mask)])
+        {
+            const std::string& literal = literals[i];
+            if (literal.size() <= text.size() - position
+                && std::memcmp(text.data() + position, literal.data(), literal.size()) == 0)
+            {
+                return position;
+            }
+        }
+    }
+    return VM::npos;
+}
+
+size_t Prefilter::findMany(StringView text, size_t from) const
+{
+    const char* s = text.data();
+    size_t n = text.size();
+    size_t i = from;
+#ifdef SWEETIE_X86
+    SIMD::Level level = SIMD::level();
+    while (level != SIMD::Level::Scalar)
+    {
+        unsigned mask = 0;
+        size_t next = i;
+        size_t candidate = level == SIMD::Level::AVX2
+            ? teddyAVX2(s, n, i, fingerprint, low, high, mask, next)
+            : teddySSE42(s, n, i, fingerprint, low, high, mask, next);
+        if (candidate == VM::npos)
+        {
+            i = next;
+            break;
+        }
+        if (verify(text, candidate, mask) != VM::npos)
+        {
+            return candidate;
+        }
+        i = candidate + 1;
+    }
+#endif
+
+    for (; i + fingerprint <= n; ++i)
+    {
+        unsigned mask = 0xFF;
+        for (size_t k = 0; k < fingerprint; ++k)
+        {
+            unsigned char b = at(s, i + k);
+            mask &= low[k][b & 0x0F] & high[k][b >> 4];
+        }
+        if (mask && verify(text, i, mask) != VM::npos)
+        {
+            return i;
+        }
+    }
+    return VM::npos;
+}
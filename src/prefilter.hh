@@ -0,0 +1,81 @@
+#ifndef _PREFILTER_HH_
+#define _PREFILTER_HH_
+
+#include <optional>
+#include "vm.hh"
+
+// Literal prefilter.
+//
+// Most texts that a pattern is run over do not match it at all, and most
+// patterns contain some literal text. The prefilter finds literals that
+// every match must contain, so that a search can reject a text, or skip to
+// where a match may begin, with a plain substring search and without running
+// an engine.
+//
+// The literals come from an analysis of the AST. Each node yields the set of
+// strings it matches, if that set is small, and otherwise sets such that
+// every match begins with, ends with or contains one of their strings. A
+// term concatenates the sets of its factors, an alternation takes the union
+// of those of its terms, and of the sets found the one with the longest
+// shortest string is kept.
+//
+// A single literal is searched for with memchr, or by comparing its first and
+// last bytes with 32 (AVX2) or 16 (SSE4.2) positions at once. Several
+// literals are searched for with a small Teddy: the first one or two bytes of
+// every position are looked up in nibble tables that map them to buckets of
+// literals. Candidates are then verified.
+class Prefilter
+{
+public:
+    // Returns the prefilter of a pattern, or nullptr if no literal is
+    // required of a match.
+    static std::unique_ptr<Prefilter> build(const AST& regex);
+
+    // Returns the offset of the first occurrence of any of the literals at or
+    // after from, or VM::npos.
+    size_t find(StringView text, size_t from) const;
+
+    // Whether every match begins with one of the literals, in which case no
+    // match begins before the offset find() returns.
+    bool isPrefix() const { return prefix; }
+
+    const std::vector<std::string>& getLiterals() const { return literals; }
+
+private:
+    using Set = std::optional<std::set<std::string>>;
+
+    // What is known of the strings a node matches. An empty optional means
+    // nothing is known.
+    struct Info
+    {
+        // All of the strings the node matches.
+        Set exact;
+        // Every match begins with, ends with or contains one of these.
+        Set prefixes;
+        Set suffixes;
+        Set inner;
+    };
+
+    std::vector<std::string> literals;
+    bool prefix;
+
+    // Teddy tables: bit k of low[i][n] and high[i][n] is set if a literal of
+    // bucket k has n as the low or high nibble of its byte i.
+    size_t fingerprint;
+    uint8_t low[2][16];
+    uint8_t high[2][16];
+    std::vector<size_t> buckets[8];
+
+    Prefilter(std::vector<std::string> _literals, bool _prefix);
+
+    static Info analyze(const AST* node);
+    static Info analyzeQuantified(const AST* atom, const Quantifier* quantifier);
+    static Info concatenate(const Info& left, const Info& right);
+    static Info alternate(const Info& left, const Info& right);
+
+    size_t findOne(StringView text, size_t from) const;
+    size_t findMany(StringView text, size_t from) const;
+    size_t verify(StringView text, size_t position, unsigned mask) const;
+};
+
+#endif // !_PREFILTER_HH_
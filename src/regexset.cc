@@ -0,0 +1,101 @@
+#include "regexset.hh"
+#include "compiler.hh"
+#include <stdexcept>
+
+static Program compileSet(const std::vector<String>& patterns)
+{
+    std::vector<std::unique_ptr<AST>> regexes;
+    std::vector<const AST*> nodes;
+    for (const String& pattern : patterns)
+    {
+        Lexer lexer(pattern);
+        Parser parser(lexer.tokenize());
+        regexes.push_back(parser.parse());
+        nodes.push_back(regexes.back().get());
+    }
+    return Compiler().compileSet(nodes);
+}
+
+RegexSet::RegexSet(const std::vector<String>& patterns)
+    : count(patterns.size()), program(std::make_shared<const Program>(compileSet(patterns)))
+{
+    if (program->hasBackreferences || program->atomicGroups)
+    {
+        throw std::runtime_error("Backreferences and atomic groups are not supported in a RegexSet");
+    }
+    if (!count)
+    {
+        return;
+    }
+    if (DFA::supports(*program))
+    {
+        dfa = std::make_unique<const DFA>(*program, false, DFA::defaultCacheSize, true);
+    }
+}
+
+std::vector<size_t> RegexSet::matches(StringView text) const
+{
+    std::vector<uint8_t> matched;
+    matches(text, matched);
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (matched[i])
+        {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+void RegexSet::matches(StringView text, std::vector<uint8_t>& matched) const
+{
+    matched.assign(count, 0);
+    if (!count)
+    {
+        return;
+    }
+    Pool<Scratch>::Guard engines = pool.get([this]
+    {
+        auto made = std::make_unique<Scratch>();
+        made->vm = std::make_unique<VM>(program);
+        if (dfa)
+        {
+            made->dfa = std::make_unique<DFA>(*dfa);
+        }
+        return made;
+    });
+    if (engines->budgets != budgets)
+    {
+        engines->vm->setBudget(budget);
+        if (engines->dfa)
+        {
+            engines->dfa->setBudget(budget);
+        }
+        engines->budgets = budgets;
+    }
+
+    if (engines->dfa)
+    {
+        DFA::Result result = engines->dfa->scanAccepts(text, matched);
+        if (result == DFA::Result::BudgetExceeded)
+        {
+            throw BudgetExceeded();
+        }
+        if (result != DFA::Result::GaveUp)
+        {
+            return;
+        }
+    }
+    // 放弃前 DFA 已确认的模式仍然算数
+    if (!engines->vm->scanAccepts(text, matched))
+    {
+        throw BudgetExceeded();
+    }
+}
+
+void RegexSet::setBudget(const Budget& _budget)
+{
+    budget = _budget;
+    budgets++;
+}
@@ -0,0 +1,60 @@
+#ifndef _REGEXSET_HH_
+#define _REGEXSET_HH_
+
+#include "dfa.hh"
+#include "pool.hh"
+
+// Many patterns matched together.
+//
+// The patterns are compiled into one program, their union, in which each
+// one ends with its own Accept (see Compiler::compileSet()). Telling which
+// of them match a text is then one scan of an overlapping lazy DFA, however
+// many patterns there are, rather than one search per pattern. If the DFA
+// gives up, or cannot run the program because of lookarounds, the Pike VM
+// makes the scan instead, still in one pass.
+//
+// Only which patterns match is reported; where, and with what captures, is
+// left to a Pattern. Backreferences and atomic groups that can backtrack
+// have no linear-time union and are rejected with std::runtime_error.
+//
+// As with Pattern, any number of threads can scan with one set at once,
+// each on engines of its own from a Pool.
+class RegexSet
+{
+public:
+    RegexSet(const std::vector<String>& patterns);
+
+    size_t size() const { return count; }
+
+    // Indices of the patterns that match somewhere in text, in increasing
+    // order.
+    std::vector<size_t> matches(StringView text) const;
+
+    // Sets matched[i], for each of the size() patterns, to whether pattern
+    // i matches somewhere in text.
+    void matches(StringView text, std::vector<uint8_t>& matched) const;
+
+    // Limits every later scan (see Budget). A scan that runs out of it
+    // throws BudgetExceeded. Must not run during a scan.
+    void setBudget(const Budget& _budget);
+
+private:
+    // The engines of one thread
+    struct Scratch
+    {
+        std::unique_ptr<DFA> dfa;
+        std::unique_ptr<VM> vm;
+        // Value of RegexSet::budgets when the budget was last set
+        size_t budgets = 0;
+    };
+
+    size_t count;
+    std::shared_ptr<const Program> program;
+    // The DFA of every Scratch is copied from this one, which never scans
+    std::unique_ptr<const DFA> dfa;
+    Budget budget;
+    size_t budgets = 0;
+    mutable Pool<Scratch> pool;
+};
+
+#endif // !_REGEXSET_HH_
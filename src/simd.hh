@@ -0,0 +1,65 @@
+#ifndef _SIMD_HH_
+#define _SIMD_HH_
+
+// Runtime selection of vector instruction sets, shared by the bulk routines
+// (UTF8, Prefilter). Code for a wider set is compiled with SWEETIE_TARGET and
+// only called once level() has reported that the CPU supports it.
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SWEETIE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SWEETIE_TARGET(x) __attribute__((target(x)))
+#define SWEETIE_CTZ(x) __builtin_ctz(x)
+#else
+#define SWEETIE_TARGET(x)
+#define SWEETIE_CTZ(x) _tzcnt_u32(x)
+#endif
+
+#ifdef SWEETIE_X86
+
+namespace SIMD {
+
+    enum class Level { Scalar, SSE42, AVX2 };
+
+    inline Level detect() {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+        if (__builtin_cpu_supports("sse4.2")) return Level::SSE42;
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        int ids = info[0];
+        bool sse42 = false, avx2 = false;
+        if (ids >= 1) {
+            __cpuid(info, 1);
+            sse42 = (info[2] & (1 << 20)) != 0;
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            if (osxsave && ids >= 7 && (_xgetbv(0) & 6) == 6) {
+                __cpuidex(info, 7, 0);
+                avx2 = (info[1] & (1 << 5)) != 0;
+            }
+        }
+        if (avx2) return Level::AVX2;
+        if (sse42) return Level::SSE42;
+#endif
+        return Level::Scalar;
+    }
+
+    // The widest level the running CPU supports, detected once.
+    inline Level level() {
+        static const Level detected = detect();
+        return detected;
+    }
+
+};
+
+#endif
+
+#endif // !_SIMD_HH_
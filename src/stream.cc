@@ -0,0 +1,205 @@
+#include "stream.hh"
+#include "compiler.hh"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+Stream::Stream(const String& pattern) : Stream(std::make_shared<const Program>(Compiler::compile(pattern)))
+{
+}
+
+Stream::Stream(std::shared_ptr<const Program> _program) : vm(std::move(_program))
+{
+    if (!vm.program->lookarounds.empty())
+    {
+        throw std::runtime_error("Lookarounds are not supported on streams");
+    }
+    reset();
+}
+
+void Stream::reset()
+{
+    window.clear();
+    windowStart = 0;
+    cursor = 0;
+    matched = false;
+    lastEnd = VM::npos;
+
+    // 只记录整个匹配的起止
+    vm.end = VM::npos;
+    vm.slotCount = 2;
+    vm.current.reset(vm.pcOf.size(), vm.slotCount);
+    vm.next.reset(vm.pcOf.size(), vm.slotCount);
+    vm.scratch.resize(vm.slotCount);
+}
+
+void Stream::feed(StringView chunk, std::vector<Match>& matches)
+{
+    window.append(chunk.data(), chunk.size());
+    vm.meter.start(vm.budget);
+    run(false, matches);
+
+    // 之后不会再读的字节
+    size_t keep = matched ? matchEnd : cursor;
+    window.erase(0, keep - windowStart);
+    windowStart = keep;
+}
+
+void Stream::finish(std::vector<Match>& matches)
+{
+    vm.end = offset();
+    vm.meter.start(vm.budget);
+    resume();
+    run(true, matches);
+    reset();
+}
+
+// Whether the n bytes at s, fewer than their lead byte announces, are all
+// continuation bytes, so that the next chunk may complete the character.
+static bool isUnfinished(const char* s, size_t n)
+{
+    unsigned char lead = static_cast<unsigned char>(s[0]);
+    size_t length = (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3 : (lead & 0xF8) == 0xF0 ? 4 : 1;
+    if (length <= n)
+    {
+        return false;
+    }
+    for (size_t k = 1; k < n; ++k)
+    {
+        if ((static_cast<unsigned char>(s[k]) & 0xC0) != 0x80)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reads the window from the cursor. Unless the text has ended, stops before
+// a character that is not complete yet.
+void Stream::run(bool final, std::vector<Match>& matches)
+{
+    while (true)
+    {
+        size_t i = cursor - windowStart;
+        size_t left = window.size() - i;
+        if (!final && (left == 0 || (left < 4 && isUnfinished(window.data() + i, left))))
+        {
+            break;
+        }
+
+        // 无效的 UTF-8 字节不是字符，任何类都不匹配它
+        size_t length;
+        char32_t c = StringView(window.data() + i, left).decode(0, length);
+        Char ch = length > 1 || c < 0x80 ? Char(static_cast<int>(c)) : Char();
+        if (!step(length, ch, matches) && length == 0)
+        {
+            break;
+        }
+    }
+}
+
+// Moves the threads over the character of length bytes at the cursor, or
+// past the end of the text if length is 0. Returns true if a match became
+// final, in which case the cursor goes back to where the next search starts.
+bool Stream::step(size_t length, Char c, std::vector<Match>& matches)
+{
+    size_t position = cursor;
+    const char* bytes = window.data() + (position - windowStart);
+    if (!matched)
+    {
+        std::fill(vm.scratch.begin(), vm.scratch.end(), VM::npos);
+        vm.addThread(vm.current, 0, position, vm.scratch.data());
+    }
+    if (!vm.meter.tick(vm.current.size) && !vm.meter.check(vm.footprint() + window.size()))
+    {
+        reset();
+        throw BudgetExceeded();
+    }
+
+    const Program& program = *vm.program;
+    vm.next.size = 0;
+    for (size_t i = 0; i < vm.current.size; ++i)
+    {
+        size_t state = vm.current.dense[i];
+        size_t pc = vm.pcOf[state];
+        const Instruction& instruction = program[pc];
+        const size_t* slots = vm.current.slots.data() + state * vm.slotCount;
+
+        if (instruction.code == ByteCode::Match)
+        {
+            if (length && program.matcher(instruction).match(c))
+            {
+                vm.addThread(vm.next, pc + 1, position + length, slots, state - vm.base[pc]);
+            }
+        }
+        else if (instruction.code == ByteCode::String)
+        {
+            size_t k;
+            size_t offset = vm.offsetOf(state, pc, k);
+            std::string_view literal = program.literal(instruction);
+            if (length && k + length <= literal.size() && std::memcmp(bytes, literal.data() + k, length) == 0)
+            {
+                if (k + length == literal.size())
+                {
+                    vm.addThread(vm.next, pc + 1, position + length, slots, offset);
+                }
+                else if (!vm.next.contains(state + length))
+                {
+                    vm.next.insert(state + length);
+                    std::copy(slots, slots + vm.slotCount, vm.next.slots.data() + (state + length) * vm.slotCount);
+                }
+            }
+        }
+        else if (instruction.code == ByteCode::Accept)
+        {
+            matched = true;
+            matchStart = slots[0];
+            matchEnd = slots[1];
+            // 优先级更低的线程不再需要
+            break;
+        }
+    }
+    std::swap(vm.current, vm.next);
+
+    if (matched && vm.current.size == 0)
+    {
+        matched = false;
+        if (matchStart == matchEnd && matchEnd == lastEnd)
+        {
+            // 紧接上一个匹配的空匹配不算，从下一个字符起重新搜索
+            size_t skipped;
+            StringView(window).decode(matchEnd - windowStart, skipped);
+            cursor = matchEnd + skipped;
+            return skipped != 0;
+        }
+        matches.push_back({ matchStart, matchEnd });
+        lastEnd = matchEnd;
+        cursor = matchEnd;
+        return true;
+    }
+    cursor = position + length;
+    return false;
+}
+
+// Lets the threads that wait at a $ go on, now that the end is known.
+void Stream::resume()
+{
+    vm.next.size = 0;
+    for (size_t i = 0; i < vm.current.size; ++i)
+    {
+        size_t state = vm.current.dense[i];
+        size_t pc = vm.pcOf[state];
+        const size_t* slots = vm.current.slots.data() + state * vm.slotCount;
+        if ((*vm.program)[pc].code == ByteCode::Anchor)
+        {
+            size_t k;
+            vm.addThread(vm.next, pc, cursor, slots, vm.offsetOf(state, pc, k));
+        }
+        else if (!vm.next.contains(state))
+        {
+            vm.next.insert(state);
+            std::copy(slots, slots + vm.slotCount, vm.next.slots.data() + state * vm.slotCount);
+        }
+    }
+    std::swap(vm.current, vm.next);
+}
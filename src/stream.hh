@@ -0,0 +1,73 @@
+#ifndef _STREAM_HH_
+#define _STREAM_HH_
+
+#include "vm.hh"
+
+// Searches a text that arrives in chunks, without holding all of it.
+//
+// The threads of a Pike VM (see VM) are kept between chunks, with the
+// start and end of the match they would make as byte offsets from the
+// beginning of the stream. Chunks may split a UTF-8 sequence anywhere: the
+// bytes of an unfinished character wait for the next chunk.
+//
+// Matches are the ones Pattern::find() would return one after another, and
+// are reported as soon as they are final: once a match has been seen, only
+// threads of higher priority can replace it, and it is reported when the
+// last of them dies. The bytes read after the end of such a match are kept
+// until then, since the next search starts there, so a pattern that keeps
+// a long match open, like a(.*z)?, holds that much text. Other bytes are
+// dropped once read.
+//
+// An empty match where the previous match ended is skipped, and the search
+// goes on from the next character, as with Pattern::findIter(). $ only holds
+// at the end given by finish(). Lookarounds need the whole text and are not
+// supported, nor are backreferences and atomic groups.
+class Stream
+{
+public:
+    struct Match
+    {
+        size_t start;
+        size_t end;
+    };
+
+    Stream(const String& pattern);
+    Stream(std::shared_ptr<const Program> _program);
+
+    // Reads the next chunk and appends the matches that became final to
+    // matches. If the budget, which applies to each call, runs out, the
+    // stream starts over and BudgetExceeded is thrown.
+    void feed(StringView chunk, std::vector<Match>& matches);
+
+    // Ends the text and appends the remaining matches. The stream then
+    // starts over, at offset 0.
+    void finish(std::vector<Match>& matches);
+
+    // Number of bytes fed so far.
+    size_t offset() const { return windowStart + window.size(); }
+
+    void setBudget(const Budget& budget) { vm.setBudget(budget); }
+
+private:
+    VM vm;
+
+    // Bytes from windowStart on that may still be read, or read again, the
+    // unread ones from cursor
+    std::string window;
+    size_t windowStart;
+    size_t cursor;
+
+    // The match found so far, which threads of higher priority may still
+    // replace
+    bool matched;
+    size_t matchStart;
+    size_t matchEnd;
+    size_t lastEnd;
+
+    void reset();
+    void run(bool final, std::vector<Match>& matches);
+    bool step(size_t length, Char c, std::vector<Match>& matches);
+    void resume();
+};
+
+#endif // !_STREAM_HH_
@@ -1,198 +1,96 @@
 #include "string.hh"
+#include "utf8.hh"
+#include <algorithm>
 
-Char::Char() : data(), size(0) {}
+Char::Char() : codepoint(none) {}
 
-Char::Char(const std::string& utf8) : data(utf8), size(utf8.size()) {}
+Char::Char(const std::string& utf8) : codepoint(none) {
+    decodeUTF8(utf8.data(), utf8.size(), codepoint);
+}
 
-Char::Char(char c) : data(1, c), size(1) {}
+Char::Char(char c) : codepoint(static_cast<unsigned char>(c)) {}
 
 Char::Char(int c) {
-    data = fromCodepoint(c).toUTF8();
-    size = data.size();
+    if (c < 0 || c > 0x10FFFF) {
+        throw std::invalid_argument("Invalid Unicode code point");
+    }
+    codepoint = static_cast<char32_t>(c);
 }
 
-Char::Char(const char* cstr) : data(cstr ? cstr : ""), size(cstr ? std::strlen(cstr) : 0) {}
-
-Char& Char::operator=(const char* cstr) {
+Char::Char(const char* cstr) : codepoint(none) {
     if (cstr) {
-        data = std::string(cstr);
-        size = data.size();
+        decodeUTF8(cstr, std::char_traits<char>::length(cstr), codepoint);
     }
-    else {
-        data.clear();
-        size = 0;
-    }
-    return *this;
 }
 
-Char& Char::operator=(char c) {
-    data = std::string(1, c);
-    size = 1;
+Char& Char::operator=(const char* cstr) {
+    *this = Char(cstr);
     return *this;
 }
 
-bool Char::isASCII() const {
-    return size == 1 && data[0] < 0x80;
+Char& Char::operator=(char c) {
+    codepoint = static_cast<unsigned char>(c);
+    return *this;
 }
 
 char Char::toStdChar() const {
-    return data[0];
+    return isASCII() ? static_cast<char>(codepoint) : '\0';
 }
 
 bool Char::isStdDigit() const {
-    return std::isdigit(data[0]);
+    return codepoint >= '0' && codepoint <= '9';
 }
 
 bool Char::isStdAlpha() const {
-    return std::isalpha(data[0]);
+    return (codepoint | 0x20) >= 'a' && (codepoint | 0x20) <= 'z';
 }
 
 bool Char::isStdAlnum() const {
-    return std::isalnum(data[0]);
+    return isStdDigit() || isStdAlpha();
 }
 
 bool Char::isSingle() const {
-    return size == 1;
+    return isASCII();
 }
 
 std::string Char::toUTF8() const {
-    return data;
-}
-
-bool Char::operator==(const Char& other) const {
-    return data == other.data;
-}
-
-bool Char::operator!=(const Char& other) const {
-    return data != other.data;
-}
-
-
-bool Char::operator<(const Char& other) const
-{
-    std::string s1 = data;
-    std::string s2 = other.data;
-    if (s1.length() < s2.length()) {
-        return true;
-    }
-    else if (s1.length() > s2.length()) {
-        return false;
-    }
-
-    for (size_t i = 0; i < s1.length(); ++i) {
-        if (s1[i] < s2[i]) {
-            return true;
-        }
-        else if (s1[i] > s2[i]) {
-            return false;
-        }
+    std::string utf8;
+    if (!empty()) {
+        appendUTF8(utf8, codepoint);
     }
-    return false;
-}
-
-bool Char::operator<=(const Char& other) const
-{
-    return *this < other || *this == other;
-}
-
-bool Char::operator>(const Char& other) const
-{
-    return !(*this <= other);
-}
-
-bool Char::operator>=(const Char& other) const
-{
-    return !(*this < other);
+    return utf8;
 }
 
 Char Char::operator+(int n) const {
-    int codepoint = this->toCodepoint();
-    return fromCodepoint(codepoint + n);
+    return fromCodepoint(toCodepoint() + n);
 }
 
 Char Char::operator-(int n) const {
-    int codepoint = this->toCodepoint();
-    return fromCodepoint(codepoint - n);
-}
-
-int Char::toCodepoint() const {
-    unsigned char bytes[4];
-    std::memcpy(bytes, data.data(), data.size());
-    int codepoint = 0;
-    switch (data.size()) {
-    case 1:
-        codepoint = bytes[0];
-        break;
-    case 2:
-        codepoint = (((bytes[0] & 0x1F) << 6) | (bytes[1] & 0x3F));
-        break;
-    case 3:
-        codepoint = (((bytes[0] & 0x0F) << 12) | ((bytes[1] & 0x3F) << 6) | (bytes[2] & 0x3F));
-        break;
-    case 4:
-        codepoint = (((bytes[0] & 0x07) << 18) | ((bytes[1] & 0x3F) << 12) | ((bytes[2] & 0x3F) << 6) | (bytes[3] & 0x3F));
-        break;
-    default:
-        throw std::invalid_argument("Invalid UTF-8 encoding");
-    }
-    return codepoint;
+    return fromCodepoint(toCodepoint() - n);
 }
 
 std::ostream& operator<<(std::ostream& os, const Char& ch) {
     return os << ch.toUTF8();
 }
 
-String::String() : chars() {}
+String::String() : data(), offsets() {}
 
-String::String(Char ch) : chars({ ch }) {}
-
-String::String(std::vector<Char> vec) : chars(vec) {}
+String::String(Char ch) {
+    push_back(ch);
+}
 
-String::String(const std::string& utf8) {
-    for (size_t i = 0; i < utf8.size();) {
-        size_t charLen = 1;
-        if ((utf8[i] & 0x80) == 0) {
-        }
-        else if ((utf8[i] & 0xE0) == 0xC0) {
-            charLen = 2;
-        }
-        else if ((utf8[i] & 0xF0) == 0xE0) {
-            charLen = 3;
-        }
-        else if ((utf8[i] & 0xF8) == 0xF0) {
-            charLen = 4;
-        }
-        if (i + charLen > utf8.size()) {
-            throw std::runtime_error("Invalid UTF-8 encoding");
-        }
-        chars.push_back(Char(utf8.substr(i, charLen)));
-        i += charLen;
+String::String(std::vector<Char> vec) {
+    for (const Char& ch : vec) {
+        push_back(ch);
     }
 }
 
-String::String(int num) {
-    std::string numStr = std::to_string(num);
-    for (size_t i = 0; i < numStr.size();) {
-        size_t charLen = 1;
-        if ((numStr[i] & 0x80) == 0) {
-        }
-        else if ((numStr[i] & 0xE0) == 0xC0) {
-            charLen = 2;
-        }
-        else if ((numStr[i] & 0xF0) == 0xE0) {
-            charLen = 3;
-        }
-        else if ((numStr[i] & 0xF8) == 0xF0) {
-            charLen = 4;
-        }
-        if (i + charLen > numStr.size()) {
-            throw std::runtime_error("Invalid UTF-8 encoding");
-        }
-        chars.push_back(Char(numStr.substr(i, charLen)));
-        i += charLen;
-    }
+String::String(const std::string& utf8) {
+    append(utf8.data(), utf8.size());
 }
 
+String::String(int num) : String(std::to_string(num)) {}
+
 String::String(const char* cstr) : String(std::string(cstr)) {}
 
 String::String(char* cstr) : String(std::string(cstr)) {}
@@ -207,17 +105,36 @@ String& String::operator=(char* cstr) {
     return *this;
 }
 
+// Appends raw UTF-8 bytes, indexing any non-ASCII code points.
+void String::append(const char* s, size_t n) {
+    if (offsets.empty() && UTF8::isASCII(s, n)) {
+        data.append(s, n);
+        return;
+    }
+    if (UTF8::validate(s, n) != n) {
+        throw std::runtime_error("Invalid UTF-8 encoding");
+    }
+    if (offsets.empty()) {
+        offsets.reserve(data.size() + n);
+        for (uint32_t k = 0; k < data.size(); ++k) {
+            offsets.push_back(k);
+        }
+    }
+    UTF8::boundaries(s, n, static_cast<uint32_t>(data.size()), offsets);
+    data.append(s, n);
+}
+
 String::Iterator::Iterator(const String* str, size_t index) : str_(str), index_(index) {}
 
 std::string String::Iterator::operator*() const {
-    if (index_ >= str_->chars.size()) {
+    if (index_ >= str_->length()) {
         throw std::out_of_range("Iterator out of range");
     }
-    return str_->chars[index_].toUTF8();
+    return (*str_)[index_].toUTF8();
 }
 
 String::Iterator& String::Iterator::operator++() {
-    if (index_ < str_->chars.size()) {
+    if (index_ < str_->length()) {
         ++index_;
     }
     return *this;
@@ -238,77 +155,70 @@ bool String::Iterator::operator!=(const Iterator& other) const {
 }
 
 Char String::front() const {
-    if (chars.empty()) {
-        return {};
-    }
-    return chars.front();
+    return (*this)[0];
 }
 
 String String::substr(size_t pos, size_t len) const {
-    if (pos > chars.size()) {
+    if (pos > length()) {
         throw std::out_of_range("Starting position is beyond the end of the string");
     }
-    size_t endPos = (len == std::string::npos) ? chars.size() : (pos + len);
-    if (endPos > chars.size()) {
-        endPos = chars.size();
-    }std::vector<Char> resultChars;
-    for (size_t i = pos; i < endPos; ++i) {
-        resultChars.push_back(chars[i]);
+    size_t endPos = (len == std::string::npos) ? length() : (pos + len);
+    if (endPos > length()) {
+        endPos = length();
     }
-
-    return String(resultChars);
+    if (offsets.empty()) {
+        return String(data.substr(pos, endPos - pos));
+    }
+    size_t from = offsets[pos];
+    size_t to = endPos < offsets.size() ? offsets[endPos] : data.size();
+    return String(data.substr(from, to - from));
 }
 
 void String::erase(size_t pos, size_t len) {
-    if (pos >= chars.size()) {
+    if (pos >= length()) {
         return;
     }
-    size_t currentPos = 0;
-    auto it = chars.begin();
-    while (it != chars.end() && (len == std::string::npos || currentPos < pos + len)) {
-        if (currentPos >= pos) {
-            it = chars.erase(it);
-        }
-        else {
-            ++it;
-        }
-        currentPos++;
-    }
+    String tail = (len == std::string::npos || pos + len >= length()) ? String() : substr(pos + len);
+    *this = substr(0, pos);
+    *this += tail;
 }
 
 bool String::starts_with(const String& other) const {
-    if (chars.size() < other.chars.size()) {
-        return false;
-    }
-    for (size_t i = 0; i < other.chars.size(); ++i) {
-        if (chars[i] != other.chars[i]) {
-            return false;
-        }
-    }
-    return true;
+    // A byte prefix made of whole UTF-8 sequences is also a code point prefix.
+    return data.compare(0, other.data.size(), other.data) == 0;
 }
 
 void String::remove_prefix(size_t n) {
-    if (n >= chars.size()) {
-        chars.clear();
+    if (n >= length()) {
+        clear();
     }
     else {
-        chars.erase(chars.begin(), chars.begin() + n);
+        *this = substr(n);
     }
 }
 
 void String::push_back(const Char& ch) {
-    chars.push_back(ch);
+    if (ch.empty()) {
+        return;
+    }
+    if (ch.isASCII() && offsets.empty()) {
+        data += ch.toStdChar();
+        return;
+    }
+    std::string utf8 = ch.toUTF8();
+    append(utf8.data(), utf8.size());
 }
 
 void String::clear() {
-    chars.clear();
+    data.clear();
+    offsets.clear();
 }
 
 std::vector<String> String::split(const String input, Char delimiter) {
     std::vector<String> result;
     String current;
-    for (Char ch : input) {
+    for (size_t i = 0; i < input.length(); ++i) {
+        Char ch = input[i];
         if (ch == delimiter) {
             if (!current.empty()) {
                 result.push_back(current);
@@ -328,41 +238,41 @@ std::vector<String> String::split(const String input, Char delimiter) {
 }
 
 bool String::empty() const {
-    return chars.empty();
+    return data.empty();
 }
 
 size_t String::length() const {
-    return chars.size();
+    return offsets.empty() ? data.size() : offsets.size();
 }
 
 Char String::operator[](size_t index) const {
-    if (index >= chars.size()) {
+    if (index >= length()) {
         return {};
     }
-    return  { chars[index].toUTF8() };
+    if (offsets.empty()) {
+        return Char(data[index]);
+    }
+    size_t charLen;
+    return Char(static_cast<int>(view().decode(offsets[index], charLen)));
 }
 
 std::string String::toUTF8() const {
-    std::string result;
-    for (const Char& ch : chars) {
-        result += ch.toUTF8();
-    }
-    return result;
+    return data;
+}
+
+const std::string& String::bytes() const {
+    return data;
+}
+
+StringView String::view() const {
+    return StringView(data.data(), data.size());
 }
 
 String::Iterator String::begin() const { return Iterator(this); }
-String::Iterator String::end() const { return Iterator(this, chars.size()); }
+String::Iterator String::end() const { return Iterator(this, length()); }
 
 bool String::operator==(const String& other) const {
-    if (chars.size() != other.chars.size()) {
-        return false;
-    }
-    for (size_t i = 0; i < chars.size(); ++i) {
-        if (chars[i] != other.chars[i]) {
-            return false;
-        }
-    }
-    return true;
+    return data == other.data;
 }
 
 bool String::operator!=(const String& other) const {
@@ -370,49 +280,178 @@ bool String::operator!=(const String& other) const {
 }
 
 std::ostream& operator<<(std::ostream& os, const String& str) {
-    return os << str.toUTF8();
+    return os << str.data;
 }
 
 String operator+(const String& lhs, const String& rhs) {
-    std::vector<Char> newChars = lhs.chars;
-    newChars.insert(newChars.end(), rhs.chars.begin(), rhs.chars.end());
-    return String(newChars);
+    String result = lhs;
+    result += rhs;
+    return result;
 }
 
 String& operator+=(String& lhs, const String& rhs) {
-    lhs.chars.insert(lhs.chars.end(), rhs.chars.begin(), rhs.chars.end());
+    if (rhs.offsets.empty() && lhs.offsets.empty()) {
+        lhs.data += rhs.data;
+    }
+    else {
+        lhs.append(rhs.data.data(), rhs.data.size());
+    }
     return lhs;
 }
 
+StringView::StringView() : begin_(""), size_(0) {}
+
+StringView::StringView(const char* data, size_t size) : begin_(data), size_(size) {}
+
+StringView::StringView(const char* cstr)
+    : begin_(cstr), size_(std::char_traits<char>::length(cstr)) {}
+
+StringView::StringView(const std::string& str) : begin_(str.data()), size_(str.size()) {}
+
+StringView::StringView(std::string_view str) : begin_(str.data()), size_(str.size()) {}
+
+StringView::StringView(std::span<const char8_t> bytes)
+    : begin_(reinterpret_cast<const char*>(bytes.data())), size_(bytes.size()) {}
+
+StringView::StringView(const String& str) : StringView(str.view()) {}
+
+Char StringView::at(size_t offset) const {
+    size_t length;
+    char32_t codepoint = decode(offset, length);
+    return codepoint == Char::none ? Char() : Char(static_cast<int>(codepoint));
+}
+
+size_t StringView::next(size_t offset) const {
+    size_t length;
+    decode(offset, length);
+    return offset + length;
+}
+
+size_t StringView::prev(size_t offset) const {
+    if (offset == 0) {
+        return 0;
+    }
+    size_t i = offset - 1;
+    // Step back over continuation bytes, but never more than a sequence's worth.
+    while (i > 0 && offset - i < 4 && (byte(i) & 0xC0) == 0x80) {
+        i--;
+    }
+    return i;
+}
+
+size_t StringView::length() const {
+    return UTF8::count(begin_, size_);
+}
+
+bool StringView::isValid() const {
+    return UTF8::isValid(begin_, size_);
+}
+
+std::u32string StringView::toCodepoints() const {
+    if (!isValid()) {
+        throw std::runtime_error("Invalid UTF-8 encoding");
+    }
+    std::u32string codepoints(size_, U'\0');
+    codepoints.resize(UTF8::decode(begin_, size_, codepoints.data()));
+    return codepoints;
+}
+
+StringView StringView::substr(size_t offset, size_t count) const {
+    if (offset > size_) {
+        throw std::out_of_range("Starting position is beyond the end of the string");
+    }
+    return { begin_ + offset, std::min(count, size_ - offset) };
+}
+
+bool StringView::operator==(const StringView& other) const {
+    return toStdStringView() == other.toStdStringView();
+}
+
+bool StringView::operator!=(const StringView& other) const {
+    return !(*this == other);
+}
+
+std::ostream& operator<<(std::ostream& os, const StringView& str) {
+    return os << str.toStdStringView();
+}
+
 Char fromCodepoint(int unicode) {
-    std::string utf8;
-    if (unicode < 0x80) {
+    return Char(unicode);
+}
+
+void appendUTF8(std::string& out, char32_t codepoint) {
+    if (codepoint < 0x80) {
         // 1-byte sequence
-        utf8 += static_cast<char>(unicode);
+        out += static_cast<char>(codepoint);
     }
-    else if (unicode < 0x800) {
+    else if (codepoint < 0x800) {
         // 2-byte sequence
-        utf8 += static_cast<char>(0xC0 | (unicode >> 6));
-        utf8 += static_cast<char>(0x80 | (unicode & 0x3F));
+        out += static_cast<char>(0xC0 | (codepoint >> 6));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
     }
-    else if (unicode < 0x10000) {
+    else if (codepoint < 0x10000) {
         // 3-byte sequence
-        utf8 += static_cast<char>(0xE0 | (unicode >> 12));
-        utf8 += static_cast<char>(0x80 | ((unicode >> 6) & 0x3F));
-        utf8 += static_cast<char>(0x80 | (unicode & 0x3F));
+        out += static_cast<char>(0xE0 | (codepoint >> 12));
+        out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
     }
-    else if (unicode <= 0x10FFFF) {
+    else if (codepoint <= 0x10FFFF) {
         // 4-byte sequence
-        utf8 += static_cast<char>(0xF0 | (unicode >> 18));
-        utf8 += static_cast<char>(0x80 | ((unicode >> 12) & 0x3F));
-        utf8 += static_cast<char>(0x80 | ((unicode >> 6) & 0x3F));
-        utf8 += static_cast<char>(0x80 | (unicode & 0x3F));
+        out += static_cast<char>(0xF0 | (codepoint >> 18));
+        out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
     }
     else {
         // Invalid Unicode code point
         throw std::invalid_argument("Invalid Unicode code point");
     }
-    return { utf8 };
+}
+
+// Decodes the UTF-8 sequence at the head of s.
+// Returns its length in bytes, or 0 if s is empty or the sequence is truncated.
+size_t decodeUTF8(const char* s, size_t n, char32_t& codepoint) {
+    if (n == 0) {
+        return 0;
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(s);
+    size_t charLen = 1;
+    if ((bytes[0] & 0x80) == 0) {
+        codepoint = bytes[0];
+        return 1;
+    }
+    else if ((bytes[0] & 0xE0) == 0xC0) {
+        charLen = 2;
+        codepoint = bytes[0] & 0x1F;
+    }
+    else if ((bytes[0] & 0xF0) == 0xE0) {
+        charLen = 3;
+        codepoint = bytes[0] & 0x0F;
+    }
+    else if ((bytes[0] & 0xF8) == 0xF0) {
+        charLen = 4;
+        codepoint = bytes[0] & 0x07;
+    }
+    else {
+        codepoint = bytes[0];
+        return 1;
+    }
+    if (charLen > n) {
+        return 0;
+    }
+    for (size_t i = 1; i < charLen; ++i) {
+        // Every byte after the first must be a continuation byte
+        if ((bytes[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        codepoint = (codepoint << 6) | (bytes[i] & 0x3F);
+    }
+    // Overlong forms, surrogates and values past U+10FFFF are not characters
+    static constexpr char32_t minimum[] = { 0, 0, 0x80, 0x800, 0x10000 };
+    if (codepoint < minimum[charLen] || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF) {
+        return 0;
+    }
+    return charLen;
 }
 
 String toHexString(int number) {
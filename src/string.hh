@@ -4,12 +4,26 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <string_view>
+#include <span>
+#include <cstdint>
 #include <stdexcept>
+#include <type_traits>
 
 class String;
+class StringView;
 
+size_t decodeUTF8(const char* s, size_t n, char32_t& codepoint);
+
+// A single Unicode code point.
+//
+// Char is a plain 32-bit value: it is trivially copyable and never allocates.
+// The UTF-8 form is only produced on demand by toUTF8().
 class Char {
 public:
+    // The value of an empty Char, e.g. Char("") or String()[0].
+    static constexpr char32_t none = 0xFFFFFFFF;
+
     Char();
     Char(const std::string& utf8);
     Char(char c);
@@ -17,29 +31,36 @@ public:
     Char(const char* cstr);
     Char& operator=(const char* cstr);
     Char& operator=(char c);
-    bool isASCII() const;
+    bool empty() const { return codepoint == none; }
+    bool isASCII() const { return codepoint < 0x80; }
     char toStdChar() const;
     bool isStdDigit() const;
     bool isStdAlpha() const;
     bool isStdAlnum() const;
     bool isSingle() const;
     std::string toUTF8() const;
-    bool operator==(const Char& other) const;
-    bool operator!=(const Char& other) const;
-    bool operator<(const Char& other) const;
-    bool operator<=(const Char& other) const;
-    bool operator>(const Char& other) const;
-    bool operator>=(const Char& other) const;
+    bool operator==(const Char& other) const { return codepoint == other.codepoint; }
+    bool operator!=(const Char& other) const { return codepoint != other.codepoint; }
+    bool operator<(const Char& other) const { return codepoint < other.codepoint; }
+    bool operator<=(const Char& other) const { return codepoint <= other.codepoint; }
+    bool operator>(const Char& other) const { return codepoint > other.codepoint; }
+    bool operator>=(const Char& other) const { return codepoint >= other.codepoint; }
     Char operator-(int n) const;
     Char operator+(int n) const;
-    int toCodepoint() const;
+    int toCodepoint() const { return static_cast<int>(codepoint); }
     friend std::ostream& operator<<(std::ostream& os, const Char& ch);
 
 private:
-    std::string data;
-    size_t size;
+    char32_t codepoint;
 };
 
+static_assert(sizeof(Char) == 4 && std::is_trivially_copyable_v<Char>);
+
+// A UTF-8 string.
+//
+// The bytes are kept contiguous in their original encoding. For strings that
+// contain non-ASCII characters, the byte offset of every code point is also
+// recorded so that indexing by code point stays O(1).
 class String {
 public:
     String();
@@ -78,6 +99,8 @@ public:
     size_t length() const;
     Char operator[](size_t index) const;
     std::string toUTF8() const;
+    const std::string& bytes() const;
+    StringView view() const;
     Iterator begin() const;
     Iterator end() const;
     bool operator==(const String& other) const;
@@ -87,13 +110,76 @@ public:
     friend String& operator+=(String& lhs, const String& rhs);
 
 private:
-    std::vector<Char> chars;
+    std::string data;
+
+    // Byte offset of each code point; empty while the string is pure ASCII.
+    std::vector<uint32_t> offsets;
+
+    void append(const char* s, size_t n);
+};
+
+// A non-owning view of UTF-8 bytes, decoded on the fly.
+//
+// Positions are byte offsets. This is what the matching engines take as
+// their subject, so a caller's buffer is never copied.
+class StringView {
+public:
+    StringView();
+    StringView(const char* data, size_t size);
+    StringView(const char* cstr);
+    StringView(const std::string& str);
+    StringView(std::string_view str);
+    StringView(std::span<const char8_t> bytes);
+    StringView(const String& str);
+
+    const char* data() const { return begin_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    unsigned char byte(size_t offset) const { return static_cast<unsigned char>(begin_[offset]); }
+
+    // Decodes the code point starting at offset and stores its length in
+    // bytes into length. Returns Char::none at the end of the view.
+    char32_t decode(size_t offset, size_t& length) const {
+        if (offset >= size_) {
+            length = 0;
+            return Char::none;
+        }
+        unsigned char b = byte(offset);
+        if (b < 0x80) {
+            length = 1;
+            return b;
+        }
+        char32_t codepoint;
+        length = decodeUTF8(begin_ + offset, size_ - offset, codepoint);
+        if (length == 0) {
+            length = 1;
+            return b;
+        }
+        return codepoint;
+    }
+    Char at(size_t offset) const;
+    size_t next(size_t offset) const;
+    size_t prev(size_t offset) const;
+    size_t length() const;
+    bool isValid() const;
+    std::u32string toCodepoints() const;
+    StringView substr(size_t offset, size_t count = std::string::npos) const;
+    std::string_view toStdStringView() const { return { begin_, size_ }; }
+    std::string toUTF8() const { return { begin_, size_ }; }
+    bool operator==(const StringView& other) const;
+    bool operator!=(const StringView& other) const;
+    friend std::ostream& operator<<(std::ostream& os, const StringView& str);
+
+private:
+    const char* begin_;
+    size_t size_;
 };
 
 String operator+(const String& lhs, const String& rhs);
 String& operator+=(String& lhs, const String& rhs);
 
 Char fromCodepoint(int unicode);
+void appendUTF8(std::string& out, char32_t codepoint);
 String toHexString(int number);
 int toInteger(String s);
 
@@ -24,6 +24,7 @@ std::map<TokenType, std::string> tokenTypeMap = {
     {{ TokenType::NamedCapturingGroupClose}, { "NamedCapturingGroupClose" }},
     {{ TokenType::NonCapturingGroupOpen}, { "NonCapturingGroupOpen" }},
     {{ TokenType::NonCapturingGroupClose}, { "NonCapturingGroupClose" }},
+    {{ TokenType::AtomicGroupOpen}, { "AtomicGroupOpen" }},
     {{ TokenType::AssertionLookahead}, { "AssertionLookahead" }},
     {{ TokenType::AssertionNegativeLookahead}, { "AssertionNegativeLookahead" }},
     {{ TokenType::AssertionLookbehind}, { "AssertionLookbehind" }},
@@ -44,7 +45,8 @@ std::map<TokenType, std::string> tokenTypeMap = {
     {{ TokenType::Modifier}, { "Modifier" }},
     {{ TokenType::EscapeSequence}, { "EscapeSequence" }},
     {{ TokenType::UnicodeCodePoint}, { "UnicodeCodePoint" }},
-    {{ TokenType::UnicodeProperty}, { "UnicodeProperty" }}
+    {{ TokenType::UnicodeProperty}, { "UnicodeProperty" }},
+    {{ TokenType::UnicodePropertyNegative}, { "UnicodePropertyNegative" }}
 };
 
 String Token::toString() const
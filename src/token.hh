@@ -46,6 +46,9 @@ enum class TokenType {
     NonCapturingGroupOpen, // 实例："(?:"
     NonCapturingGroupClose, // 实例：")"
 
+    // 原子组
+    AtomicGroupOpen, // 实例："(?>"
+
     // 断言
     AssertionLookahead, // 实例："(?="
     AssertionNegativeLookahead, // 实例："(?!"
@@ -86,6 +89,7 @@ enum class TokenType {
 
     // Unicode 属性
     UnicodeProperty, // 实例："\p{L}"
+    UnicodePropertyNegative, // 实例："\P{L}"
 
 };
 
@@ -0,0 +1,712 @@
+#include "unicode.hh"
+#include <algorithm>
+
+namespace {
+
+    struct Run {
+        char32_t start;
+        uint8_t category;
+    };
+
+    // General categories from the Unicode Character Database, version 14.0.0.
+    // Each run starts where the category of a code point differs from that
+    // of the one before; it ends where the next one starts.
+    constexpr Run runs[] = {
+        { 0x0000, 15 }, { 0x0020, 12 }, { 0x0021, 24 }, { 0x0024, 26 }, { 0x0025, 24 }, { 0x0028, 21 },
+        { 0x0029, 22 }, { 0x002A, 24 }, { 0x002B, 25 }, { 0x002C, 24 }, { 0x002D, 20 }, { 0x002E, 24 },
+        { 0x0030, 9 }, { 0x003A, 24 }, { 0x003C, 25 }, { 0x003F, 24 }, { 0x0041, 1 }, { 0x005B, 21 },
+        { 0x005C, 24 }, { 0x005D, 22 }, { 0x005E, 27 }, { 0x005F, 23 }, { 0x0060, 27 }, { 0x0061, 2 },
+        { 0x007B, 21 }, { 0x007C, 25 }, { 0x007D, 22 }, { 0x007E, 25 }, { 0x007F, 15 }, { 0x00A0, 12 },
+        { 0x00A1, 24 }, { 0x00A2, 26 }, { 0x00A6, 28 }, { 0x00A7, 24 }, { 0x00A8, 27 }, { 0x00A9, 28 },
+        { 0x00AA, 5 }, { 0x00AB, 29 }, { 0x00AC, 25 }, { 0x00AD, 16 }, { 0x00AE, 28 }, { 0x00AF, 27 },
+        { 0x00B0, 28 }, { 0x00B1, 25 }, { 0x00B2, 11 }, { 0x00B4, 27 }, { 0x00B5, 2 }, { 0x00B6, 24 },
+        { 0x00B8, 27 }, { 0x00B9, 11 }, { 0x00BA, 5 }, { 0x00BB, 30 }, { 0x00BC, 11 }, { 0x00BF, 24 },
+        { 0x00C0, 1 }, { 0x00D7, 25 }, { 0x00D8, 1 }, { 0x00DF, 2 }, { 0x00F7, 25 }, { 0x00F8, 2 },
+        { 0x0100, 1 }, { 0x0101, 2 }, { 0x0102, 1 }, { 0x0103, 2 }, { 0x0104, 1 }, { 0x0105, 2 },
+        { 0x0106, 1 }, { 0x0107, 2 }, { 0x0108, 1 }, { 0x0109, 2 }, { 0x010A, 1 }, { 0x010B, 2 },
+        { 0x010C, 1 }, { 0x010D, 2 }, { 0x010E, 1 }, { 0x010F, 2 }, { 0x0110, 1 }, { 0x0111, 2 },
+        { 0x0112, 1 }, { 0x0113, 2 }, { 0x0114, 1 }, { 0x0115, 2 }, { 0x0116, 1 }, { 0x0117, 2 },
+        { 0x0118, 1 }, { 0x0119, 2 }, { 0x011A, 1 }, { 0x011B, 2 }, { 0x011C, 1 }, { 0x011D, 2 },
+        { 0x011E, 1 }, { 0x011F, 2 }, { 0x0120, 1 }, { 0x0121, 2 }, { 0x0122, 1 }, { 0x0123, 2 },
+        { 0x0124, 1 }, { 0x0125, 2 }, { 0x0126, 1 }, { 0x0127, 2 }, { 0x0128, 1 }, { 0x0129, 2 },
+        { 0x012A, 1 }, { 0x012B, 2 }, { 0x012C, 1 }, { 0x012D, 2 }, { 0x012E, 1 }, { 0x012F, 2 },
+        { 0x0130, 1 }, { 0x0131, 2 }, { 0x0132, 1 }, { 0x0133, 2 }, { 0x0134, 1 }, { 0x0135, 2 },
+        { 0x0136, 1 }, { 0x0137, 2 }, { 0x0139, 1 }, { 0x013A, 2 }, { 0x013B, 1 }, { 0x013C, 2 },
+        { 0x013D, 1 }, { 0x013E, 2 }, { 0x013F, 1 }, { 0x0140, 2 }, { 0x0141, 1 }, { 0x0142, 2 },
+        { 0x0143, 1 }, { 0x0144, 2 }, { 0x0145, 1 }, { 0x0146, 2 }, { 0x0147, 1 }, { 0x0148, 2 },
+        { 0x014A, 1 }, { 0x014B, 2 }, { 0x014C, 1 }, { 0x014D, 2 }, { 0x014E, 1 }, { 0x014F, 2 },
+        { 0x0150, 1 }, { 0x0151, 2 }, { 0x0152, 1 }, { 0x0153, 2 }, { 0x0154, 1 }, { 0x0155, 2 },
+        { 0x0156, 1 }, { 0x0157, 2 }, { 0x0158, 1 }, { 0x0159, 2 }, { 0x015A, 1 }, { 0x015B, 2 },
+        { 0x015C, 1 }, { 0x015D, 2 }, { 0x015E, 1 }, { 0x015F, 2 }, { 0x0160, 1 }, { 0x0161, 2 },
+        { 0x0162, 1 }, { 0x0163, 2 }, { 0x0164, 1 }, { 0x0165, 2 }, { 0x0166, 1 }, { 0x0167, 2 },
+        { 0x0168, 1 }, { 0x0169, 2 }, { 0x016A, 1 }, { 0x016B, 2 }, { 0x016C, 1 }, { 0x016D, 2 },
+        { 0x016E, 1 }, { 0x016F, 2 }, { 0x0170, 1 }, { 0x0171, 2 }, { 0x0172, 1 }, { 0x0173, 2 },
+        { 0x0174, 1 }, { 0x0175, 2 }, { 0x0176, 1 }, { 0x0177, 2 }, { 0x0178, 1 }, { 0x017A, 2 },
+        { 0x017B, 1 }, { 0x017C, 2 }, { 0x017D, 1 }, { 0x017E, 2 }, { 0x0181, 1 }, { 0x0183, 2 },
+        { 0x0184, 1 }, { 0x0185, 2 }, { 0x0186, 1 }, { 0x0188, 2 }, { 0x0189, 1 }, { 0x018C, 2 },
+        { 0x018E, 1 }, { 0x0192, 2 }, { 0x0193, 1 }, { 0x0195, 2 }, { 0x0196, 1 }, { 0x0199, 2 },
+        { 0x019C, 1 }, { 0x019E, 2 }, { 0x019F, 1 }, { 0x01A1, 2 }, { 0x01A2, 1 }, { 0x01A3, 2 },
+        { 0x01A4, 1 }, { 0x01A5, 2 }, { 0x01A6, 1 }, { 0x01A8, 2 }, { 0x01A9, 1 }, { 0x01AA, 2 },
+        { 0x01AC, 1 }, { 0x01AD, 2 }, { 0x01AE, 1 }, { 0x01B0, 2 }, { 0x01B1, 1 }, { 0x01B4, 2 },
+        { 0x01B5, 1 }, { 0x01B6, 2 }, { 0x01B7, 1 }, { 0x01B9, 2 }, { 0x01BB, 5 }, { 0x01BC, 1 },
+        { 0x01BD, 2 }, { 0x01C0, 5 }, { 0x01C4, 1 }, { 0x01C5, 3 }, { 0x01C6, 2 }, { 0x01C7, 1 },
+        { 0x01C8, 3 }, { 0x01C9, 2 }, { 0x01CA, 1 }, { 0x01CB, 3 }, { 0x01CC, 2 }, { 0x01CD, 1 },
+        { 0x01CE, 2 }, { 0x01CF, 1 }, { 0x01D0, 2 }, { 0x01D1, 1 }, { 0x01D2, 2 }, { 0x01D3, 1 },
+        { 0x01D4, 2 }, { 0x01D5, 1 }, { 0x01D6, 2 }, { 0x01D7, 1 }, { 0x01D8, 2 }, { 0x01D9, 1 },
+        { 0x01DA, 2 }, { 0x01DB, 1 }, { 0x01DC, 2 }, { 0x01DE, 1 }, { 0x01DF, 2 }, { 0x01E0, 1 },
+        { 0x01E1, 2 }, { 0x01E2, 1 }, { 0x01E3, 2 }, { 0x01E4, 1 }, { 0x01E5, 2 }, { 0x01E6, 1 },
+        { 0x01E7, 2 }, { 0x01E8, 1 }, { 0x01E9, 2 }, { 0x01EA, 1 }, { 0x01EB, 2 }, { 0x01EC, 1 },
+        { 0x01ED, 2 }, { 0x01EE, 1 }, { 0x01EF, 2 }, { 0x01F1, 1 }, { 0x01F2, 3 }, { 0x01F3, 2 },
+        { 0x01F4, 1 }, { 0x01F5, 2 }, { 0x01F6, 1 }, { 0x01F9, 2 }, { 0x01FA, 1 }, { 0x01FB, 2 },
+        { 0x01FC, 1 }, { 0x01FD, 2 }, { 0x01FE, 1 }, { 0x01FF, 2 }, { 0x0200, 1 }, { 0x0201, 2 },
+        { 0x0202, 1 }, { 0x0203, 2 }, { 0x0204, 1 }, { 0x0205, 2 }, { 0x0206, 1 }, { 0x0207, 2 },
+        { 0x0208, 1 }, { 0x0209, 2 }, { 0x020A, 1 }, { 0x020B, 2 }, { 0x020C, 1 }, { 0x020D, 2 },
+        { 0x020E, 1 }, { 0x020F, 2 }, { 0x0210, 1 }, { 0x0211, 2 }, { 0x0212, 1 }, { 0x0213, 2 },
+        { 0x0214, 1 }, { 0x0215, 2 }, { 0x0216, 1 }, { 0x0217, 2 }, { 0x0218, 1 }, { 0x0219, 2 },
+        { 0x021A, 1 }, { 0x021B, 2 }, { 0x021C, 1 }, { 0x021D, 2 }, { 0x021E, 1 }, { 0x021F, 2 },
+        { 0x0220, 1 }, { 0x0221, 2 }, { 0x0222, 1 }, { 0x0223, 2 }, { 0x0224, 1 }, { 0x0225, 2 },
+        { 0x0226, 1 }, { 0x0227, 2 }, { 0x0228, 1 }, { 0x0229, 2 }, { 0x022A, 1 }, { 0x022B, 2 },
+        { 0x022C, 1 }, { 0x022D, 2 }, { 0x022E, 1 }, { 0x022F, 2 }, { 0x0230, 1 }, { 0x0231, 2 },
+        { 0x0232, 1 }, { 0x0233, 2 }, { 0x023A, 1 }, { 0x023C, 2 }, { 0x023D, 1 }, { 0x023F, 2 },
+        { 0x0241, 1 }, { 0x0242, 2 }, { 0x0243, 1 }, { 0x0247, 2 }, { 0x0248, 1 }, { 0x0249, 2 },
+        { 0x024A, 1 }, { 0x024B, 2 }, { 0x024C, 1 }, { 0x024D, 2 }, { 0x024E, 1 }, { 0x024F, 2 },
+        { 0x0294, 5 }, { 0x0295, 2 }, { 0x02B0, 4 }, { 0x02C2, 27 }, { 0x02C6, 4 }, { 0x02D2, 27 },
+        { 0x02E0, 4 }, { 0x02E5, 27 }, { 0x02EC, 4 }, { 0x02ED, 27 }, { 0x02EE, 4 }, { 0x02EF, 27 },
+        { 0x0300, 6 }, { 0x0370, 1 }, { 0x0371, 2 }, { 0x0372, 1 }, { 0x0373, 2 }, { 0x0374, 4 },
+        { 0x0375, 27 }, { 0x0376, 1 }, { 0x0377, 2 }, { 0x0378, 0 }, { 0x037A, 4 }, { 0x037B, 2 },
+        { 0x037E, 24 }, { 0x037F, 1 }, { 0x0380, 0 }, { 0x0384, 27 }, { 0x0386, 1 }, { 0x0387, 24 },
+        { 0x0388, 1 }, { 0x038B, 0 }, { 0x038C, 1 }, { 0x038D, 0 }, { 0x038E, 1 }, { 0x0390, 2 },
+        { 0x0391, 1 }, { 0x03A2, 0 }, { 0x03A3, 1 }, { 0x03AC, 2 }, { 0x03CF, 1 }, { 0x03D0, 2 },
+        { 0x03D2, 1 }, { 0x03D5, 2 }, { 0x03D8, 1 }, { 0x03D9, 2 }, { 0x03DA, 1 }, { 0x03DB, 2 },
+        { 0x03DC, 1 }, { 0x03DD, 2 }, { 0x03DE, 1 }, { 0x03DF, 2 }, { 0x03E0, 1 }, { 0x03E1, 2 },
+        { 0x03E2, 1 }, { 0x03E3, 2 }, { 0x03E4, 1 }, { 0x03E5, 2 }, { 0x03E6, 1 }, { 0x03E7, 2 },
+        { 0x03E8, 1 }, { 0x03E9, 2 }, { 0x03EA, 1 }, { 0x03EB, 2 }, { 0x03EC, 1 }, { 0x03ED, 2 },
+        { 0x03EE, 1 }, { 0x03EF, 2 }, { 0x03F4, 1 }, { 0x03F5, 2 }, { 0x03F6, 25 }, { 0x03F7, 1 },
+        { 0x03F8, 2 }, { 0x03F9, 1 }, { 0x03FB, 2 }, { 0x03FD, 1 }, { 0x0430, 2 }, { 0x0460, 1 },
+        { 0x0461, 2 }, { 0x0462, 1 }, { 0x0463, 2 }, { 0x0464, 1 }, { 0x0465, 2 }, { 0x0466, 1 },
+        { 0x0467, 2 }, { 0x0468, 1 }, { 0x0469, 2 }, { 0x046A, 1 }, { 0x046B, 2 }, { 0x046C, 1 },
+        { 0x046D, 2 }, { 0x046E, 1 }, { 0x046F, 2 }, { 0x0470, 1 }, { 0x0471, 2 }, { 0x0472, 1 },
+        { 0x0473, 2 }, { 0x0474, 1 }, { 0x0475, 2 }, { 0x0476, 1 }, { 0x0477, 2 }, { 0x0478, 1 },
+        { 0x0479, 2 }, { 0x047A, 1 }, { 0x047B, 2 }, { 0x047C, 1 }, { 0x047D, 2 }, { 0x047E, 1 },
+        { 0x047F, 2 }, { 0x0480, 1 }, { 0x0481, 2 }, { 0x0482, 28 }, { 0x0483, 6 }, { 0x0488, 7 },
+        { 0x048A, 1 }, { 0x048B, 2 }, { 0x048C, 1 }, { 0x048D, 2 }, { 0x048E, 1 }, { 0x048F, 2 },
+        { 0x0490, 1 }, { 0x0491, 2 }, { 0x0492, 1 }, { 0x0493, 2 }, { 0x0494, 1 }, { 0x0495, 2 },
+        { 0x0496, 1 }, { 0x0497, 2 }, { 0x0498, 1 }, { 0x0499, 2 }, { 0x049A, 1 }, { 0x049B, 2 },
+        { 0x049C, 1 }, { 0x049D, 2 }, { 0x049E, 1 }, { 0x049F, 2 }, { 0x04A0, 1 }, { 0x04A1, 2 },
+        { 0x04A2, 1 }, { 0x04A3, 2 }, { 0x04A4, 1 }, { 0x04A5, 2 }, { 0x04A6, 1 }, { 0x04A7, 2 },
+        { 0x04A8, 1 }, { 0x04A9, 2 }, { 0x04AA, 1 }, { 0x04AB, 2 }, { 0x04AC, 1 }, { 0x04AD, 2 },
+        { 0x04AE, 1 }, { 0x04AF, 2 }, { 0x04B0, 1 }, { 0x04B1, 2 }, { 0x04B2, 1 }, { 0x04B3, 2 },
+        { 0x04B4, 1 }, { 0x04B5, 2 }, { 0x04B6, 1 }, { 0x04B7, 2 }, { 0x04B8, 1 }, { 0x04B9, 2 },
+        { 0x04BA, 1 }, { 0x04BB, 2 }, { 0x04BC, 1 }, { 0x04BD, 2 }, { 0x04BE, 1 }, { 0x04BF, 2 },
+        { 0x04C0, 1 }, { 0x04C2, 2 }, { 0x04C3, 1 }, { 0x04C4, 2 }, { 0x04C5, 1 }, { 0x04C6, 2 },
+        { 0x04C7, 1 }, { 0x04C8, 2 }, { 0x04C9, 1 }, { 0x04CA, 2 }, { 0x04CB, 1 }, { 0x04CC, 2 },
+        { 0x04CD, 1 }, { 0x04CE, 2 }, { 0x04D0, 1 }, { 0x04D1, 2 }, { 0x04D2, 1 }, { 0x04D3, 2 },
+        { 0x04D4, 1 }, { 0x04D5, 2 }, { 0x04D6, 1 }, { 0x04D7, 2 }, { 0x04D8, 1 }, { 0x04D9, 2 },
+        { 0x04DA, 1 }, { 0x04DB, 2 }, { 0x04DC, 1 }, { 0x04DD, 2 }, { 0x04DE, 1 }, { 0x04DF, 2 },
+        { 0x04E0, 1 }, { 0x04E1, 2 }, { 0x04E2, 1 }, { 0x04E3, 2 }, { 0x04E4, 1 }, { 0x04E5, 2 },
+        { 0x04E6, 1 }, { 0x04E7, 2 }, { 0x04E8, 1 }, { 0x04E9, 2 }, { 0x04EA, 1 }, { 0x04EB, 2 },
+        { 0x04EC, 1 }, { 0x04ED, 2 }, { 0x04EE, 1 }, { 0x04EF, 2 }, { 0x04F0, 1 }, { 0x04F1, 2 },
+        { 0x04F2, 1 }, { 0x04F3, 2 }, { 0x04F4, 1 }, { 0x04F5, 2 }, { 0x04F6, 1 }, { 0x04F7, 2 },
+        { 0x04F8, 1 }, { 0x04F9, 2 }, { 0x04FA, 1 }, { 0x04FB, 2 }, { 0x04FC, 1 }, { 0x04FD, 2 },
+        { 0x04FE, 1 }, { 0x04FF, 2 }, { 0x0500, 1 }, { 0x0501, 2 }, { 0x0502, 1 }, { 0x0503, 2 },
+        { 0x0504, 1 }, { 0x0505, 2 }, { 0x0506, 1 }, { 0x0507, 2 }, { 0x0508, 1 }, { 0x0509, 2 },
+        { 0x050A, 1 }, { 0x050B, 2 }, { 0x050C, 1 }, { 0x050D, 2 }, { 0x050E, 1 }, { 0x050F, 2 },
+        { 0x0510, 1 }, { 0x0511, 2 }, { 0x0512, 1 }, { 0x0513, 2 }, { 0x0514, 1 }, { 0x0515, 2 },
+        { 0x0516, 1 }, { 0x0517, 2 }, { 0x0518, 1 }, { 0x0519, 2 }, { 0x051A, 1 }, { 0x051B, 2 },
+        { 0x051C, 1 }, { 0x051D, 2 }, { 0x051E, 1 }, { 0x051F, 2 }, { 0x0520, 1 }, { 0x0521, 2 },
+        { 0x0522, 1 }, { 0x0523, 2 }, { 0x0524, 1 }, { 0x0525, 2 }, { 0x0526, 1 }, { 0x0527, 2 },
+        { 0x0528, 1 }, { 0x0529, 2 }, { 0x052A, 1 }, { 0x052B, 2 }, { 0x052C, 1 }, { 0x052D, 2 },
+        { 0x052E, 1 }, { 0x052F, 2 }, { 0x0530, 0 }, { 0x0531, 1 }, { 0x0557, 0 }, { 0x0559, 4 },
+        { 0x055A, 24 }, { 0x0560, 2 }, { 0x0589, 24 }, { 0x058A, 20 }, { 0x058B, 0 }, { 0x058D, 28 },
+        { 0x058F, 26 }, { 0x0590, 0 }, { 0x0591, 6 }, { 0x05BE, 20 }, { 0x05BF, 6 }, { 0x05C0, 24 },
+        { 0x05C1, 6 }, { 0x05C3, 24 }, { 0x05C4, 6 }, { 0x05C6, 24 }, { 0x05C7, 6 }, { 0x05C8, 0 },
+        { 0x05D0, 5 }, { 0x05EB, 0 }, { 0x05EF, 5 }, { 0x05F3, 24 }, { 0x05F5, 0 }, { 0x0600, 16 },
+        { 0x0606, 25 }, { 0x0609, 24 }, { 0x060B, 26 }, { 0x060C, 24 }, { 0x060E, 28 }, { 0x0610, 6 },
+        { 0x061B, 24 }, { 0x061C, 16 }, { 0x061D, 24 }, { 0x0620, 5 }, { 0x0640, 4 }, { 0x0641, 5 },
+        { 0x064B, 6 }, { 0x0660, 9 }, { 0x066A, 24 }, { 0x066E, 5 }, { 0x0670, 6 }, { 0x0671, 5 },
+        { 0x06D4, 24 }, { 0x06D5, 5 }, { 0x06D6, 6 }, { 0x06DD, 16 }, { 0x06DE, 28 }, { 0x06DF, 6 },
+        { 0x06E5, 4 }, { 0x06E7, 6 }, { 0x06E9, 28 }, { 0x06EA, 6 }, { 0x06EE, 5 }, { 0x06F0, 9 },
+        { 0x06FA, 5 }, { 0x06FD, 28 }, { 0x06FF, 5 }, { 0x0700, 24 }, { 0x070E, 0 }, { 0x070F, 16 },
+        { 0x0710, 5 }, { 0x0711, 6 }, { 0x0712, 5 }, { 0x0730, 6 }, { 0x074B, 0 }, { 0x074D, 5 },
+        { 0x07A6, 6 }, { 0x07B1, 5 }, { 0x07B2, 0 }, { 0x07C0, 9 }, { 0x07CA, 5 }, { 0x07EB, 6 },
+        { 0x07F4, 4 }, { 0x07F6, 28 }, { 0x07F7, 24 }, { 0x07FA, 4 }, { 0x07FB, 0 }, { 0x07FD, 6 },
+        { 0x07FE, 26 }, { 0x0800, 5 }, { 0x0816, 6 }, { 0x081A, 4 }, { 0x081B, 6 }, { 0x0824, 4 },
+        { 0x0825, 6 }, { 0x0828, 4 }, { 0x0829, 6 }, { 0x082E, 0 }, { 0x0830, 24 }, { 0x083F, 0 },
+        { 0x0840, 5 }, { 0x0859, 6 }, { 0x085C, 0 }, { 0x085E, 24 }, { 0x085F, 0 }, { 0x0860, 5 },
+        { 0x086B, 0 }, { 0x0870, 5 }, { 0x0888, 27 }, { 0x0889, 5 }, { 0x088F, 0 }, { 0x0890, 16 },
+        { 0x0892, 0 }, { 0x0898, 6 }, { 0x08A0, 5 }, { 0x08C9, 4 }, { 0x08CA, 6 }, { 0x08E2, 16 },
+        { 0x08E3, 6 }, { 0x0903, 8 }, { 0x0904, 5 }, { 0x093A, 6 }, { 0x093B, 8 }, { 0x093C, 6 },
+        { 0x093D, 5 }, { 0x093E, 8 }, { 0x0941, 6 }, { 0x0949, 8 }, { 0x094D, 6 }, { 0x094E, 8 },
+        { 0x0950, 5 }, { 0x0951, 6 }, { 0x0958, 5 }, { 0x0962, 6 }, { 0x0964, 24 }, { 0x0966, 9 },
+        { 0x0970, 24 }, { 0x0971, 4 }, { 0x0972, 5 }, { 0x0981, 6 }, { 0x0982, 8 }, { 0x0984, 0 },
+        { 0x0985, 5 }, { 0x098D, 0 }, { 0x098F, 5 }, { 0x0991, 0 }, { 0x0993, 5 }, { 0x09A9, 0 },
+        { 0x09AA, 5 }, { 0x09B1, 0 }, { 0x09B2, 5 }, { 0x09B3, 0 }, { 0x09B6, 5 }, { 0x09BA, 0 },
+        { 0x09BC, 6 }, { 0x09BD, 5 }, { 0x09BE, 8 }, { 0x09C1, 6 }, { 0x09C5, 0 }, { 0x09C7, 8 },
+        { 0x09C9, 0 }, { 0x09CB, 8 }, { 0x09CD, 6 }, { 0x09CE, 5 }, { 0x09CF, 0 }, { 0x09D7, 8 },
+        { 0x09D8, 0 }, { 0x09DC, 5 }, { 0x09DE, 0 }, { 0x09DF, 5 }, { 0x09E2, 6 }, { 0x09E4, 0 },
+        { 0x09E6, 9 }, { 0x09F0, 5 }, { 0x09F2, 26 }, { 0x09F4, 11 }, { 0x09FA, 28 }, { 0x09FB, 26 },
+        { 0x09FC, 5 }, { 0x09FD, 24 }, { 0x09FE, 6 }, { 0x09FF, 0 }, { 0x0A01, 6 }, { 0x0A03, 8 },
+        { 0x0A04, 0 }, { 0x0A05, 5 }, { 0x0A0B, 0 }, { 0x0A0F, 5 }, { 0x0A11, 0 }, { 0x0A13, 5 },
+        { 0x0A29, 0 }, { 0x0A2A, 5 }, { 0x0A31, 0 }, { 0x0A32, 5 }, { 0x0A34, 0 }, { 0x0A35, 5 },
+        { 0x0A37, 0 }, { 0x0A38, 5 }, { 0x0A3A, 0 }, { 0x0A3C, 6 }, { 0x0A3D, 0 }, { 0x0A3E, 8 },
+        { 0x0A41, 6 }, { 0x0A43, 0 }, { 0x0A47, 6 }, { 0x0A49, 0 }, { 0x0A4B, 6 }, { 0x0A4E, 0 },
+        { 0x0A51, 6 }, { 0x0A52, 0 }, { 0x0A59, 5 }, { 0x0A5D, 0 }, { 0x0A5E, 5 }, { 0x0A5F, 0 },
+        { 0x0A66, 9 }, { 0x0A70, 6 }, { 0x0A72, 5 }, { 0x0A75, 6 }, { 0x0A76, 24 }, { 0x0A77, 0 },
+        { 0x0A81, 6 }, { 0x0A83, 8 }, { 0x0A84, 0 }, { 0x0A85, 5 }, { 0x0A8E, 0 }, { 0x0A8F, 5 },
+        { 0x0A92, 0 }, { 0x0A93, 5 }, { 0x0AA9, 0 }, { 0x0AAA, 5 }, { 0x0AB1, 0 }, { 0x0AB2, 5 },
+        { 0x0AB4, 0 }, { 0x0AB5, 5 }, { 0x0ABA, 0 }, { 0x0ABC, 6 }, { 0x0ABD, 5 }, { 0x0ABE, 8 },
+        { 0x0AC1, 6 }, { 0x0AC6, 0 }, { 0x0AC7, 6 }, { 0x0AC9, 8 }, { 0x0ACA, 0 }, { 0x0ACB, 8 },
+        { 0x0ACD, 6 }, { 0x0ACE, 0 }, { 0x0AD0, 5 }, { 0x0AD1, 0 }, { 0x0AE0, 5 }, { 0x0AE2, 6 },
+        { 0x0AE4, 0 }, { 0x0AE6, 9 }, { 0x0AF0, 24 }, { 0x0AF1, 26 }, { 0x0AF2, 0 }, { 0x0AF9, 5 },
+        { 0x0AFA, 6 }, { 0x0B00, 0 }, { 0x0B01, 6 }, { 0x0B02, 8 }, { 0x0B04, 0 }, { 0x0B05, 5 },
+        { 0x0B0D, 0 }, { 0x0B0F, 5 }, { 0x0B11, 0 }, { 0x0B13, 5 }, { 0x0B29, 0 }, { 0x0B2A, 5 },
+        { 0x0B31, 0 }, { 0x0B32, 5 }, { 0x0B34, 0 }, { 0x0B35, 5 }, { 0x0B3A, 0 }, { 0x0B3C, 6 },
+        { 0x0B3D, 5 }, { 0x0B3E, 8 }, { 0x0B3F, 6 }, { 0x0B40, 8 }, { 0x0B41, 6 }, { 0x0B45, 0 },
+        { 0x0B47, 8 }, { 0x0B49, 0 }, { 0x0B4B, 8 }, { 0x0B4D, 6 }, { 0x0B4E, 0 }, { 0x0B55, 6 },
+        { 0x0B57, 8 }, { 0x0B58, 0 }, { 0x0B5C, 5 }, { 0x0B5E, 0 }, { 0x0B5F, 5 }, { 0x0B62, 6 },
+        { 0x0B64, 0 }, { 0x0B66, 9 }, { 0x0B70, 28 }, { 0x0B71, 5 }, { 0x0B72, 11 }, { 0x0B78, 0 },
+        { 0x0B82, 6 }, { 0x0B83, 5 }, { 0x0B84, 0 }, { 0x0B85, 5 }, { 0x0B8B, 0 }, { 0x0B8E, 5 },
+        { 0x0B91, 0 }, { 0x0B92, 5 }, { 0x0B96, 0 }, { 0x0B99, 5 }, { 0x0B9B, 0 }, { 0x0B9C, 5 },
+        { 0x0B9D, 0 }, { 0x0B9E, 5 }, { 0x0BA0, 0 }, { 0x0BA3, 5 }, { 0x0BA5, 0 }, { 0x0BA8, 5 },
+        { 0x0BAB, 0 }, { 0x0BAE, 5 }, { 0x0BBA, 0 }, { 0x0BBE, 8 }, { 0x0BC0, 6 }, { 0x0BC1, 8 },
+        { 0x0BC3, 0 }, { 0x0BC6, 8 }, { 0x0BC9, 0 }, { 0x0BCA, 8 }, { 0x0BCD, 6 }, { 0x0BCE, 0 },
+        { 0x0BD0, 5 }, { 0x0BD1, 0 }, { 0x0BD7, 8 }, { 0x0BD8, 0 }, { 0x0BE6, 9 }, { 0x0BF0, 11 },
+        { 0x0BF3, 28 }, { 0x0BF9, 26 }, { 0x0BFA, 28 }, { 0x0BFB, 0 }, { 0x0C00, 6 }, { 0x0C01, 8 },
+        { 0x0C04, 6 }, { 0x0C05, 5 }, { 0x0C0D, 0 }, { 0x0C0E, 5 }, { 0x0C11, 0 }, { 0x0C12, 5 },
+        { 0x0C29, 0 }, { 0x0C2A, 5 }, { 0x0C3A, 0 }, { 0x0C3C, 6 }, { 0x0C3D, 5 }, { 0x0C3E, 6 },
+        { 0x0C41, 8 }, { 0x0C45, 0 }, { 0x0C46, 6 }, { 0x0C49, 0 }, { 0x0C4A, 6 }, { 0x0C4E, 0 },
+        { 0x0C55, 6 }, { 0x0C57, 0 }, { 0x0C58, 5 }, { 0x0C5B, 0 }, { 0x0C5D, 5 }, { 0x0C5E, 0 },
+        { 0x0C60, 5 }, { 0x0C62, 6 }, { 0x0C64, 0 }, { 0x0C66, 9 }, { 0x0C70, 0 }, { 0x0C77, 24 },
+        { 0x0C78, 11 }, { 0x0C7F, 28 }, { 0x0C80, 5 }, { 0x0C81, 6 }, { 0x0C82, 8 }, { 0x0C84, 24 },
+        { 0x0C85, 5 }, { 0x0C8D, 0 }, { 0x0C8E, 5 }, { 0x0C91, 0 }, { 0x0C92, 5 }, { 0x0CA9, 0 },
+        { 0x0CAA, 5 }, { 0x0CB4, 0 }, { 0x0CB5, 5 }, { 0x0CBA, 0 }, { 0x0CBC, 6 }, { 0x0CBD, 5 },
+        { 0x0CBE, 8 }, { 0x0CBF, 6 }, { 0x0CC0, 8 }, { 0x0CC5, 0 }, { 0x0CC6, 6 }, { 0x0CC7, 8 },
+        { 0x0CC9, 0 }, { 0x0CCA, 8 }, { 0x0CCC, 6 }, { 0x0CCE, 0 }, { 0x0CD5, 8 }, { 0x0CD7, 0 },
+        { 0x0CDD, 5 }, { 0x0CDF, 0 }, { 0x0CE0, 5 }, { 0x0CE2, 6 }, { 0x0CE4, 0 }, { 0x0CE6, 9 },
+        { 0x0CF0, 0 }, { 0x0CF1, 5 }, { 0x0CF3, 0 }, { 0x0D00, 6 }, { 0x0D02, 8 }, { 0x0D04, 5 },
+        { 0x0D0D, 0 }, { 0x0D0E, 5 }, { 0x0D11, 0 }, { 0x0D12, 5 }, { 0x0D3B, 6 }, { 0x0D3D, 5 },
+        { 0x0D3E, 8 }, { 0x0D41, 6 }, { 0x0D45, 0 }, { 0x0D46, 8 }, { 0x0D49, 0 }, { 0x0D4A, 8 },
+        { 0x0D4D, 6 }, { 0x0D4E, 5 }, { 0x0D4F, 28 }, { 0x0D50, 0 }, { 0x0D54, 5 }, { 0x0D57, 8 },
+        { 0x0D58, 11 }, { 0x0D5F, 5 }, { 0x0D62, 6 }, { 0x0D64, 0 }, { 0x0D66, 9 }, { 0x0D70, 11 },
+        { 0x0D79, 28 }, { 0x0D7A, 5 }, { 0x0D80, 0 }, { 0x0D81, 6 }, { 0x0D82, 8 }, { 0x0D84, 0 },
+        { 0x0D85, 5 }, { 0x0D97, 0 }, { 0x0D9A, 5 }, { 0x0DB2, 0 }, { 0x0DB3, 5 }, { 0x0DBC, 0 },
+        { 0x0DBD, 5 }, { 0x0DBE, 0 }, { 0x0DC0, 5 }, { 0x0DC7, 0 }, { 0x0DCA, 6 }, { 0x0DCB, 0 },
+        { 0x0DCF, 8 }, { 0x0DD2, 6 }, { 0x0DD5, 0 }, { 0x0DD6, 6 }, { 0x0DD7, 0 }, { 0x0DD8, 8 },
+        { 0x0DE0, 0 }, { 0x0DE6, 9 }, { 0x0DF0, 0 }, { 0x0DF2, 8 }, { 0x0DF4, 24 }, { 0x0DF5, 0 },
+        { 0x0E01, 5 }, { 0x0E31, 6 }, { 0x0E32, 5 }, { 0x0E34, 6 }, { 0x0E3B, 0 }, { 0x0E3F, 26 },
+        { 0x0E40, 5 }, { 0x0E46, 4 }, { 0x0E47, 6 }, { 0x0E4F, 24 }, { 0x0E50, 9 }, { 0x0E5A, 24 },
+        { 0x0E5C, 0 }, { 0x0E81, 5 }, { 0x0E83, 0 }, { 0x0E84, 5 }, { 0x0E85, 0 }, { 0x0E86, 5 },
+        { 0x0E8B, 0 }, { 0x0E8C, 5 }, { 0x0EA4, 0 }, { 0x0EA5, 5 }, { 0x0EA6, 0 }, { 0x0EA7, 5 },
+        { 0x0EB1, 6 }, { 0x0EB2, 5 }, { 0x0EB4, 6 }, { 0x0EBD, 5 }, { 0x0EBE, 0 }, { 0x0EC0, 5 },
+        { 0x0EC5, 0 }, { 0x0EC6, 4 }, { 0x0EC7, 0 }, { 0x0EC8, 6 }, { 0x0ECE, 0 }, { 0x0ED0, 9 },
+        { 0x0EDA, 0 }, { 0x0EDC, 5 }, { 0x0EE0, 0 }, { 0x0F00, 5 }, { 0x0F01, 28 }, { 0x0F04, 24 },
+        { 0x0F13, 28 }, { 0x0F14, 24 }, { 0x0F15, 28 }, { 0x0F18, 6 }, { 0x0F1A, 28 }, { 0x0F20, 9 },
+        { 0x0F2A, 11 }, { 0x0F34, 28 }, { 0x0F35, 6 }, { 0x0F36, 28 }, { 0x0F37, 6 }, { 0x0F38, 28 },
+        { 0x0F39, 6 }, { 0x0F3A, 21 }, { 0x0F3B, 22 }, { 0x0F3C, 21 }, { 0x0F3D, 22 }, { 0x0F3E, 8 },
+        { 0x0F40, 5 }, { 0x0F48, 0 }, { 0x0F49, 5 }, { 0x0F6D, 0 }, { 0x0F71, 6 }, { 0x0F7F, 8 },
+        { 0x0F80, 6 }, { 0x0F85, 24 }, { 0x0F86, 6 }, { 0x0F88, 5 }, { 0x0F8D, 6 }, { 0x0F98, 0 },
+        { 0x0F99, 6 }, { 0x0FBD, 0 }, { 0x0FBE, 28 }, { 0x0FC6, 6 }, { 0x0FC7, 28 }, { 0x0FCD, 0 },
+        { 0x0FCE, 28 }, { 0x0FD0, 24 }, { 0x0FD5, 28 }, { 0x0FD9, 24 }, { 0x0FDB, 0 }, { 0x1000, 5 },
+        { 0x102B, 8 }, { 0x102D, 6 }, { 0x1031, 8 }, { 0x1032, 6 }, { 0x1038, 8 }, { 0x1039, 6 },
+        { 0x103B, 8 }, { 0x103D, 6 }, { 0x103F, 5 }, { 0x1040, 9 }, { 0x104A, 24 }, { 0x1050, 5 },
+        { 0x1056, 8 }, { 0x1058, 6 }, { 0x105A, 5 }, { 0x105E, 6 }, { 0x1061, 5 }, { 0x1062, 8 },
+        { 0x1065, 5 }, { 0x1067, 8 }, { 0x106E, 5 }, { 0x1071, 6 }, { 0x1075, 5 }, { 0x1082, 6 },
+        { 0x1083, 8 }, { 0x1085, 6 }, { 0x1087, 8 }, { 0x108D, 6 }, { 0x108E, 5 }, { 0x108F, 8 },
+        { 0x1090, 9 }, { 0x109A, 8 }, { 0x109D, 6 }, { 0x109E, 28 }, { 0x10A0, 1 }, { 0x10C6, 0 },
+        { 0x10C7, 1 }, { 0x10C8, 0 }, { 0x10CD, 1 }, { 0x10CE, 0 }, { 0x10D0, 2 }, { 0x10FB, 24 },
+        { 0x10FC, 4 }, { 0x10FD, 2 }, { 0x1100, 5 }, { 0x1249, 0 }, { 0x124A, 5 }, { 0x124E, 0 },
+        { 0x1250, 5 }, { 0x1257, 0 }, { 0x1258, 5 }, { 0x1259, 0 }, { 0x125A, 5 }, { 0x125E, 0 },
+        { 0x1260, 5 }, { 0x1289, 0 }, { 0x128A, 5 }, { 0x128E, 0 }, { 0x1290, 5 }, { 0x12B1, 0 },
+        { 0x12B2, 5 }, { 0x12B6, 0 }, { 0x12B8, 5 }, { 0x12BF, 0 }, { 0x12C0, 5 }, { 0x12C1, 0 },
+        { 0x12C2, 5 }, { 0x12C6, 0 }, { 0x12C8, 5 }, { 0x12D7, 0 }, { 0x12D8, 5 }, { 0x1311, 0 },
+        { 0x1312, 5 }, { 0x1316, 0 }, { 0x1318, 5 }, { 0x135B, 0 }, { 0x135D, 6 }, { 0x1360, 24 },
+        { 0x1369, 11 }, { 0x137D, 0 }, { 0x1380, 5 }, { 0x1390, 28 }, { 0x139A, 0 }, { 0x13A0, 1 },
+        { 0x13F6, 0 }, { 0x13F8, 2 }, { 0x13FE, 0 }, { 0x1400, 20 }, { 0x1401, 5 }, { 0x166D, 28 },
+        { 0x166E, 24 }, { 0x166F, 5 }, { 0x1680, 12 }, { 0x1681, 5 }, { 0x169B, 21 }, { 0x169C, 22 },
+        { 0x169D, 0 }, { 0x16A0, 5 }, { 0x16EB, 24 }, { 0x16EE, 10 }, { 0x16F1, 5 }, { 0x16F9, 0 },
+        { 0x1700, 5 }, { 0x1712, 6 }, { 0x1715, 8 }, { 0x1716, 0 }, { 0x171F, 5 }, { 0x1732, 6 },
+        { 0x1734, 8 }, { 0x1735, 24 }, { 0x1737, 0 }, { 0x1740, 5 }, { 0x1752, 6 }, { 0x1754, 0 },
+        { 0x1760, 5 }, { 0x176D, 0 }, { 0x176E, 5 }, { 0x1771, 0 }, { 0x1772, 6 }, { 0x1774, 0 },
+        { 0x1780, 5 }, { 0x17B4, 6 }, { 0x17B6, 8 }, { 0x17B7, 6 }, { 0x17BE, 8 }, { 0x17C6, 6 },
+        { 0x17C7, 8 }, { 0x17C9, 6 }, { 0x17D4, 24 }, { 0x17D7, 4 }, { 0x17D8, 24 }, { 0x17DB, 26 },
+        { 0x17DC, 5 }, { 0x17DD, 6 }, { 0x17DE, 0 }, { 0x17E0, 9 }, { 0x17EA, 0 }, { 0x17F0, 11 },
+        { 0x17FA, 0 }, { 0x1800, 24 }, { 0x1806, 20 }, { 0x1807, 24 }, { 0x180B, 6 }, { 0x180E, 16 },
+        { 0x180F, 6 }, { 0x1810, 9 }, { 0x181A, 0 }, { 0x1820, 5 }, { 0x1843, 4 }, { 0x1844, 5 },
+        { 0x1879, 0 }, { 0x1880, 5 }, { 0x1885, 6 }, { 0x1887, 5 }, { 0x18A9, 6 }, { 0x18AA, 5 },
+        { 0x18AB, 0 }, { 0x18B0, 5 }, { 0x18F6, 0 }, { 0x1900, 5 }, { 0x191F, 0 }, { 0x1920, 6 },
+        { 0x1923, 8 }, { 0x1927, 6 }, { 0x1929, 8 }, { 0x192C, 0 }, { 0x1930, 8 }, { 0x1932, 6 },
+        { 0x1933, 8 }, { 0x1939, 6 }, { 0x193C, 0 }, { 0x1940, 28 }, { 0x1941, 0 }, { 0x1944, 24 },
+        { 0x1946, 9 }, { 0x1950, 5 }, { 0x196E, 0 }, { 0x1970, 5 }, { 0x1975, 0 }, { 0x1980, 5 },
+        { 0x19AC, 0 }, { 0x19B0, 5 }, { 0x19CA, 0 }, { 0x19D0, 9 }, { 0x19DA, 11 }, { 0x19DB, 0 },
+        { 0x19DE, 28 }, { 0x1A00, 5 }, { 0x1A17, 6 }, { 0x1A19, 8 }, { 0x1A1B, 6 }, { 0x1A1C, 0 },
+        { 0x1A1E, 24 }, { 0x1A20, 5 }, { 0x1A55, 8 }, { 0x1A56, 6 }, { 0x1A57, 8 }, { 0x1A58, 6 },
+        { 0x1A5F, 0 }, { 0x1A60, 6 }, { 0x1A61, 8 }, { 0x1A62, 6 }, { 0x1A63, 8 }, { 0x1A65, 6 },
+        { 0x1A6D, 8 }, { 0x1A73, 6 }, { 0x1A7D, 0 }, { 0x1A7F, 6 }, { 0x1A80, 9 }, { 0x1A8A, 0 },
+        { 0x1A90, 9 }, { 0x1A9A, 0 }, { 0x1AA0, 24 }, { 0x1AA7, 4 }, { 0x1AA8, 24 }, { 0x1AAE, 0 },
+        { 0x1AB0, 6 }, { 0x1ABE, 7 }, { 0x1ABF, 6 }, { 0x1ACF, 0 }, { 0x1B00, 6 }, { 0x1B04, 8 },
+        { 0x1B05, 5 }, { 0x1B34, 6 }, { 0x1B35, 8 }, { 0x1B36, 6 }, { 0x1B3B, 8 }, { 0x1B3C, 6 },
+        { 0x1B3D, 8 }, { 0x1B42, 6 }, { 0x1B43, 8 }, { 0x1B45, 5 }, { 0x1B4D, 0 }, { 0x1B50, 9 },
+        { 0x1B5A, 24 }, { 0x1B61, 28 }, { 0x1B6B, 6 }, { 0x1B74, 28 }, { 0x1B7D, 24 }, { 0x1B7F, 0 },
+        { 0x1B80, 6 }, { 0x1B82, 8 }, { 0x1B83, 5 }, { 0x1BA1, 8 }, { 0x1BA2, 6 }, { 0x1BA6, 8 },
+        { 0x1BA8, 6 }, { 0x1BAA, 8 }, { 0x1BAB, 6 }, { 0x1BAE, 5 }, { 0x1BB0, 9 }, { 0x1BBA, 5 },
+        { 0x1BE6, 6 }, { 0x1BE7, 8 }, { 0x1BE8, 6 }, { 0x1BEA, 8 }, { 0x1BED, 6 }, { 0x1BEE, 8 },
+        { 0x1BEF, 6 }, { 0x1BF2, 8 }, { 0x1BF4, 0 }, { 0x1BFC, 24 }, { 0x1C00, 5 }, { 0x1C24, 8 },
+        { 0x1C2C, 6 }, { 0x1C34, 8 }, { 0x1C36, 6 }, { 0x1C38, 0 }, { 0x1C3B, 24 }, { 0x1C40, 9 },
+        { 0x1C4A, 0 }, { 0x1C4D, 5 }, { 0x1C50, 9 }, { 0x1C5A, 5 }, { 0x1C78, 4 }, { 0x1C7E, 24 },
+        { 0x1C80, 2 }, { 0x1C89, 0 }, { 0x1C90, 1 }, { 0x1CBB, 0 }, { 0x1CBD, 1 }, { 0x1CC0, 24 },
+        { 0x1CC8, 0 }, { 0x1CD0, 6 }, { 0x1CD3, 24 }, { 0x1CD4, 6 }, { 0x1CE1, 8 }, { 0x1CE2, 6 },
+        { 0x1CE9, 5 }, { 0x1CED, 6 }, { 0x1CEE, 5 }, { 0x1CF4, 6 }, { 0x1CF5, 5 }, { 0x1CF7, 8 },
+        { 0x1CF8, 6 }, { 0x1CFA, 5 }, { 0x1CFB, 0 }, { 0x1D00, 2 }, { 0x1D2C, 4 }, { 0x1D6B, 2 },
+        { 0x1D78, 4 }, { 0x1D79, 2 }, { 0x1D9B, 4 }, { 0x1DC0, 6 }, { 0x1E00, 1 }, { 0x1E01, 2 },
+        { 0x1E02, 1 }, { 0x1E03, 2 }, { 0x1E04, 1 }, { 0x1E05, 2 }, { 0x1E06, 1 }, { 0x1E07, 2 },
+        { 0x1E08, 1 }, { 0x1E09, 2 }, { 0x1E0A, 1 }, { 0x1E0B, 2 }, { 0x1E0C, 1 }, { 0x1E0D, 2 },
+        { 0x1E0E, 1 }, { 0x1E0F, 2 }, { 0x1E10, 1 }, { 0x1E11, 2 }, { 0x1E12, 1 }, { 0x1E13, 2 },
+        { 0x1E14, 1 }, { 0x1E15, 2 }, { 0x1E16, 1 }, { 0x1E17, 2 }, { 0x1E18, 1 }, { 0x1E19, 2 },
+        { 0x1E1A, 1 }, { 0x1E1B, 2 }, { 0x1E1C, 1 }, { 0x1E1D, 2 }, { 0x1E1E, 1 }, { 0x1E1F, 2 },
+        { 0x1E20, 1 }, { 0x1E21, 2 }, { 0x1E22, 1 }, { 0x1E23, 2 }, { 0x1E24, 1 }, { 0x1E25, 2 },
+        { 0x1E26, 1 }, { 0x1E27, 2 }, { 0x1E28, 1 }, { 0x1E29, 2 }, { 0x1E2A, 1 }, { 0x1E2B, 2 },
+        { 0x1E2C, 1 }, { 0x1E2D, 2 }, { 0x1E2E, 1 }, { 0x1E2F, 2 }, { 0x1E30, 1 }, { 0x1E31, 2 },
+        { 0x1E32, 1 }, { 0x1E33, 2 }, { 0x1E34, 1 }, { 0x1E35, 2 }, { 0x1E36, 1 }, { 0x1E37, 2 },
+        { 0x1E38, 1 }, { 0x1E39, 2 }, { 0x1E3A, 1 }, { 0x1E3B, 2 }, { 0x1E3C, 1 }, { 0x1E3D, 2 },
+        { 0x1E3E, 1 }, { 0x1E3F, 2 }, { 0x1E40, 1 }, { 0x1E41, 2 }, { 0x1E42, 1 }, { 0x1E43, 2 },
+        { 0x1E44, 1 }, { 0x1E45, 2 }, { 0x1E46, 1 }, { 0x1E47, 2 }, { 0x1E48, 1 }, { 0x1E49, 2 },
+        { 0x1E4A, 1 }, { 0x1E4B, 2 }, { 0x1E4C, 1 }, { 0x1E4D, 2 }, { 0x1E4E, 1 }, { 0x1E4F, 2 },
+        { 0x1E50, 1 }, { 0x1E51, 2 }, { 0x1E52, 1 }, { 0x1E53, 2 }, { 0x1E54, 1 }, { 0x1E55, 2 },
+        { 0x1E56, 1 }, { 0x1E57, 2 }, { 0x1E58, 1 }, { 0x1E59, 2 }, { 0x1E5A, 1 }, { 0x1E5B, 2 },
+        { 0x1E5C, 1 }, { 0x1E5D, 2 }, { 0x1E5E, 1 }, { 0x1E5F, 2 }, { 0x1E60, 1 }, { 0x1E61, 2 },
+        { 0x1E62, 1 }, { 0x1E63, 2 }, { 0x1E64, 1 }, { 0x1E65, 2 }, { 0x1E66, 1 }, { 0x1E67, 2 },
+        { 0x1E68, 1 }, { 0x1E69, 2 }, { 0x1E6A, 1 }, { 0x1E6B, 2 }, { 0x1E6C, 1 }, { 0x1E6D, 2 },
+        { 0x1E6E, 1 }, { 0x1E6F, 2 }, { 0x1E70, 1 }, { 0x1E71, 2 }, { 0x1E72, 1 }, { 0x1E73, 2 },
+        { 0x1E74, 1 }, { 0x1E75, 2 }, { 0x1E76, 1 }, { 0x1E77, 2 }, { 0x1E78, 1 }, { 0x1E79, 2 },
+        { 0x1E7A, 1 }, { 0x1E7B, 2 }, { 0x1E7C, 1 }, { 0x1E7D, 2 }, { 0x1E7E, 1 }, { 0x1E7F, 2 },
+        { 0x1E80, 1 }, { 0x1E81, 2 }, { 0x1E82, 1 }, { 0x1E83, 2 }, { 0x1E84, 1 }, { 0x1E85, 2 },
+        { 0x1E86, 1 }, { 0x1E87, 2 }, { 0x1E88, 1 }, { 0x1E89, 2 }, { 0x1E8A, 1 }, { 0x1E8B, 2 },
+        { 0x1E8C, 1 }, { 0x1E8D, 2 }, { 0x1E8E, 1 }, { 0x1E8F, 2 }, { 0x1E90, 1 }, { 0x1E91, 2 },
+        { 0x1E92, 1 }, { 0x1E93, 2 }, { 0x1E94, 1 }, { 0x1E95, 2 }, { 0x1E9E, 1 }, { 0x1E9F, 2 },
+        { 0x1EA0, 1 }, { 0x1EA1, 2 }, { 0x1EA2, 1 }, { 0x1EA3, 2 }, { 0x1EA4, 1 }, { 0x1EA5, 2 },
+        { 0x1EA6, 1 }, { 0x1EA7, 2 }, { 0x1EA8, 1 }, { 0x1EA9, 2 }, { 0x1EAA, 1 }, { 0x1EAB, 2 },
+        { 0x1EAC, 1 }, { 0x1EAD, 2 }, { 0x1EAE, 1 }, { 0x1EAF, 2 }, { 0x1EB0, 1 }, { 0x1EB1, 2 },
+        { 0x1EB2, 1 }, { 0x1EB3, 2 }, { 0x1EB4, 1 }, { 0x1EB5, 2 }, { 0x1EB6, 1 }, { 0x1EB7, 2 },
+        { 0x1EB8, 1 }, { 0x1EB9, 2 }, { 0x1EBA, 1 }, { 0x1EBB, 2 }, { 0x1EBC, 1 }, { 0x1EBD, 2 },
+        { 0x1EBE, 1 }, { 0x1EBF, 2 }, { 0x1EC0, 1 }, { 0x1EC1, 2 }, { 0x1EC2, 1 }, { 0x1EC3, 2 },
+        { 0x1EC4, 1 }, { 0x1EC5, 2 }, { 0x1EC6, 1 }, { 0x1EC7, 2 }, { 0x1EC8, 1 }, { 0x1EC9, 2 },
+        { 0x1ECA, 1 }, { 0x1ECB, 2 }, { 0x1ECC, 1 }, { 0x1ECD, 2 }, { 0x1ECE, 1 }, { 0x1ECF, 2 },
+        { 0x1ED0, 1 }, { 0x1ED1, 2 }, { 0x1ED2, 1 }, { 0x1ED3, 2 }, { 0x1ED4, 1 }, { 0x1ED5, 2 },
+        { 0x1ED6, 1 }, { 0x1ED7, 2 }, { 0x1ED8, 1 }, { 0x1ED9, 2 }, { 0x1EDA, 1 }, { 0x1EDB, 2 },
+        { 0x1EDC, 1 }, { 0x1EDD, 2 }, { 0x1EDE, 1 }, { 0x1EDF, 2 }, { 0x1EE0, 1 }, { 0x1EE1, 2 },
+        { 0x1EE2, 1 }, { 0x1EE3, 2 }, { 0x1EE4, 1 }, { 0x1EE5, 2 }, { 0x1EE6, 1 }, { 0x1EE7, 2 },
+        { 0x1EE8, 1 }, { 0x1EE9, 2 }, { 0x1EEA, 1 }, { 0x1EEB, 2 }, { 0x1EEC, 1 }, { 0x1EED, 2 },
+        { 0x1EEE, 1 }, { 0x1EEF, 2 }, { 0x1EF0, 1 }, { 0x1EF1, 2 }, { 0x1EF2, 1 }, { 0x1EF3, 2 },
+        { 0x1EF4, 1 }, { 0x1EF5, 2 }, { 0x1EF6, 1 }, { 0x1EF7, 2 }, { 0x1EF8, 1 }, { 0x1EF9, 2 },
+        { 0x1EFA, 1 }, { 0x1EFB, 2 }, { 0x1EFC, 1 }, { 0x1EFD, 2 }, { 0x1EFE, 1 }, { 0x1EFF, 2 },
+        { 0x1F08, 1 }, { 0x1F10, 2 }, { 0x1F16, 0 }, { 0x1F18, 1 }, { 0x1F1E, 0 }, { 0x1F20, 2 },
+        { 0x1F28, 1 }, { 0x1F30, 2 }, { 0x1F38, 1 }, { 0x1F40, 2 }, { 0x1F46, 0 }, { 0x1F48, 1 },
+        { 0x1F4E, 0 }, { 0x1F50, 2 }, { 0x1F58, 0 }, { 0x1F59, 1 }, { 0x1F5A, 0 }, { 0x1F5B, 1 },
+        { 0x1F5C, 0 }, { 0x1F5D, 1 }, { 0x1F5E, 0 }, { 0x1F5F, 1 }, { 0x1F60, 2 }, { 0x1F68, 1 },
+        { 0x1F70, 2 }, { 0x1F7E, 0 }, { 0x1F80, 2 }, { 0x1F88, 3 }, { 0x1F90, 2 }, { 0x1F98, 3 },
+        { 0x1FA0, 2 }, { 0x1FA8, 3 }, { 0x1FB0, 2 }, { 0x1FB5, 0 }, { 0x1FB6, 2 }, { 0x1FB8, 1 },
+        { 0x1FBC, 3 }, { 0x1FBD, 27 }, { 0x1FBE, 2 }, { 0x1FBF, 27 }, { 0x1FC2, 2 }, { 0x1FC5, 0 },
+        { 0x1FC6, 2 }, { 0x1FC8, 1 }, { 0x1FCC, 3 }, { 0x1FCD, 27 }, { 0x1FD0, 2 }, { 0x1FD4, 0 },
+        { 0x1FD6, 2 }, { 0x1FD8, 1 }, { 0x1FDC, 0 }, { 0x1FDD, 27 }, { 0x1FE0, 2 }, { 0x1FE8, 1 },
+        { 0x1FED, 27 }, { 0x1FF0, 0 }, { 0x1FF2, 2 }, { 0x1FF5, 0 }, { 0x1FF6, 2 }, { 0x1FF8, 1 },
+        { 0x1FFC, 3 }, { 0x1FFD, 27 }, { 0x1FFF, 0 }, { 0x2000, 12 }, { 0x200B, 16 }, { 0x2010, 20 },
+        { 0x2016, 24 }, { 0x2018, 29 }, { 0x2019, 30 }, { 0x201A, 21 }, { 0x201B, 29 }, { 0x201D, 30 },
+        { 0x201E, 21 }, { 0x201F, 29 }, { 0x2020, 24 }, { 0x2028, 13 }, { 0x2029, 14 }, { 0x202A, 16 },
+        { 0x202F, 12 }, { 0x2030, 24 }, { 0x2039, 29 }, { 0x203A, 30 }, { 0x203B, 24 }, { 0x203F, 23 },
+        { 0x2041, 24 }, { 0x2044, 25 }, { 0x2045, 21 }, { 0x2046, 22 }, { 0x2047, 24 }, { 0x2052, 25 },
+        { 0x2053, 24 }, { 0x2054, 23 }, { 0x2055, 24 }, { 0x205F, 12 }, { 0x2060, 16 }, { 0x2065, 0 },
+        { 0x2066, 16 }, { 0x2070, 11 }, { 0x2071, 4 }, { 0x2072, 0 }, { 0x2074, 11 }, { 0x207A, 25 },
+        { 0x207D, 21 }, { 0x207E, 22 }, { 0x207F, 4 }, { 0x2080, 11 }, { 0x208A, 25 }, { 0x208D, 21 },
+        { 0x208E, 22 }, { 0x208F, 0 }, { 0x2090, 4 }, { 0x209D, 0 }, { 0x20A0, 26 }, { 0x20C1, 0 },
+        { 0x20D0, 6 }, { 0x20DD, 7 }, { 0x20E1, 6 }, { 0x20E2, 7 }, { 0x20E5, 6 }, { 0x20F1, 0 },
+        { 0x2100, 28 }, { 0x2102, 1 }, { 0x2103, 28 }, { 0x2107, 1 }, { 0x2108, 28 }, { 0x210A, 2 },
+        { 0x210B, 1 }, { 0x210E, 2 }, { 0x2110, 1 }, { 0x2113, 2 }, { 0x2114, 28 }, { 0x2115, 1 },
+        { 0x2116, 28 }, { 0x2118, 25 }, { 0x2119, 1 }, { 0x211E, 28 }, { 0x2124, 1 }, { 0x2125, 28 },
+        { 0x2126, 1 }, { 0x2127, 28 }, { 0x2128, 1 }, { 0x2129, 28 }, { 0x212A, 1 }, { 0x212E, 28 },
+        { 0x212F, 2 }, { 0x2130, 1 }, { 0x2134, 2 }, { 0x2135, 5 }, { 0x2139, 2 }, { 0x213A, 28 },
+        { 0x213C, 2 }, { 0x213E, 1 }, { 0x2140, 25 }, { 0x2145, 1 }, { 0x2146, 2 }, { 0x214A, 28 },
+        { 0x214B, 25 }, { 0x214C, 28 }, { 0x214E, 2 }, { 0x214F, 28 }, { 0x2150, 11 }, { 0x2160, 10 },
+        { 0x2183, 1 }, { 0x2184, 2 }, { 0x2185, 10 }, { 0x2189, 11 }, { 0x218A, 28 }, { 0x218C, 0 },
+        { 0x2190, 25 }, { 0x2195, 28 }, { 0x219A, 25 }, { 0x219C, 28 }, { 0x21A0, 25 }, { 0x21A1, 28 },
+        { 0x21A3, 25 }, { 0x21A4, 28 }, { 0x21A6, 25 }, { 0x21A7, 28 }, { 0x21AE, 25 }, { 0x21AF, 28 },
+        { 0x21CE, 25 }, { 0x21D0, 28 }, { 0x21D2, 25 }, { 0x21D3, 28 }, { 0x21D4, 25 }, { 0x21D5, 28 },
+        { 0x21F4, 25 }, { 0x2300, 28 }, { 0x2308, 21 }, { 0x2309, 22 }, { 0x230A, 21 }, { 0x230B, 22 },
+        { 0x230C, 28 }, { 0x2320, 25 }, { 0x2322, 28 }, { 0x2329, 21 }, { 0x232A, 22 }, { 0x232B, 28 },
+        { 0x237C, 25 }, { 0x237D, 28 }, { 0x239B, 25 }, { 0x23B4, 28 }, { 0x23DC, 25 }, { 0x23E2, 28 },
+        { 0x2427, 0 }, { 0x2440, 28 }, { 0x244B, 0 }, { 0x2460, 11 }, { 0x249C, 28 }, { 0x24EA, 11 },
+        { 0x2500, 28 }, { 0x25B7, 25 }, { 0x25B8, 28 }, { 0x25C1, 25 }, { 0x25C2, 28 }, { 0x25F8, 25 },
+        { 0x2600, 28 }, { 0x266F, 25 }, { 0x2670, 28 }, { 0x2768, 21 }, { 0x2769, 22 }, { 0x276A, 21 },
+        { 0x276B, 22 }, { 0x276C, 21 }, { 0x276D, 22 }, { 0x276E, 21 }, { 0x276F, 22 }, { 0x2770, 21 },
+        { 0x2771, 22 }, { 0x2772, 21 }, { 0x2773, 22 }, { 0x2774, 21 }, { 0x2775, 22 }, { 0x2776, 11 },
+        { 0x2794, 28 }, { 0x27C0, 25 }, { 0x27C5, 21 }, { 0x27C6, 22 }, { 0x27C7, 25 }, { 0x27E6, 21 },
+        { 0x27E7, 22 }, { 0x27E8, 21 }, { 0x27E9, 22 }, { 0x27EA, 21 }, { 0x27EB, 22 }, { 0x27EC, 21 },
+        { 0x27ED, 22 }, { 0x27EE, 21 }, { 0x27EF, 22 }, { 0x27F0, 25 }, { 0x2800, 28 }, { 0x2900, 25 },
+        { 0x2983, 21 }, { 0x2984, 22 }, { 0x2985, 21 }, { 0x2986, 22 }, { 0x2987, 21 }, { 0x2988, 22 },
+        { 0x2989, 21 }, { 0x298A, 22 }, { 0x298B, 21 }, { 0x298C, 22 }, { 0x298D, 21 }, { 0x298E, 22 },
+        { 0x298F, 21 }, { 0x2990, 22 }, { 0x2991, 21 }, { 0x2992, 22 }, { 0x2993, 21 }, { 0x2994, 22 },
+        { 0x2995, 21 }, { 0x2996, 22 }, { 0x2997, 21 }, { 0x2998, 22 }, { 0x2999, 25 }, { 0x29D8, 21 },
+        { 0x29D9, 22 }, { 0x29DA, 21 }, { 0x29DB, 22 }, { 0x29DC, 25 }, { 0x29FC, 21 }, { 0x29FD, 22 },
+        { 0x29FE, 25 }, { 0x2B00, 28 }, { 0x2B30, 25 }, { 0x2B45, 28 }, { 0x2B47, 25 }, { 0x2B4D, 28 },
+        { 0x2B74, 0 }, { 0x2B76, 28 }, { 0x2B96, 0 }, { 0x2B97, 28 }, { 0x2C00, 1 }, { 0x2C30, 2 },
+        { 0x2C60, 1 }, { 0x2C61, 2 }, { 0x2C62, 1 }, { 0x2C65, 2 }, { 0x2C67, 1 }, { 0x2C68, 2 },
+        { 0x2C69, 1 }, { 0x2C6A, 2 }, { 0x2C6B, 1 }, { 0x2C6C, 2 }, { 0x2C6D, 1 }, { 0x2C71, 2 },
+        { 0x2C72, 1 }, { 0x2C73, 2 }, { 0x2C75, 1 }, { 0x2C76, 2 }, { 0x2C7C, 4 }, { 0x2C7E, 1 },
+        { 0x2C81, 2 }, { 0x2C82, 1 }, { 0x2C83, 2 }, { 0x2C84, 1 }, { 0x2C85, 2 }, { 0x2C86, 1 },
+        { 0x2C87, 2 }, { 0x2C88, 1 }, { 0x2C89, 2 }, { 0x2C8A, 1 }, { 0x2C8B, 2 }, { 0x2C8C, 1 },
+        { 0x2C8D, 2 }, { 0x2C8E, 1 }, { 0x2C8F, 2 }, { 0x2C90, 1 }, { 0x2C91, 2 }, { 0x2C92, 1 },
+        { 0x2C93, 2 }, { 0x2C94, 1 }, { 0x2C95, 2 }, { 0x2C96, 1 }, { 0x2C97, 2 }, { 0x2C98, 1 },
+        { 0x2C99, 2 }, { 0x2C9A, 1 }, { 0x2C9B, 2 }, { 0x2C9C, 1 }, { 0x2C9D, 2 }, { 0x2C9E, 1 },
+        { 0x2C9F, 2 }, { 0x2CA0, 1 }, { 0x2CA1, 2 }, { 0x2CA2, 1 }, { 0x2CA3, 2 }, { 0x2CA4, 1 },
+        { 0x2CA5, 2 }, { 0x2CA6, 1 }, { 0x2CA7, 2 }, { 0x2CA8, 1 }, { 0x2CA9, 2 }, { 0x2CAA, 1 },
+        { 0x2CAB, 2 }, { 0x2CAC, 1 }, { 0x2CAD, 2 }, { 0x2CAE, 1 }, { 0x2CAF, 2 }, { 0x2CB0, 1 },
+        { 0x2CB1, 2 }, { 0x2CB2, 1 }, { 0x2CB3, 2 }, { 0x2CB4, 1 }, { 0x2CB5, 2 }, { 0x2CB6, 1 },
+        { 0x2CB7, 2 }, { 0x2CB8, 1 }, { 0x2CB9, 2 }, { 0x2CBA, 1 }, { 0x2CBB, 2 }, { 0x2CBC, 1 },
+        { 0x2CBD, 2 }, { 0x2CBE, 1 }, { 0x2CBF, 2 }, { 0x2CC0, 1 }, { 0x2CC1, 2 }, { 0x2CC2, 1 },
+        { 0x2CC3, 2 }, { 0x2CC4, 1 }, { 0x2CC5, 2 }, { 0x2CC6, 1 }, { 0x2CC7, 2 }, { 0x2CC8, 1 },
+        { 0x2CC9, 2 }, { 0x2CCA, 1 }, { 0x2CCB, 2 }, { 0x2CCC, 1 }, { 0x2CCD, 2 }, { 0x2CCE, 1 },
+        { 0x2CCF, 2 }, { 0x2CD0, 1 }, { 0x2CD1, 2 }, { 0x2CD2, 1 }, { 0x2CD3, 2 }, { 0x2CD4, 1 },
+        { 0x2CD5, 2 }, { 0x2CD6, 1 }, { 0x2CD7, 2 }, { 0x2CD8, 1 }, { 0x2CD9, 2 }, { 0x2CDA, 1 },
+        { 0x2CDB, 2 }, { 0x2CDC, 1 }, { 0x2CDD, 2 }, { 0x2CDE, 1 }, { 0x2CDF, 2 }, { 0x2CE0, 1 },
+        { 0x2CE1, 2 }, { 0x2CE2, 1 }, { 0x2CE3, 2 }, { 0x2CE5, 28 }, { 0x2CEB, 1 }, { 0x2CEC, 2 },
+        { 0x2CED, 1 }, { 0x2CEE, 2 }, { 0x2CEF, 6 }, { 0x2CF2, 1 }, { 0x2CF3, 2 }, { 0x2CF4, 0 },
+        { 0x2CF9, 24 }, { 0x2CFD, 11 }, { 0x2CFE, 24 }, { 0x2D00, 2 }, { 0x2D26, 0 }, { 0x2D27, 2 },
+        { 0x2D28, 0 }, { 0x2D2D, 2 }, { 0x2D2E, 0 }, { 0x2D30, 5 }, { 0x2D68, 0 }, { 0x2D6F, 4 },
+        { 0x2D70, 24 }, { 0x2D71, 0 }, { 0x2D7F, 6 }, { 0x2D80, 5 }, { 0x2D97, 0 }, { 0x2DA0, 5 },
+        { 0x2DA7, 0 }, { 0x2DA8, 5 }, { 0x2DAF, 0 }, { 0x2DB0, 5 }, { 0x2DB7, 0 }, { 0x2DB8, 5 },
+        { 0x2DBF, 0 }, { 0x2DC0, 5 }, { 0x2DC7, 0 }, { 0x2DC8, 5 }, { 0x2DCF, 0 }, { 0x2DD0, 5 },
+        { 0x2DD7, 0 }, { 0x2DD8, 5 }, { 0x2DDF, 0 }, { 0x2DE0, 6 }, { 0x2E00, 24 }, { 0x2E02, 29 },
+        { 0x2E03, 30 }, { 0x2E04, 29 }, { 0x2E05, 30 }, { 0x2E06, 24 }, { 0x2E09, 29 }, { 0x2E0A, 30 },
+        { 0x2E0B, 24 }, { 0x2E0C, 29 }, { 0x2E0D, 30 }, { 0x2E0E, 24 }, { 0x2E17, 20 }, { 0x2E18, 24 },
+        { 0x2E1A, 20 }, { 0x2E1B, 24 }, { 0x2E1C, 29 }, { 0x2E1D, 30 }, { 0x2E1E, 24 }, { 0x2E20, 29 },
+        { 0x2E21, 30 }, { 0x2E22, 21 }, { 0x2E23, 22 }, { 0x2E24, 21 }, { 0x2E25, 22 }, { 0x2E26, 21 },
+        { 0x2E27, 22 }, { 0x2E28, 21 }, { 0x2E29, 22 }, { 0x2E2A, 24 }, { 0x2E2F, 4 }, { 0x2E30, 24 },
+        { 0x2E3A, 20 }, { 0x2E3C, 24 }, { 0x2E40, 20 }, { 0x2E41, 24 }, { 0x2E42, 21 }, { 0x2E43, 24 },
+        { 0x2E50, 28 }, { 0x2E52, 24 }, { 0x2E55, 21 }, { 0x2E56, 22 }, { 0x2E57, 21 }, { 0x2E58, 22 },
+        { 0x2E59, 21 }, { 0x2E5A, 22 }, { 0x2E5B, 21 }, { 0x2E5C, 22 }, { 0x2E5D, 20 }, { 0x2E5E, 0 },
+        { 0x2E80, 28 }, { 0x2E9A, 0 }, { 0x2E9B, 28 }, { 0x2EF4, 0 }, { 0x2F00, 28 }, { 0x2FD6, 0 },
+        { 0x2FF0, 28 }, { 0x2FFC, 0 }, { 0x3000, 12 }, { 0x3001, 24 }, { 0x3004, 28 }, { 0x3005, 4 },
+        { 0x3006, 5 }, { 0x3007, 10 }, { 0x3008, 21 }, { 0x3009, 22 }, { 0x300A, 21 }, { 0x300B, 22 },
+        { 0x300C, 21 }, { 0x300D, 22 }, { 0x300E, 21 }, { 0x300F, 22 }, { 0x3010, 21 }, { 0x3011, 22 },
+        { 0x3012, 28 }, { 0x3014, 21 }, { 0x3015, 22 }, { 0x3016, 21 }, { 0x3017, 22 }, { 0x3018, 21 },
+        { 0x3019, 22 }, { 0x301A, 21 }, { 0x301B, 22 }, { 0x301C, 20 }, { 0x301D, 21 }, { 0x301E, 22 },
+        { 0x3020, 28 }, { 0x3021, 10 }, { 0x302A, 6 }, { 0x302E, 8 }, { 0x3030, 20 }, { 0x3031, 4 },
+        { 0x3036, 28 }, { 0x3038, 10 }, { 0x303B, 4 }, { 0x303C, 5 }, { 0x303D, 24 }, { 0x303E, 28 },
+        { 0x3040, 0 }, { 0x3041, 5 }, { 0x3097, 0 }, { 0x3099, 6 }, { 0x309B, 27 }, { 0x309D, 4 },
+        { 0x309F, 5 }, { 0x30A0, 20 }, { 0x30A1, 5 }, { 0x30FB, 24 }, { 0x30FC, 4 }, { 0x30FF, 5 },
+        { 0x3100, 0 }, { 0x3105, 5 }, { 0x3130, 0 }, { 0x3131, 5 }, { 0x318F, 0 }, { 0x3190, 28 },
+        { 0x3192, 11 }, { 0x3196, 28 }, { 0x31A0, 5 }, { 0x31C0, 28 }, { 0x31E4, 0 }, { 0x31F0, 5 },
+        { 0x3200, 28 }, { 0x321F, 0 }, { 0x3220, 11 }, { 0x322A, 28 }, { 0x3248, 11 }, { 0x3250, 28 },
+        { 0x3251, 11 }, { 0x3260, 28 }, { 0x3280, 11 }, { 0x328A, 28 }, { 0x32B1, 11 }, { 0x32C0, 28 },
+        { 0x3400, 5 }, { 0x4DC0, 28 }, { 0x4E00, 5 }, { 0xA015, 4 }, { 0xA016, 5 }, { 0xA48D, 0 },
+        { 0xA490, 28 }, { 0xA4C7, 0 }, { 0xA4D0, 5 }, { 0xA4F8, 4 }, { 0xA4FE, 24 }, { 0xA500, 5 },
+        { 0xA60C, 4 }, { 0xA60D, 24 }, { 0xA610, 5 }, { 0xA620, 9 }, { 0xA62A, 5 }, { 0xA62C, 0 },
+        { 0xA640, 1 }, { 0xA641, 2 }, { 0xA642, 1 }, { 0xA643, 2 }, { 0xA644, 1 }, { 0xA645, 2 },
+        { 0xA646, 1 }, { 0xA647, 2 }, { 0xA648, 1 }, { 0xA649, 2 }, { 0xA64A, 1 }, { 0xA64B, 2 },
+        { 0xA64C, 1 }, { 0xA64D, 2 }, { 0xA64E, 1 }, { 0xA64F, 2 }, { 0xA650, 1 }, { 0xA651, 2 },
+        { 0xA652, 1 }, { 0xA653, 2 }, { 0xA654, 1 }, { 0xA655, 2 }, { 0xA656, 1 }, { 0xA657, 2 },
+        { 0xA658, 1 }, { 0xA659, 2 }, { 0xA65A, 1 }, { 0xA65B, 2 }, { 0xA65C, 1 }, { 0xA65D, 2 },
+        { 0xA65E, 1 }, { 0xA65F, 2 }, { 0xA660, 1 }, { 0xA661, 2 }, { 0xA662, 1 }, { 0xA663, 2 },
+        { 0xA664, 1 }, { 0xA665, 2 }, { 0xA666, 1 }, { 0xA667, 2 }, { 0xA668, 1 }, { 0xA669, 2 },
+        { 0xA66A, 1 }, { 0xA66B, 2 }, { 0xA66C, 1 }, { 0xA66D, 2 }, { 0xA66E, 5 }, { 0xA66F, 6 },
+        { 0xA670, 7 }, { 0xA673, 24 }, { 0xA674, 6 }, { 0xA67E, 24 }, { 0xA67F, 4 }, { 0xA680, 1 },
+        { 0xA681, 2 }, { 0xA682, 1 }, { 0xA683, 2 }, { 0xA684, 1 }, { 0xA685, 2 }, { 0xA686, 1 },
+        { 0xA687, 2 }, { 0xA688, 1 }, { 0xA689, 2 }, { 0xA68A, 1 }, { 0xA68B, 2 }, { 0xA68C, 1 },
+        { 0xA68D, 2 }, { 0xA68E, 1 }, { 0xA68F, 2 }, { 0xA690, 1 }, { 0xA691, 2 }, { 0xA692, 1 },
+        { 0xA693, 2 }, { 0xA694, 1 }, { 0xA695, 2 }, { 0xA696, 1 }, { 0xA697, 2 }, { 0xA698, 1 },
+        { 0xA699, 2 }, { 0xA69A, 1 }, { 0xA69B, 2 }, { 0xA69C, 4 }, { 0xA69E, 6 }, { 0xA6A0, 5 },
+        { 0xA6E6, 10 }, { 0xA6F0, 6 }, { 0xA6F2, 24 }, { 0xA6F8, 0 }, { 0xA700, 27 }, { 0xA717, 4 },
+        { 0xA720, 27 }, { 0xA722, 1 }, { 0xA723, 2 }, { 0xA724, 1 }, { 0xA725, 2 }, { 0xA726, 1 },
+        { 0xA727, 2 }, { 0xA728, 1 }, { 0xA729, 2 }, { 0xA72A, 1 }, { 0xA72B, 2 }, { 0xA72C, 1 },
+        { 0xA72D, 2 }, { 0xA72E, 1 }, { 0xA72F, 2 }, { 0xA732, 1 }, { 0xA733, 2 }, { 0xA734, 1 },
+        { 0xA735, 2 }, { 0xA736, 1 }, { 0xA737, 2 }, { 0xA738, 1 }, { 0xA739, 2 }, { 0xA73A, 1 },
+        { 0xA73B, 2 }, { 0xA73C, 1 }, { 0xA73D, 2 }, { 0xA73E, 1 }, { 0xA73F, 2 }, { 0xA740, 1 },
+        { 0xA741, 2 }, { 0xA742, 1 }, { 0xA743, 2 }, { 0xA744, 1 }, { 0xA745, 2 }, { 0xA746, 1 },
+        { 0xA747, 2 }, { 0xA748, 1 }, { 0xA749, 2 }, { 0xA74A, 1 }, { 0xA74B, 2 }, { 0xA74C, 1 },
+        { 0xA74D, 2 }, { 0xA74E, 1 }, { 0xA74F, 2 }, { 0xA750, 1 }, { 0xA751, 2 }, { 0xA752, 1 },
+        { 0xA753, 2 }, { 0xA754, 1 }, { 0xA755, 2 }, { 0xA756, 1 }, { 0xA757, 2 }, { 0xA758, 1 },
+        { 0xA759, 2 }, { 0xA75A, 1 }, { 0xA75B, 2 }, { 0xA75C, 1 }, { 0xA75D, 2 }, { 0xA75E, 1 },
+        { 0xA75F, 2 }, { 0xA760, 1 }, { 0xA761, 2 }, { 0xA762, 1 }, { 0xA763, 2 }, { 0xA764, 1 },
+        { 0xA765, 2 }, { 0xA766, 1 }, { 0xA767, 2 }, { 0xA768, 1 }, { 0xA769, 2 }, { 0xA76A, 1 },
+        { 0xA76B, 2 }, { 0xA76C, 1 }, { 0xA76D, 2 }, { 0xA76E, 1 }, { 0xA76F, 2 }, { 0xA770, 4 },
+        { 0xA771, 2 }, { 0xA779, 1 }, { 0xA77A, 2 }, { 0xA77B, 1 }, { 0xA77C, 2 }, { 0xA77D, 1 },
+        { 0xA77F, 2 }, { 0xA780, 1 }, { 0xA781, 2 }, { 0xA782, 1 }, { 0xA783, 2 }, { 0xA784, 1 },
+        { 0xA785, 2 }, { 0xA786, 1 }, { 0xA787, 2 }, { 0xA788, 4 }, { 0xA789, 27 }, { 0xA78B, 1 },
+        { 0xA78C, 2 }, { 0xA78D, 1 }, { 0xA78E, 2 }, { 0xA78F, 5 }, { 0xA790, 1 }, { 0xA791, 2 },
+        { 0xA792, 1 }, { 0xA793, 2 }, { 0xA796, 1 }, { 0xA797, 2 }, { 0xA798, 1 }, { 0xA799, 2 },
+        { 0xA79A, 1 }, { 0xA79B, 2 }, { 0xA79C, 1 }, { 0xA79D, 2 }, { 0xA79E, 1 }, { 0xA79F, 2 },
+        { 0xA7A0, 1 }, { 0xA7A1, 2 }, { 0xA7A2, 1 }, { 0xA7A3, 2 }, { 0xA7A4, 1 }, { 0xA7A5, 2 },
+        { 0xA7A6, 1 }, { 0xA7A7, 2 }, { 0xA7A8, 1 }, { 0xA7A9, 2 }, { 0xA7AA, 1 }, { 0xA7AF, 2 },
+        { 0xA7B0, 1 }, { 0xA7B5, 2 }, { 0xA7B6, 1 }, { 0xA7B7, 2 }, { 0xA7B8, 1 }, { 0xA7B9, 2 },
+        { 0xA7BA, 1 }, { 0xA7BB, 2 }, { 0xA7BC, 1 }, { 0xA7BD, 2 }, { 0xA7BE, 1 }, { 0xA7BF, 2 },
+        { 0xA7C0, 1 }, { 0xA7C1, 2 }, { 0xA7C2, 1 }, { 0xA7C3, 2 }, { 0xA7C4, 1 }, { 0xA7C8, 2 },
+        { 0xA7C9, 1 }, { 0xA7CA, 2 }, { 0xA7CB, 0 }, { 0xA7D0, 1 }, { 0xA7D1, 2 }, { 0xA7D2, 0 },
+        { 0xA7D3, 2 }, { 0xA7D4, 0 }, { 0xA7D5, 2 }, { 0xA7D6, 1 }, { 0xA7D7, 2 }, { 0xA7D8, 1 },
+        { 0xA7D9, 2 }, { 0xA7DA, 0 }, { 0xA7F2, 4 }, { 0xA7F5, 1 }, { 0xA7F6, 2 }, { 0xA7F7, 5 },
+        { 0xA7F8, 4 }, { 0xA7FA, 2 }, { 0xA7FB, 5 }, { 0xA802, 6 }, { 0xA803, 5 }, { 0xA806, 6 },
+        { 0xA807, 5 }, { 0xA80B, 6 }, { 0xA80C, 5 }, { 0xA823, 8 }, { 0xA825, 6 }, { 0xA827, 8 },
+        { 0xA828, 28 }, { 0xA82C, 6 }, { 0xA82D, 0 }, { 0xA830, 11 }, { 0xA836, 28 }, { 0xA838, 26 },
+        { 0xA839, 28 }, { 0xA83A, 0 }, { 0xA840, 5 }, { 0xA874, 24 }, { 0xA878, 0 }, { 0xA880, 8 },
+        { 0xA882, 5 }, { 0xA8B4, 8 }, { 0xA8C4, 6 }, { 0xA8C6, 0 }, { 0xA8CE, 24 }, { 0xA8D0, 9 },
+        { 0xA8DA, 0 }, { 0xA8E0, 6 }, { 0xA8F2, 5 }, { 0xA8F8, 24 }, { 0xA8FB, 5 }, { 0xA8FC, 24 },
+        { 0xA8FD, 5 }, { 0xA8FF, 6 }, { 0xA900, 9 }, { 0xA90A, 5 }, { 0xA926, 6 }, { 0xA92E, 24 },
+        { 0xA930, 5 }, { 0xA947, 6 }, { 0xA952, 8 }, { 0xA954, 0 }, { 0xA95F, 24 }, { 0xA960, 5 },
+        { 0xA97D, 0 }, { 0xA980, 6 }, { 0xA983, 8 }, { 0xA984, 5 }, { 0xA9B3, 6 }, { 0xA9B4, 8 },
+        { 0xA9B6, 6 }, { 0xA9BA, 8 }, { 0xA9BC, 6 }, { 0xA9BE, 8 }, { 0xA9C1, 24 }, { 0xA9CE, 0 },
+        { 0xA9CF, 4 }, { 0xA9D0, 9 }, { 0xA9DA, 0 }, { 0xA9DE, 24 }, { 0xA9E0, 5 }, { 0xA9E5, 6 },
+        { 0xA9E6, 4 }, { 0xA9E7, 5 }, { 0xA9F0, 9 }, { 0xA9FA, 5 }, { 0xA9FF, 0 }, { 0xAA00, 5 },
+        { 0xAA29, 6 }, { 0xAA2F, 8 }, { 0xAA31, 6 }, { 0xAA33, 8 }, { 0xAA35, 6 }, { 0xAA37, 0 },
+        { 0xAA40, 5 }, { 0xAA43, 6 }, { 0xAA44, 5 }, { 0xAA4C, 6 }, { 0xAA4D, 8 }, { 0xAA4E, 0 },
+        { 0xAA50, 9 }, { 0xAA5A, 0 }, { 0xAA5C, 24 }, { 0xAA60, 5 }, { 0xAA70, 4 }, { 0xAA71, 5 },
+        { 0xAA77, 28 }, { 0xAA7A, 5 }, { 0xAA7B, 8 }, { 0xAA7C, 6 }, { 0xAA7D, 8 }, { 0xAA7E, 5 },
+        { 0xAAB0, 6 }, { 0xAAB1, 5 }, { 0xAAB2, 6 }, { 0xAAB5, 5 }, { 0xAAB7, 6 }, { 0xAAB9, 5 },
+        { 0xAABE, 6 }, { 0xAAC0, 5 }, { 0xAAC1, 6 }, { 0xAAC2, 5 }, { 0xAAC3, 0 }, { 0xAADB, 5 },
+        { 0xAADD, 4 }, { 0xAADE, 24 }, { 0xAAE0, 5 }, { 0xAAEB, 8 }, { 0xAAEC, 6 }, { 0xAAEE, 8 },
+        { 0xAAF0, 24 }, { 0xAAF2, 5 }, { 0xAAF3, 4 }, { 0xAAF5, 8 }, { 0xAAF6, 6 }, { 0xAAF7, 0 },
+        { 0xAB01, 5 }, { 0xAB07, 0 }, { 0xAB09, 5 }, { 0xAB0F, 0 }, { 0xAB11, 5 }, { 0xAB17, 0 },
+        { 0xAB20, 5 }, { 0xAB27, 0 }, { 0xAB28, 5 }, { 0xAB2F, 0 }, { 0xAB30, 2 }, { 0xAB5B, 27 },
+        { 0xAB5C, 4 }, { 0xAB60, 2 }, { 0xAB69, 4 }, { 0xAB6A, 27 }, { 0xAB6C, 0 }, { 0xAB70, 2 },
+        { 0xABC0, 5 }, { 0xABE3, 8 }, { 0xABE5, 6 }, { 0xABE6, 8 }, { 0xABE8, 6 }, { 0xABE9, 8 },
+        { 0xABEB, 24 }, { 0xABEC, 8 }, { 0xABED, 6 }, { 0xABEE, 0 }, { 0xABF0, 9 }, { 0xABFA, 0 },
+        { 0xAC00, 5 }, { 0xD7A4, 0 }, { 0xD7B0, 5 }, { 0xD7C7, 0 }, { 0xD7CB, 5 }, { 0xD7FC, 0 },
+        { 0xD800, 19 }, { 0xE000, 18 }, { 0xF900, 5 }, { 0xFA6E, 0 }, { 0xFA70, 5 }, { 0xFADA, 0 },
+        { 0xFB00, 2 }, { 0xFB07, 0 }, { 0xFB13, 2 }, { 0xFB18, 0 }, { 0xFB1D, 5 }, { 0xFB1E, 6 },
+        { 0xFB1F, 5 }, { 0xFB29, 25 }, { 0xFB2A, 5 }, { 0xFB37, 0 }, { 0xFB38, 5 }, { 0xFB3D, 0 },
+        { 0xFB3E, 5 }, { 0xFB3F, 0 }, { 0xFB40, 5 }, { 0xFB42, 0 }, { 0xFB43, 5 }, { 0xFB45, 0 },
+        { 0xFB46, 5 }, { 0xFBB2, 27 }, { 0xFBC3, 0 }, { 0xFBD3, 5 }, { 0xFD3E, 22 }, { 0xFD3F, 21 },
+        { 0xFD40, 28 }, { 0xFD50, 5 }, { 0xFD90, 0 }, { 0xFD92, 5 }, { 0xFDC8, 0 }, { 0xFDCF, 28 },
+        { 0xFDD0, 0 }, { 0xFDF0, 5 }, { 0xFDFC, 26 }, { 0xFDFD, 28 }, { 0xFE00, 6 }, { 0xFE10, 24 },
+        { 0xFE17, 21 }, { 0xFE18, 22 }, { 0xFE19, 24 }, { 0xFE1A, 0 }, { 0xFE20, 6 }, { 0xFE30, 24 },
+        { 0xFE31, 20 }, { 0xFE33, 23 }, { 0xFE35, 21 }, { 0xFE36, 22 }, { 0xFE37, 21 }, { 0xFE38, 22 },
+        { 0xFE39, 21 }, { 0xFE3A, 22 }, { 0xFE3B, 21 }, { 0xFE3C, 22 }, { 0xFE3D, 21 }, { 0xFE3E, 22 },
+        { 0xFE3F, 21 }, { 0xFE40, 22 }, { 0xFE41, 21 }, { 0xFE42, 22 }, { 0xFE43, 21 }, { 0xFE44, 22 },
+        { 0xFE45, 24 }, { 0xFE47, 21 }, { 0xFE48, 22 }, { 0xFE49, 24 }, { 0xFE4D, 23 }, { 0xFE50, 24 },
+        { 0xFE53, 0 }, { 0xFE54, 24 }, { 0xFE58, 20 }, { 0xFE59, 21 }, { 0xFE5A, 22 }, { 0xFE5B, 21 },
+        { 0xFE5C, 22 }, { 0xFE5D, 21 }, { 0xFE5E, 22 }, { 0xFE5F, 24 }, { 0xFE62, 25 }, { 0xFE63, 20 },
+        { 0xFE64, 25 }, { 0xFE67, 0 }, { 0xFE68, 24 }, { 0xFE69, 26 }, { 0xFE6A, 24 }, { 0xFE6C, 0 },
+        { 0xFE70, 5 }, { 0xFE75, 0 }, { 0xFE76, 5 }, { 0xFEFD, 0 }, { 0xFEFF, 16 }, { 0xFF00, 0 },
+        { 0xFF01, 24 }, { 0xFF04, 26 }, { 0xFF05, 24 }, { 0xFF08, 21 }, { 0xFF09, 22 }, { 0xFF0A, 24 },
+        { 0xFF0B, 25 }, { 0xFF0C, 24 }, { 0xFF0D, 20 }, { 0xFF0E, 24 }, { 0xFF10, 9 }, { 0xFF1A, 24 },
+        { 0xFF1C, 25 }, { 0xFF1F, 24 }, { 0xFF21, 1 }, { 0xFF3B, 21 }, { 0xFF3C, 24 }, { 0xFF3D, 22 },
+        { 0xFF3E, 27 }, { 0xFF3F, 23 }, { 0xFF40, 27 }, { 0xFF41, 2 }, { 0xFF5B, 21 }, { 0xFF5C, 25 },
+        { 0xFF5D, 22 }, { 0xFF5E, 25 }, { 0xFF5F, 21 }, { 0xFF60, 22 }, { 0xFF61, 24 }, { 0xFF62, 21 },
+        { 0xFF63, 22 }, { 0xFF64, 24 }, { 0xFF66, 5 }, { 0xFF70, 4 }, { 0xFF71, 5 }, { 0xFF9E, 4 },
+        { 0xFFA0, 5 }, { 0xFFBF, 0 }, { 0xFFC2, 5 }, { 0xFFC8, 0 }, { 0xFFCA, 5 }, { 0xFFD0, 0 },
+        { 0xFFD2, 5 }, { 0xFFD8, 0 }, { 0xFFDA, 5 }, { 0xFFDD, 0 }, { 0xFFE0, 26 }, { 0xFFE2, 25 },
+        { 0xFFE3, 27 }, { 0xFFE4, 28 }, { 0xFFE5, 26 }, { 0xFFE7, 0 }, { 0xFFE8, 28 }, { 0xFFE9, 25 },
+        { 0xFFED, 28 }, { 0xFFEF, 0 }, { 0xFFF9, 16 }, { 0xFFFC, 28 }, { 0xFFFE, 0 }, { 0x10000, 5 },
+        { 0x1000C, 0 }, { 0x1000D, 5 }, { 0x10027, 0 }, { 0x10028, 5 }, { 0x1003B, 0 }, { 0x1003C, 5 },
+        { 0x1003E, 0 }, { 0x1003F, 5 }, { 0x1004E, 0 }, { 0x10050, 5 }, { 0x1005E, 0 }, { 0x10080, 5 },
+        { 0x100FB, 0 }, { 0x10100, 24 }, { 0x10103, 0 }, { 0x10107, 11 }, { 0x10134, 0 }, { 0x10137, 28 },
+        { 0x10140, 10 }, { 0x10175, 11 }, { 0x10179, 28 }, { 0x1018A, 11 }, { 0x1018C, 28 }, { 0x1018F, 0 },
+        { 0x10190, 28 }, { 0x1019D, 0 }, { 0x101A0, 28 }, { 0x101A1, 0 }, { 0x101D0, 28 }, { 0x101FD, 6 },
+        { 0x101FE, 0 }, { 0x10280, 5 }, { 0x1029D, 0 }, { 0x102A0, 5 }, { 0x102D1, 0 }, { 0x102E0, 6 },
+        { 0x102E1, 11 }, { 0x102FC, 0 }, { 0x10300, 5 }, { 0x10320, 11 }, { 0x10324, 0 }, { 0x1032D, 5 },
+        { 0x10341, 10 }, { 0x10342, 5 }, { 0x1034A, 10 }, { 0x1034B, 0 }, { 0x10350, 5 }, { 0x10376, 6 },
+        { 0x1037B, 0 }, { 0x10380, 5 }, { 0x1039E, 0 }, { 0x1039F, 24 }, { 0x103A0, 5 }, { 0x103C4, 0 },
+        { 0x103C8, 5 }, { 0x103D0, 24 }, { 0x103D1, 10 }, { 0x103D6, 0 }, { 0x10400, 1 }, { 0x10428, 2 },
+        { 0x10450, 5 }, { 0x1049E, 0 }, { 0x104A0, 9 }, { 0x104AA, 0 }, { 0x104B0, 1 }, { 0x104D4, 0 },
+        { 0x104D8, 2 }, { 0x104FC, 0 }, { 0x10500, 5 }, { 0x10528, 0 }, { 0x10530, 5 }, { 0x10564, 0 },
+        { 0x1056F, 24 }, { 0x10570, 1 }, { 0x1057B, 0 }, { 0x1057C, 1 }, { 0x1058B, 0 }, { 0x1058C, 1 },
+        { 0x10593, 0 }, { 0x10594, 1 }, { 0x10596, 0 }, { 0x10597, 2 }, { 0x105A2, 0 }, { 0x105A3, 2 },
+        { 0x105B2, 0 }, { 0x105B3, 2 }, { 0x105BA, 0 }, { 0x105BB, 2 }, { 0x105BD, 0 }, { 0x10600, 5 },
+        { 0x10737, 0 }, { 0x10740, 5 }, { 0x10756, 0 }, { 0x10760, 5 }, { 0x10768, 0 }, { 0x10780, 4 },
+        { 0x10786, 0 }, { 0x10787, 4 }, { 0x107B1, 0 }, { 0x107B2, 4 }, { 0x107BB, 0 }, { 0x10800, 5 },
+        { 0x10806, 0 }, { 0x10808, 5 }, { 0x10809, 0 }, { 0x1080A, 5 }, { 0x10836, 0 }, { 0x10837, 5 },
+        { 0x10839, 0 }, { 0x1083C, 5 }, { 0x1083D, 0 }, { 0x1083F, 5 }, { 0x10856, 0 }, { 0x10857, 24 },
+        { 0x10858, 11 }, { 0x10860, 5 }, { 0x10877, 28 }, { 0x10879, 11 }, { 0x10880, 5 }, { 0x1089F, 0 },
+        { 0x108A7, 11 }, { 0x108B0, 0 }, { 0x108E0, 5 }, { 0x108F3, 0 }, { 0x108F4, 5 }, { 0x108F6, 0 },
+        { 0x108FB, 11 }, { 0x10900, 5 }, { 0x10916, 11 }, { 0x1091C, 0 }, { 0x1091F, 24 }, { 0x10920, 5 },
+        { 0x1093A, 0 }, { 0x1093F, 24 }, { 0x10940, 0 }, { 0x10980, 5 }, { 0x109B8, 0 }, { 0x109BC, 11 },
+        { 0x109BE, 5 }, { 0x109C0, 11 }, { 0x109D0, 0 }, { 0x109D2, 11 }, { 0x10A00, 5 }, { 0x10A01, 6 },
+        { 0x10A04, 0 }, { 0x10A05, 6 }, { 0x10A07, 0 }, { 0x10A0C, 6 }, { 0x10A10, 5 }, { 0x10A14, 0 },
+        { 0x10A15, 5 }, { 0x10A18, 0 }, { 0x10A19, 5 }, { 0x10A36, 0 }, { 0x10A38, 6 }, { 0x10A3B, 0 },
+        { 0x10A3F, 6 }, { 0x10A40, 11 }, { 0x10A49, 0 }, { 0x10A50, 24 }, { 0x10A59, 0 }, { 0x10A60, 5 },
+        { 0x10A7D, 11 }, { 0x10A7F, 24 }, { 0x10A80, 5 }, { 0x10A9D, 11 }, { 0x10AA0, 0 }, { 0x10AC0, 5 },
+        { 0x10AC8, 28 }, { 0x10AC9, 5 }, { 0x10AE5, 6 }, { 0x10AE7, 0 }, { 0x10AEB, 11 }, { 0x10AF0, 24 },
+        { 0x10AF7, 0 }, { 0x10B00, 5 }, { 0x10B36, 0 }, { 0x10B39, 24 }, { 0x10B40, 5 }, { 0x10B56, 0 },
+        { 0x10B58, 11 }, { 0x10B60, 5 }, { 0x10B73, 0 }, { 0x10B78, 11 }, { 0x10B80, 5 }, { 0x10B92, 0 },
+        { 0x10B99, 24 }, { 0x10B9D, 0 }, { 0x10BA9, 11 }, { 0x10BB0, 0 }, { 0x10C00, 5 }, { 0x10C49, 0 },
+        { 0x10C80, 1 }, { 0x10CB3, 0 }, { 0x10CC0, 2 }, { 0x10CF3, 0 }, { 0x10CFA, 11 }, { 0x10D00, 5 },
+        { 0x10D24, 6 }, { 0x10D28, 0 }, { 0x10D30, 9 }, { 0x10D3A, 0 }, { 0x10E60, 11 }, { 0x10E7F, 0 },
+        { 0x10E80, 5 }, { 0x10EAA, 0 }, { 0x10EAB, 6 }, { 0x10EAD, 20 }, { 0x10EAE, 0 }, { 0x10EB0, 5 },
+        { 0x10EB2, 0 }, { 0x10F00, 5 }, { 0x10F1D, 11 }, { 0x10F27, 5 }, { 0x10F28, 0 }, { 0x10F30, 5 },
+        { 0x10F46, 6 }, { 0x10F51, 11 }, { 0x10F55, 24 }, { 0x10F5A, 0 }, { 0x10F70, 5 }, { 0x10F82, 6 },
+        { 0x10F86, 24 }, { 0x10F8A, 0 }, { 0x10FB0, 5 }, { 0x10FC5, 11 }, { 0x10FCC, 0 }, { 0x10FE0, 5 },
+        { 0x10FF7, 0 }, { 0x11000, 8 }, { 0x11001, 6 }, { 0x11002, 8 }, { 0x11003, 5 }, { 0x11038, 6 },
+        { 0x11047, 24 }, { 0x1104E, 0 }, { 0x11052, 11 }, { 0x11066, 9 }, { 0x11070, 6 }, { 0x11071, 5 },
+        { 0x11073, 6 }, { 0x11075, 5 }, { 0x11076, 0 }, { 0x1107F, 6 }, { 0x11082, 8 }, { 0x11083, 5 },
+        { 0x110B0, 8 }, { 0x110B3, 6 }, { 0x110B7, 8 }, { 0x110B9, 6 }, { 0x110BB, 24 }, { 0x110BD, 16 },
+        { 0x110BE, 24 }, { 0x110C2, 6 }, { 0x110C3, 0 }, { 0x110CD, 16 }, { 0x110CE, 0 }, { 0x110D0, 5 },
+        { 0x110E9, 0 }, { 0x110F0, 9 }, { 0x110FA, 0 }, { 0x11100, 6 }, { 0x11103, 5 }, { 0x11127, 6 },
+        { 0x1112C, 8 }, { 0x1112D, 6 }, { 0x11135, 0 }, { 0x11136, 9 }, { 0x11140, 24 }, { 0x11144, 5 },
+        { 0x11145, 8 }, { 0x11147, 5 }, { 0x11148, 0 }, { 0x11150, 5 }, { 0x11173, 6 }, { 0x11174, 24 },
+        { 0x11176, 5 }, { 0x11177, 0 }, { 0x11180, 6 }, { 0x11182, 8 }, { 0x11183, 5 }, { 0x111B3, 8 },
+        { 0x111B6, 6 }, { 0x111BF, 8 }, { 0x111C1, 5 }, { 0x111C5, 24 }, { 0x111C9, 6 }, { 0x111CD, 24 },
+        { 0x111CE, 8 }, { 0x111CF, 6 }, { 0x111D0, 9 }, { 0x111DA, 5 }, { 0x111DB, 24 }, { 0x111DC, 5 },
+        { 0x111DD, 24 }, { 0x111E0, 0 }, { 0x111E1, 11 }, { 0x111F5, 0 }, { 0x11200, 5 }, { 0x11212, 0 },
+        { 0x11213, 5 }, { 0x1122C, 8 }, { 0x1122F, 6 }, { 0x11232, 8 }, { 0x11234, 6 }, { 0x11235, 8 },
+        { 0x11236, 6 }, { 0x11238, 24 }, { 0x1123E, 6 }, { 0x1123F, 0 }, { 0x11280, 5 }, { 0x11287, 0 },
+        { 0x11288, 5 }, { 0x11289, 0 }, { 0x1128A, 5 }, { 0x1128E, 0 }, { 0x1128F, 5 }, { 0x1129E, 0 },
+        { 0x1129F, 5 }, { 0x112A9, 24 }, { 0x112AA, 0 }, { 0x112B0, 5 }, { 0x112DF, 6 }, { 0x112E0, 8 },
+        { 0x112E3, 6 }, { 0x112EB, 0 }, { 0x112F0, 9 }, { 0x112FA, 0 }, { 0x11300, 6 }, { 0x11302, 8 },
+        { 0x11304, 0 }, { 0x11305, 5 }, { 0x1130D, 0 }, { 0x1130F, 5 }, { 0x11311, 0 }, { 0x11313, 5 },
+        { 0x11329, 0 }, { 0x1132A, 5 }, { 0x11331, 0 }, { 0x11332, 5 }, { 0x11334, 0 }, { 0x11335, 5 },
+        { 0x1133A, 0 }, { 0x1133B, 6 }, { 0x1133D, 5 }, { 0x1133E, 8 }, { 0x11340, 6 }, { 0x11341, 8 },
+        { 0x11345, 0 }, { 0x11347, 8 }, { 0x11349, 0 }, { 0x1134B, 8 }, { 0x1134E, 0 }, { 0x11350, 5 },
+        { 0x11351, 0 }, { 0x11357, 8 }, { 0x11358, 0 }, { 0x1135D, 5 }, { 0x11362, 8 }, { 0x11364, 0 },
+        { 0x11366, 6 }, { 0x1136D, 0 }, { 0x11370, 6 }, { 0x11375, 0 }, { 0x11400, 5 }, { 0x11435, 8 },
+        { 0x11438, 6 }, { 0x11440, 8 }, { 0x11442, 6 }, { 0x11445, 8 }, { 0x11446, 6 }, { 0x11447, 5 },
+        { 0x1144B, 24 }, { 0x11450, 9 }, { 0x1145A, 24 }, { 0x1145C, 0 }, { 0x1145D, 24 }, { 0x1145E, 6 },
+        { 0x1145F, 5 }, { 0x11462, 0 }, { 0x11480, 5 }, { 0x114B0, 8 }, { 0x114B3, 6 }, { 0x114B9, 8 },
+        { 0x114BA, 6 }, { 0x114BB, 8 }, { 0x114BF, 6 }, { 0x114C1, 8 }, { 0x114C2, 6 }, { 0x114C4, 5 },
+        { 0x114C6, 24 }, { 0x114C7, 5 }, { 0x114C8, 0 }, { 0x114D0, 9 }, { 0x114DA, 0 }, { 0x11580, 5 },
+        { 0x115AF, 8 }, { 0x115B2, 6 }, { 0x115B6, 0 }, { 0x115B8, 8 }, { 0x115BC, 6 }, { 0x115BE, 8 },
+        { 0x115BF, 6 }, { 0x115C1, 24 }, { 0x115D8, 5 }, { 0x115DC, 6 }, { 0x115DE, 0 }, { 0x11600, 5 },
+        { 0x11630, 8 }, { 0x11633, 6 }, { 0x1163B, 8 }, { 0x1163D, 6 }, { 0x1163E, 8 }, { 0x1163F, 6 },
+        { 0x11641, 24 }, { 0x11644, 5 }, { 0x11645, 0 }, { 0x11650, 9 }, { 0x1165A, 0 }, { 0x11660, 24 },
+        { 0x1166D, 0 }, { 0x11680, 5 }, { 0x116AB, 6 }, { 0x116AC, 8 }, { 0x116AD, 6 }, { 0x116AE, 8 },
+        { 0x116B0, 6 }, { 0x116B6, 8 }, { 0x116B7, 6 }, { 0x116B8, 5 }, { 0x116B9, 24 }, { 0x116BA, 0 },
+        { 0x116C0, 9 }, { 0x116CA, 0 }, { 0x11700, 5 }, { 0x1171B, 0 }, { 0x1171D, 6 }, { 0x11720, 8 },
+        { 0x11722, 6 }, { 0x11726, 8 }, { 0x11727, 6 }, { 0x1172C, 0 }, { 0x11730, 9 }, { 0x1173A, 11 },
+        { 0x1173C, 24 }, { 0x1173F, 28 }, { 0x11740, 5 }, { 0x11747, 0 }, { 0x11800, 5 }, { 0x1182C, 8 },
+        { 0x1182F, 6 }, { 0x11838, 8 }, { 0x11839, 6 }, { 0x1183B, 24 }, { 0x1183C, 0 }, { 0x118A0, 1 },
+        { 0x118C0, 2 }, { 0x118E0, 9 }, { 0x118EA, 11 }, { 0x118F3, 0 }, { 0x118FF, 5 }, { 0x11907, 0 },
+        { 0x11909, 5 }, { 0x1190A, 0 }, { 0x1190C, 5 }, { 0x11914, 0 }, { 0x11915, 5 }, { 0x11917, 0 },
+        { 0x11918, 5 }, { 0x11930, 8 }, { 0x11936, 0 }, { 0x11937, 8 }, { 0x11939, 0 }, { 0x1193B, 6 },
+        { 0x1193D, 8 }, { 0x1193E, 6 }, { 0x1193F, 5 }, { 0x11940, 8 }, { 0x11941, 5 }, { 0x11942, 8 },
+        { 0x11943, 6 }, { 0x11944, 24 }, { 0x11947, 0 }, { 0x11950, 9 }, { 0x1195A, 0 }, { 0x119A0, 5 },
+        { 0x119A8, 0 }, { 0x119AA, 5 }, { 0x119D1, 8 }, { 0x119D4, 6 }, { 0x119D8, 0 }, { 0x119DA, 6 },
+        { 0x119DC, 8 }, { 0x119E0, 6 }, { 0x119E1, 5 }, { 0x119E2, 24 }, { 0x119E3, 5 }, { 0x119E4, 8 },
+        { 0x119E5, 0 }, { 0x11A00, 5 }, { 0x11A01, 6 }, { 0x11A0B, 5 }, { 0x11A33, 6 }, { 0x11A39, 8 },
+        { 0x11A3A, 5 }, { 0x11A3B, 6 }, { 0x11A3F, 24 }, { 0x11A47, 6 }, { 0x11A48, 0 }, { 0x11A50, 5 },
+        { 0x11A51, 6 }, { 0x11A57, 8 }, { 0x11A59, 6 }, { 0x11A5C, 5 }, { 0x11A8A, 6 }, { 0x11A97, 8 },
+        { 0x11A98, 6 }, { 0x11A9A, 24 }, { 0x11A9D, 5 }, { 0x11A9E, 24 }, { 0x11AA3, 0 }, { 0x11AB0, 5 },
+        { 0x11AF9, 0 }, { 0x11C00, 5 }, { 0x11C09, 0 }, { 0x11C0A, 5 }, { 0x11C2F, 8 }, { 0x11C30, 6 },
+        { 0x11C37, 0 }, { 0x11C38, 6 }, { 0x11C3E, 8 }, { 0x11C3F, 6 }, { 0x11C40, 5 }, { 0x11C41, 24 },
+        { 0x11C46, 0 }, { 0x11C50, 9 }, { 0x11C5A, 11 }, { 0x11C6D, 0 }, { 0x11C70, 24 }, { 0x11C72, 5 },
+        { 0x11C90, 0 }, { 0x11C92, 6 }, { 0x11CA8, 0 }, { 0x11CA9, 8 }, { 0x11CAA, 6 }, { 0x11CB1, 8 },
+        { 0x11CB2, 6 }, { 0x11CB4, 8 }, { 0x11CB5, 6 }, { 0x11CB7, 0 }, { 0x11D00, 5 }, { 0x11D07, 0 },
+        { 0x11D08, 5 }, { 0x11D0A, 0 }, { 0x11D0B, 5 }, { 0x11D31, 6 }, { 0x11D37, 0 }, { 0x11D3A, 6 },
+        { 0x11D3B, 0 }, { 0x11D3C, 6 }, { 0x11D3E, 0 }, { 0x11D3F, 6 }, { 0x11D46, 5 }, { 0x11D47, 6 },
+        { 0x11D48, 0 }, { 0x11D50, 9 }, { 0x11D5A, 0 }, { 0x11D60, 5 }, { 0x11D66, 0 }, { 0x11D67, 5 },
+        { 0x11D69, 0 }, { 0x11D6A, 5 }, { 0x11D8A, 8 }, { 0x11D8F, 0 }, { 0x11D90, 6 }, { 0x11D92, 0 },
+        { 0x11D93, 8 }, { 0x11D95, 6 }, { 0x11D96, 8 }, { 0x11D97, 6 }, { 0x11D98, 5 }, { 0x11D99, 0 },
+        { 0x11DA0, 9 }, { 0x11DAA, 0 }, { 0x11EE0, 5 }, { 0x11EF3, 6 }, { 0x11EF5, 8 }, { 0x11EF7, 24 },
+        { 0x11EF9, 0 }, { 0x11FB0, 5 }, { 0x11FB1, 0 }, { 0x11FC0, 11 }, { 0x11FD5, 28 }, { 0x11FDD, 26 },
+        { 0x11FE1, 28 }, { 0x11FF2, 0 }, { 0x11FFF, 24 }, { 0x12000, 5 }, { 0x1239A, 0 }, { 0x12400, 10 },
+        { 0x1246F, 0 }, { 0x12470, 24 }, { 0x12475, 0 }, { 0x12480, 5 }, { 0x12544, 0 }, { 0x12F90, 5 },
+        { 0x12FF1, 24 }, { 0x12FF3, 0 }, { 0x13000, 5 }, { 0x1342F, 0 }, { 0x13430, 16 }, { 0x13439, 0 },
+        { 0x14400, 5 }, { 0x14647, 0 }, { 0x16800, 5 }, { 0x16A39, 0 }, { 0x16A40, 5 }, { 0x16A5F, 0 },
+        { 0x16A60, 9 }, { 0x16A6A, 0 }, { 0x16A6E, 24 }, { 0x16A70, 5 }, { 0x16ABF, 0 }, { 0x16AC0, 9 },
+        { 0x16ACA, 0 }, { 0x16AD0, 5 }, { 0x16AEE, 0 }, { 0x16AF0, 6 }, { 0x16AF5, 24 }, { 0x16AF6, 0 },
+        { 0x16B00, 5 }, { 0x16B30, 6 }, { 0x16B37, 24 }, { 0x16B3C, 28 }, { 0x16B40, 4 }, { 0x16B44, 24 },
+        { 0x16B45, 28 }, { 0x16B46, 0 }, { 0x16B50, 9 }, { 0x16B5A, 0 }, { 0x16B5B, 11 }, { 0x16B62, 0 },
+        { 0x16B63, 5 }, { 0x16B78, 0 }, { 0x16B7D, 5 }, { 0x16B90, 0 }, { 0x16E40, 1 }, { 0x16E60, 2 },
+        { 0x16E80, 11 }, { 0x16E97, 24 }, { 0x16E9B, 0 }, { 0x16F00, 5 }, { 0x16F4B, 0 }, { 0x16F4F, 6 },
+        { 0x16F50, 5 }, { 0x16F51, 8 }, { 0x16F88, 0 }, { 0x16F8F, 6 }, { 0x16F93, 4 }, { 0x16FA0, 0 },
+        { 0x16FE0, 4 }, { 0x16FE2, 24 }, { 0x16FE3, 4 }, { 0x16FE4, 6 }, { 0x16FE5, 0 }, { 0x16FF0, 8 },
+        { 0x16FF2, 0 }, { 0x17000, 5 }, { 0x187F8, 0 }, { 0x18800, 5 }, { 0x18CD6, 0 }, { 0x18D00, 5 },
+        { 0x18D09, 0 }, { 0x1AFF0, 4 }, { 0x1AFF4, 0 }, { 0x1AFF5, 4 }, { 0x1AFFC, 0 }, { 0x1AFFD, 4 },
+        { 0x1AFFF, 0 }, { 0x1B000, 5 }, { 0x1B123, 0 }, { 0x1B150, 5 }, { 0x1B153, 0 }, { 0x1B164, 5 },
+        { 0x1B168, 0 }, { 0x1B170, 5 }, { 0x1B2FC, 0 }, { 0x1BC00, 5 }, { 0x1BC6B, 0 }, { 0x1BC70, 5 },
+        { 0x1BC7D, 0 }, { 0x1BC80, 5 }, { 0x1BC89, 0 }, { 0x1BC90, 5 }, { 0x1BC9A, 0 }, { 0x1BC9C, 28 },
+        { 0x1BC9D, 6 }, { 0x1BC9F, 24 }, { 0x1BCA0, 16 }, { 0x1BCA4, 0 }, { 0x1CF00, 6 }, { 0x1CF2E, 0 },
+        { 0x1CF30, 6 }, { 0x1CF47, 0 }, { 0x1CF50, 28 }, { 0x1CFC4, 0 }, { 0x1D000, 28 }, { 0x1D0F6, 0 },
+        { 0x1D100, 28 }, { 0x1D127, 0 }, { 0x1D129, 28 }, { 0x1D165, 8 }, { 0x1D167, 6 }, { 0x1D16A, 28 },
+        { 0x1D16D, 8 }, { 0x1D173, 16 }, { 0x1D17B, 6 }, { 0x1D183, 28 }, { 0x1D185, 6 }, { 0x1D18C, 28 },
+        { 0x1D1AA, 6 }, { 0x1D1AE, 28 }, { 0x1D1EB, 0 }, { 0x1D200, 28 }, { 0x1D242, 6 }, { 0x1D245, 28 },
+        { 0x1D246, 0 }, { 0x1D2E0, 11 }, { 0x1D2F4, 0 }, { 0x1D300, 28 }, { 0x1D357, 0 }, { 0x1D360, 11 },
+        { 0x1D379, 0 }, { 0x1D400, 1 }, { 0x1D41A, 2 }, { 0x1D434, 1 }, { 0x1D44E, 2 }, { 0x1D455, 0 },
+        { 0x1D456, 2 }, { 0x1D468, 1 }, { 0x1D482, 2 }, { 0x1D49C, 1 }, { 0x1D49D, 0 }, { 0x1D49E, 1 },
+        { 0x1D4A0, 0 }, { 0x1D4A2, 1 }, { 0x1D4A3, 0 }, { 0x1D4A5, 1 }, { 0x1D4A7, 0 }, { 0x1D4A9, 1 },
+        { 0x1D4AD, 0 }, { 0x1D4AE, 1 }, { 0x1D4B6, 2 }, { 0x1D4BA, 0 }, { 0x1D4BB, 2 }, { 0x1D4BC, 0 },
+        { 0x1D4BD, 2 }, { 0x1D4C4, 0 }, { 0x1D4C5, 2 }, { 0x1D4D0, 1 }, { 0x1D4EA, 2 }, { 0x1D504, 1 },
+        { 0x1D506, 0 }, { 0x1D507, 1 }, { 0x1D50B, 0 }, { 0x1D50D, 1 }, { 0x1D515, 0 }, { 0x1D516, 1 },
+        { 0x1D51D, 0 }, { 0x1D51E, 2 }, { 0x1D538, 1 }, { 0x1D53A, 0 }, { 0x1D53B, 1 }, { 0x1D53F, 0 },
+        { 0x1D540, 1 }, { 0x1D545, 0 }, { 0x1D546, 1 }, { 0x1D547, 0 }, { 0x1D54A, 1 }, { 0x1D551, 0 },
+        { 0x1D552, 2 }, { 0x1D56C, 1 }, { 0x1D586, 2 }, { 0x1D5A0, 1 }, { 0x1D5BA, 2 }, { 0x1D5D4, 1 },
+        { 0x1D5EE, 2 }, { 0x1D608, 1 }, { 0x1D622, 2 }, { 0x1D63C, 1 }, { 0x1D656, 2 }, { 0x1D670, 1 },
+        { 0x1D68A, 2 }, { 0x1D6A6, 0 }, { 0x1D6A8, 1 }, { 0x1D6C1, 25 }, { 0x1D6C2, 2 }, { 0x1D6DB, 25 },
+        { 0x1D6DC, 2 }, { 0x1D6E2, 1 }, { 0x1D6FB, 25 }, { 0x1D6FC, 2 }, { 0x1D715, 25 }, { 0x1D716, 2 },
+        { 0x1D71C, 1 }, { 0x1D735, 25 }, { 0x1D736, 2 }, { 0x1D74F, 25 }, { 0x1D750, 2 }, { 0x1D756, 1 },
+        { 0x1D76F, 25 }, { 0x1D770, 2 }, { 0x1D789, 25 }, { 0x1D78A, 2 }, { 0x1D790, 1 }, { 0x1D7A9, 25 },
+        { 0x1D7AA, 2 }, { 0x1D7C3, 25 }, { 0x1D7C4, 2 }, { 0x1D7CA, 1 }, { 0x1D7CB, 2 }, { 0x1D7CC, 0 },
+        { 0x1D7CE, 9 }, { 0x1D800, 28 }, { 0x1DA00, 6 }, { 0x1DA37, 28 }, { 0x1DA3B, 6 }, { 0x1DA6D, 28 },
+        { 0x1DA75, 6 }, { 0x1DA76, 28 }, { 0x1DA84, 6 }, { 0x1DA85, 28 }, { 0x1DA87, 24 }, { 0x1DA8C, 0 },
+        { 0x1DA9B, 6 }, { 0x1DAA0, 0 }, { 0x1DAA1, 6 }, { 0x1DAB0, 0 }, { 0x1DF00, 2 }, { 0x1DF0A, 5 },
+        { 0x1DF0B, 2 }, { 0x1DF1F, 0 }, { 0x1E000, 6 }, { 0x1E007, 0 }, { 0x1E008, 6 }, { 0x1E019, 0 },
+        { 0x1E01B, 6 }, { 0x1E022, 0 }, { 0x1E023, 6 }, { 0x1E025, 0 }, { 0x1E026, 6 }, { 0x1E02B, 0 },
+        { 0x1E100, 5 }, { 0x1E12D, 0 }, { 0x1E130, 6 }, { 0x1E137, 4 }, { 0x1E13E, 0 }, { 0x1E140, 9 },
+        { 0x1E14A, 0 }, { 0x1E14E, 5 }, { 0x1E14F, 28 }, { 0x1E150, 0 }, { 0x1E290, 5 }, { 0x1E2AE, 6 },
+        { 0x1E2AF, 0 }, { 0x1E2C0, 5 }, { 0x1E2EC, 6 }, { 0x1E2F0, 9 }, { 0x1E2FA, 0 }, { 0x1E2FF, 26 },
+        { 0x1E300, 0 }, { 0x1E7E0, 5 }, { 0x1E7E7, 0 }, { 0x1E7E8, 5 }, { 0x1E7EC, 0 }, { 0x1E7ED, 5 },
+        { 0x1E7EF, 0 }, { 0x1E7F0, 5 }, { 0x1E7FF, 0 }, { 0x1E800, 5 }, { 0x1E8C5, 0 }, { 0x1E8C7, 11 },
+        { 0x1E8D0, 6 }, { 0x1E8D7, 0 }, { 0x1E900, 1 }, { 0x1E922, 2 }, { 0x1E944, 6 }, { 0x1E94B, 4 },
+        { 0x1E94C, 0 }, { 0x1E950, 9 }, { 0x1E95A, 0 }, { 0x1E95E, 24 }, { 0x1E960, 0 }, { 0x1EC71, 11 },
+        { 0x1ECAC, 28 }, { 0x1ECAD, 11 }, { 0x1ECB0, 26 }, { 0x1ECB1, 11 }, { 0x1ECB5, 0 }, { 0x1ED01, 11 },
+        { 0x1ED2E, 28 }, { 0x1ED2F, 11 }, { 0x1ED3E, 0 }, { 0x1EE00, 5 }, { 0x1EE04, 0 }, { 0x1EE05, 5 },
+        { 0x1EE20, 0 }, { 0x1EE21, 5 }, { 0x1EE23, 0 }, { 0x1EE24, 5 }, { 0x1EE25, 0 }, { 0x1EE27, 5 },
+        { 0x1EE28, 0 }, { 0x1EE29, 5 }, { 0x1EE33, 0 }, { 0x1EE34, 5 }, { 0x1EE38, 0 }, { 0x1EE39, 5 },
+        { 0x1EE3A, 0 }, { 0x1EE3B, 5 }, { 0x1EE3C, 0 }, { 0x1EE42, 5 }, { 0x1EE43, 0 }, { 0x1EE47, 5 },
+        { 0x1EE48, 0 }, { 0x1EE49, 5 }, { 0x1EE4A, 0 }, { 0x1EE4B, 5 }, { 0x1EE4C, 0 }, { 0x1EE4D, 5 },
+        { 0x1EE50, 0 }, { 0x1EE51, 5 }, { 0x1EE53, 0 }, { 0x1EE54, 5 }, { 0x1EE55, 0 }, { 0x1EE57, 5 },
+        { 0x1EE58, 0 }, { 0x1EE59, 5 }, { 0x1EE5A, 0 }, { 0x1EE5B, 5 }, { 0x1EE5C, 0 }, { 0x1EE5D, 5 },
+        { 0x1EE5E, 0 }, { 0x1EE5F, 5 }, { 0x1EE60, 0 }, { 0x1EE61, 5 }, { 0x1EE63, 0 }, { 0x1EE64, 5 },
+        { 0x1EE65, 0 }, { 0x1EE67, 5 }, { 0x1EE6B, 0 }, { 0x1EE6C, 5 }, { 0x1EE73, 0 }, { 0x1EE74, 5 },
+        { 0x1EE78, 0 }, { 0x1EE79, 5 }, { 0x1EE7D, 0 }, { 0x1EE7E, 5 }, { 0x1EE7F, 0 }, { 0x1EE80, 5 },
+        { 0x1EE8A, 0 }, { 0x1EE8B, 5 }, { 0x1EE9C, 0 }, { 0x1EEA1, 5 }, { 0x1EEA4, 0 }, { 0x1EEA5, 5 },
+        { 0x1EEAA, 0 }, { 0x1EEAB, 5 }, { 0x1EEBC, 0 }, { 0x1EEF0, 25 }, { 0x1EEF2, 0 }, { 0x1F000, 28 },
+        { 0x1F02C, 0 }, { 0x1F030, 28 }, { 0x1F094, 0 }, { 0x1F0A0, 28 }, { 0x1F0AF, 0 }, { 0x1F0B1, 28 },
+        { 0x1F0C0, 0 }, { 0x1F0C1, 28 }, { 0x1F0D0, 0 }, { 0x1F0D1, 28 }, { 0x1F0F6, 0 }, { 0x1F100, 11 },
+        { 0x1F10D, 28 }, { 0x1F1AE, 0 }, { 0x1F1E6, 28 }, { 0x1F203, 0 }, { 0x1F210, 28 }, { 0x1F23C, 0 },
+        { 0x1F240, 28 }, { 0x1F249, 0 }, { 0x1F250, 28 }, { 0x1F252, 0 }, { 0x1F260, 28 }, { 0x1F266, 0 },
+        { 0x1F300, 28 }, { 0x1F3FB, 27 }, { 0x1F400, 28 }, { 0x1F6D8, 0 }, { 0x1F6DD, 28 }, { 0x1F6ED, 0 },
+        { 0x1F6F0, 28 }, { 0x1F6FD, 0 }, { 0x1F700, 28 }, { 0x1F774, 0 }, { 0x1F780, 28 }, { 0x1F7D9, 0 },
+        { 0x1F7E0, 28 }, { 0x1F7EC, 0 }, { 0x1F7F0, 28 }, { 0x1F7F1, 0 }, { 0x1F800, 28 }, { 0x1F80C, 0 },
+        { 0x1F810, 28 }, { 0x1F848, 0 }, { 0x1F850, 28 }, { 0x1F85A, 0 }, { 0x1F860, 28 }, { 0x1F888, 0 },
+        { 0x1F890, 28 }, { 0x1F8AE, 0 }, { 0x1F8B0, 28 }, { 0x1F8B2, 0 }, { 0x1F900, 28 }, { 0x1FA54, 0 },
+        { 0x1FA60, 28 }, { 0x1FA6E, 0 }, { 0x1FA70, 28 }, { 0x1FA75, 0 }, { 0x1FA78, 28 }, { 0x1FA7D, 0 },
+        { 0x1FA80, 28 }, { 0x1FA87, 0 }, { 0x1FA90, 28 }, { 0x1FAAD, 0 }, { 0x1FAB0, 28 }, { 0x1FABB, 0 },
+        { 0x1FAC0, 28 }, { 0x1FAC6, 0 }, { 0x1FAD0, 28 }, { 0x1FADA, 0 }, { 0x1FAE0, 28 }, { 0x1FAE8, 0 },
+        { 0x1FAF0, 28 }, { 0x1FAF7, 0 }, { 0x1FB00, 28 }, { 0x1FB93, 0 }, { 0x1FB94, 28 }, { 0x1FBCB, 0 },
+        { 0x1FBF0, 9 }, { 0x1FBFA, 0 }, { 0x20000, 5 }, { 0x2A6E0, 0 }, { 0x2A700, 5 }, { 0x2B739, 0 },
+        { 0x2B740, 5 }, { 0x2B81E, 0 }, { 0x2B820, 5 }, { 0x2CEA2, 0 }, { 0x2CEB0, 5 }, { 0x2EBE1, 0 },
+        { 0x2F800, 5 }, { 0x2FA1E, 0 }, { 0x30000, 5 }, { 0x3134B, 0 }, { 0xE0001, 16 }, { 0xE0002, 0 },
+        { 0xE0020, 16 }, { 0xE0080, 0 }, { 0xE0100, 6 }, { 0xE01F0, 0 }, { 0xF0000, 18 }, { 0xFFFFE, 0 },
+        { 0x100000, 18 }, { 0x10FFFE, 0 },
+    };
+
+}
+
+int generalCategory(char32_t ch) {
+    auto it = std::upper_bound(std::begin(runs), std::end(runs), ch,
+        [](char32_t c, const Run& run) { return c < run.start; });
+    return it == std::begin(runs) ? UNASSIGNED : std::prev(it)->category;
+}
+
+std::vector<std::pair<char32_t, char32_t>> propertyRanges(const std::string& name) {
+    // The predicates of forProperty() only change value where a run of the
+    // table starts, or at U+0100 for L1, so they are evaluated once per run.
+    std::vector<char32_t> breaks;
+    for (const Run& run : runs) {
+        breaks.push_back(run.start);
+    }
+    breaks.insert(std::upper_bound(breaks.begin(), breaks.end(), 0x100), 0x100);
+    breaks.erase(std::unique(breaks.begin(), breaks.end()), breaks.end());
+    breaks.push_back(0x110000);
+
+    CharPredicate predicate = forProperty(name, false);
+    std::vector<std::pair<char32_t, char32_t>> ranges;
+    for (size_t i = 0; i + 1 < breaks.size(); ++i) {
+        if (!predicate(breaks[i])) {
+            continue;
+        }
+        if (!ranges.empty() && ranges.back().second + 1 == breaks[i]) {
+            ranges.back().second = breaks[i + 1] - 1;
+        }
+        else {
+            ranges.emplace_back(breaks[i], breaks[i + 1] - 1);
+        }
+    }
+    return ranges;
+}
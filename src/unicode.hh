@@ -1,7 +1,11 @@
+#ifndef _UNICODE_HH_
+#define _UNICODE_HH_
+
 #include <functional>
 #include <cstdint>
 #include <iostream>
 #include <string>
+#include <vector>
 #include "ascii.hh"
 
 // 定义 CharPredicate 类型为函数指针
@@ -40,22 +44,25 @@ constexpr int INITIAL_QUOTE_PUNCTUATION = 29; // Pi informative
 constexpr int FINAL_QUOTE_PUNCTUATION = 30; // Pf informative
 constexpr int GENERAL_CATEGORY_COUNT = 31; // sentinel value
 
+// 码点的 Unicode 通用类别（上面的常量之一），数据见 unicode.cc
+int generalCategory(char32_t ch);
+
 // category函数
-CharPredicate category(int typeMask) {
+inline CharPredicate category(int typeMask) {
     return [typeMask](char32_t ch) {
-        return (typeMask & (1 << ASCII::getType(static_cast<int>(ch)))) != 0;
+        return (typeMask & (1 << generalCategory(ch))) != 0;
     };
 }
 
 // range函数
-CharPredicate range(char32_t lower, char32_t upper) {
+inline CharPredicate range(char32_t lower, char32_t upper) {
     return [lower, upper](char32_t ch) {
         return lower <= ch && ch <= upper;
     };
 }
 
 // 定义字符类型检测函数
-CharPredicate forProperty(const std::string& name, bool caseIns) {
+inline CharPredicate forProperty(const std::string& name, bool caseIns) {
     if (name == "Cn") {
         return category(1 << UNASSIGNED);
     }
@@ -220,3 +227,7 @@ CharPredicate forProperty(const std::string& name, bool caseIns) {
     }
 }
 
+// forProperty(name) 成立的码点，按升序排列的不相交区间
+std::vector<std::pair<char32_t, char32_t>> propertyRanges(const std::string& name);
+
+#endif // !_UNICODE_HH_
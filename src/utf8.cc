@@ -0,0 +1,438 @@
+#include "utf8.hh"
+#include "simd.hh"
+
+namespace {
+
+    inline unsigned char at(const char* s, size_t i) {
+        return static_cast<unsigned char>(s[i]);
+    }
+
+    // Moves back from offset to the start of the code point that contains it.
+    size_t sequenceStart(const char* s, size_t offset) {
+        size_t limit = offset >= 3 ? offset - 3 : 0;
+        while (offset > limit && (at(s, offset) & 0xC0) == 0x80) {
+            offset--;
+        }
+        return offset;
+    }
+
+#ifdef SWEETIE_X86
+
+    using SIMD::Level;
+
+    const Level level = SIMD::level();
+
+    // The lookup tables below classify every pair of adjacent bytes, following
+    // Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte".
+    // A non-zero result for a pair means the pair can never occur in valid text,
+    // except for TWO_CONTS which is expected inside 3- and 4-byte sequences.
+    constexpr uint8_t TOO_SHORT = 1 << 0;      // 11______ 0_______ / 11______ 11______
+    constexpr uint8_t TOO_LONG = 1 << 1;       // 0_______ 10______
+    constexpr uint8_t OVERLONG_3 = 1 << 2;     // 11100000 100_____
+    constexpr uint8_t TOO_LARGE = 1 << 3;      // 11110100 1001____ and above
+    constexpr uint8_t SURROGATE = 1 << 4;      // 11101101 101_____
+    constexpr uint8_t OVERLONG_2 = 1 << 5;     // 1100000_ 10______
+    constexpr uint8_t TOO_LARGE_1000 = 1 << 6; // 11110101 1000____ and above
+    constexpr uint8_t OVERLONG_4 = 1 << 6;     // 11110000 1000____
+    constexpr uint8_t TWO_CONTS = 1 << 7;      // 10______ 10______
+    constexpr uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+    constexpr uint8_t byte1High[16] = {
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+        TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+        TOO_SHORT | OVERLONG_2,
+        TOO_SHORT,
+        TOO_SHORT | OVERLONG_3 | SURROGATE,
+        TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+    };
+
+    constexpr uint8_t byte1Low[16] = {
+        CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+        CARRY | OVERLONG_2,
+        CARRY,
+        CARRY,
+        CARRY | TOO_LARGE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+        CARRY | TOO_LARGE | TOO_LARGE_1000,
+    };
+
+    constexpr uint8_t byte2High[16] = {
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+        TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    };
+
+    // The last three bytes of a block may not start a sequence that needs more
+    // bytes than remain in it.
+    constexpr uint8_t incompleteMax[32] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+    };
+
+    SWEETIE_TARGET("sse4.2")
+    size_t validateSSE42(const char* s, size_t n) {
+        const __m128i high1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(byte1High));
+        const __m128i low1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(byte1Low));
+        const __m128i high2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(byte2High));
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        const __m128i maxTail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(incompleteMax + 16));
+
+        __m128i previous = _mm_setzero_si128();
+        __m128i previousIncomplete = _mm_setzero_si128();
+
+        size_t i = 0;
+        for (;; i += 16) {
+            __m128i input;
+            bool last = i + 16 > n;
+            if (!last) {
+                input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            }
+            else {
+                // Zero padding behaves like ASCII and so exposes truncated tails.
+                alignas(16) char tail[16] = {};
+                for (size_t k = 0; i + k < n; ++k) tail[k] = s[i + k];
+                input = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+            }
+
+            __m128i error;
+            if (_mm_movemask_epi8(input) == 0) {
+                error = previousIncomplete;
+            }
+            else {
+                __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+                __m128i sc = _mm_and_si128(
+                    _mm_and_si128(
+                        _mm_shuffle_epi8(high1, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+                        _mm_shuffle_epi8(low1, _mm_and_si128(prev1, nibble))),
+                    _mm_shuffle_epi8(high2, _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+                __m128i prev2 = _mm_alignr_epi8(input, previous, 14);
+                __m128i prev3 = _mm_alignr_epi8(input, previous, 13);
+                __m128i must23 = _mm_or_si128(
+                    _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80))),
+                    _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80))));
+                __m128i must23_80 = _mm_and_si128(must23, _mm_set1_epi8(static_cast<char>(0x80)));
+                error = _mm_xor_si128(must23_80, sc);
+                previousIncomplete = _mm_subs_epu8(input, maxTail);
+            }
+
+            if (!_mm_testz_si128(error, error)) {
+                size_t from = sequenceStart(s, i >= 16 ? i - 16 : 0);
+                return from + UTF8::validateScalar(s + from, n - from);
+            }
+            previous = input;
+            if (last) {
+                return n;
+            }
+        }
+    }
+
+    SWEETIE_TARGET("avx2")
+    size_t validateAVX2(const char* s, size_t n) {
+        // _mm256_shuffle_epi8 looks up within each 128-bit lane, so both lanes get the table.
+        const __m256i high1 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(byte1High)));
+        const __m256i low1 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(byte1Low)));
+        const __m256i high2 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(byte2High)));
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        const __m256i maxTail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(incompleteMax));
+
+        __m256i previous = _mm256_setzero_si256();
+        __m256i previousIncomplete = _mm256_setzero_si256();
+
+        size_t i = 0;
+        for (;; i += 32) {
+            __m256i input;
+            bool last = i + 32 > n;
+            if (!last) {
+                input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            }
+            else {
+                alignas(32) char tail[32] = {};
+                for (size_t k = 0; i + k < n; ++k) tail[k] = s[i + k];
+                input = _mm256_load_si256(reinterpret_cast<const __m256i*>(tail));
+            }
+
+            __m256i error;
+            if (_mm256_movemask_epi8(input) == 0) {
+                error = previousIncomplete;
+            }
+            else {
+                // _mm256_alignr_epi8 works per 128-bit lane, so first line up
+                // the upper half of the previous block with the lower half of this one.
+                __m256i carried = _mm256_permute2x128_si256(previous, input, 0x21);
+                __m256i prev1 = _mm256_alignr_epi8(input, carried, 15);
+                __m256i sc = _mm256_and_si256(
+                    _mm256_and_si256(
+                        _mm256_shuffle_epi8(high1, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                        _mm256_shuffle_epi8(low1, _mm256_and_si256(prev1, nibble))),
+                    _mm256_shuffle_epi8(high2, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+                __m256i prev2 = _mm256_alignr_epi8(input, carried, 14);
+                __m256i prev3 = _mm256_alignr_epi8(input, carried, 13);
+                __m256i must23 = _mm256_or_si256(
+                    _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80))),
+                    _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80))));
+                __m256i must23_80 = _mm256_and_si256(must23, _mm256_set1_epi8(static_cast<char>(0x80)));
+                error = _mm256_xor_si256(must23_80, sc);
+                previousIncomplete = _mm256_subs_epu8(input, maxTail);
+            }
+
+            if (!_mm256_testz_si256(error, error)) {
+                size_t from = sequenceStart(s, i >= 32 ? i - 32 : 0);
+                return from + UTF8::validateScalar(s + from, n - from);
+            }
+            previous = input;
+            if (last) {
+                return n;
+            }
+        }
+    }
+
+    SWEETIE_TARGET("sse4.2")
+    size_t asciiPrefixSSE42(const char* s, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            int mask = _mm_movemask_epi8(input);
+            if (mask) {
+                return i + SWEETIE_CTZ(static_cast<unsigned>(mask));
+            }
+        }
+        while (i < n && at(s, i) < 0x80) i++;
+        return i;
+    }
+
+    SWEETIE_TARGET("avx2")
+    size_t asciiPrefixAVX2(const char* s, size_t n) {
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(input));
+            if (mask) {
+                return i + SWEETIE_CTZ(mask);
+            }
+        }
+        return i + asciiPrefixSSE42(s + i, n - i);
+    }
+
+    // Widens runs of ASCII into code points 16 bytes at a time and decodes
+    // everything else with the scalar decoder.
+    SWEETIE_TARGET("sse4.2")
+    size_t decodeSSE42(const char* s, size_t n, char32_t* out) {
+        size_t i = 0, written = 0;
+        while (i < n) {
+            if (i + 16 <= n) {
+                __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                if (_mm_movemask_epi8(input) == 0) {
+                    __m128i* dst = reinterpret_cast<__m128i*>(out + written);
+                    _mm_storeu_si128(dst + 0, _mm_cvtepu8_epi32(input));
+                    _mm_storeu_si128(dst + 1, _mm_cvtepu8_epi32(_mm_srli_si128(input, 4)));
+                    _mm_storeu_si128(dst + 2, _mm_cvtepu8_epi32(_mm_srli_si128(input, 8)));
+                    _mm_storeu_si128(dst + 3, _mm_cvtepu8_epi32(_mm_srli_si128(input, 12)));
+                    i += 16;
+                    written += 16;
+                    continue;
+                }
+            }
+            // Decode one code point, then try the fast path again.
+            unsigned char b = at(s, i);
+            size_t len = b < 0x80 ? 1 : b < 0xE0 ? 2 : b < 0xF0 ? 3 : 4;
+            written += UTF8::decodeScalar(s + i, len, out + written);
+            i += len;
+        }
+        return written;
+    }
+
+    SWEETIE_TARGET("avx2")
+    size_t decodeAVX2(const char* s, size_t n, char32_t* out) {
+        size_t i = 0, written = 0;
+        while (i < n) {
+            if (i + 32 <= n) {
+                __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+                if (_mm256_movemask_epi8(input) == 0) {
+                    __m256i* dst = reinterpret_cast<__m256i*>(out + written);
+                    __m128i lo = _mm256_castsi256_si128(input);
+                    __m128i hi = _mm256_extracti128_si256(input, 1);
+                    _mm256_storeu_si256(dst + 0, _mm256_cvtepu8_epi32(lo));
+                    _mm256_storeu_si256(dst + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+                    _mm256_storeu_si256(dst + 2, _mm256_cvtepu8_epi32(hi));
+                    _mm256_storeu_si256(dst + 3, _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+                    i += 32;
+                    written += 32;
+                    continue;
+                }
+            }
+            unsigned char b = at(s, i);
+            size_t len = b < 0x80 ? 1 : b < 0xE0 ? 2 : b < 0xF0 ? 3 : 4;
+            written += UTF8::decodeScalar(s + i, len, out + written);
+            i += len;
+        }
+        return written;
+    }
+
+    SWEETIE_TARGET("sse4.2")
+    void boundariesSSE42(const char* s, size_t n, uint32_t base, std::vector<uint32_t>& out) {
+        const __m128i leadMin = _mm_set1_epi8(static_cast<char>(0xC0));
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            // Continuation bytes are 0x80..0xBF, i.e. the signed bytes below -64.
+            unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(leadMin, input))) & 0xFFFF;
+            while (mask) {
+                out.push_back(base + static_cast<uint32_t>(i + SWEETIE_CTZ(mask)));
+                mask &= mask - 1;
+            }
+        }
+        for (; i < n; ++i) {
+            if ((at(s, i) & 0xC0) != 0x80) out.push_back(base + static_cast<uint32_t>(i));
+        }
+    }
+
+#endif // SWEETIE_X86
+
+}
+
+namespace UTF8 {
+
+    size_t validateScalar(const char* s, size_t n) {
+        size_t i = 0;
+        while (i < n) {
+            unsigned char b = at(s, i);
+            if (b < 0x80) {
+                i++;
+                continue;
+            }
+            size_t len;
+            unsigned char lo = 0x80, hi = 0xBF;
+            if (b >= 0xC2 && b <= 0xDF) {
+                len = 2;
+            }
+            else if (b >= 0xE0 && b <= 0xEF) {
+                len = 3;
+                if (b == 0xE0) lo = 0xA0;      // overlong
+                else if (b == 0xED) hi = 0x9F; // surrogates
+            }
+            else if (b >= 0xF0 && b <= 0xF4) {
+                len = 4;
+                if (b == 0xF0) lo = 0x90;      // overlong
+                else if (b == 0xF4) hi = 0x8F; // above U+10FFFF
+            }
+            else {
+                return i;
+            }
+            if (i + len > n) {
+                return i;
+            }
+            unsigned char b1 = at(s, i + 1);
+            if (b1 < lo || b1 > hi) {
+                return i;
+            }
+            for (size_t k = 2; k < len; ++k) {
+                if ((at(s, i + k) & 0xC0) != 0x80) {
+                    return i;
+                }
+            }
+            i += len;
+        }
+        return n;
+    }
+
+    size_t decodeScalar(const char* s, size_t n, char32_t* out) {
+        size_t i = 0, written = 0;
+        while (i < n) {
+            unsigned char b = at(s, i);
+            if (b < 0x80) {
+                out[written++] = b;
+                i++;
+            }
+            else if (b < 0xE0) {
+                out[written++] = ((b & 0x1F) << 6) | (at(s, i + 1) & 0x3F);
+                i += 2;
+            }
+            else if (b < 0xF0) {
+                out[written++] = ((b & 0x0F) << 12) | ((at(s, i + 1) & 0x3F) << 6) | (at(s, i + 2) & 0x3F);
+                i += 3;
+            }
+            else {
+                out[written++] = ((b & 0x07) << 18) | ((at(s, i + 1) & 0x3F) << 12)
+                    | ((at(s, i + 2) & 0x3F) << 6) | (at(s, i + 3) & 0x3F);
+                i += 4;
+            }
+        }
+        return written;
+    }
+
+    size_t validate(const char* s, size_t n) {
+#ifdef SWEETIE_X86
+        switch (level) {
+        case Level::AVX2: return validateAVX2(s, n);
+        case Level::SSE42: return validateSSE42(s, n);
+        default: break;
+        }
+#endif
+        return validateScalar(s, n);
+    }
+
+    bool isValid(const char* s, size_t n) {
+        return validate(s, n) == n;
+    }
+
+    bool isASCII(const char* s, size_t n) {
+#ifdef SWEETIE_X86
+        switch (level) {
+        case Level::AVX2: return asciiPrefixAVX2(s, n) == n;
+        case Level::SSE42: return asciiPrefixSSE42(s, n) == n;
+        default: break;
+        }
+#endif
+        for (size_t i = 0; i < n; ++i) {
+            if (at(s, i) >= 0x80) return false;
+        }
+        return true;
+    }
+
+    size_t decode(const char* s, size_t n, char32_t* out) {
+#ifdef SWEETIE_X86
+        switch (level) {
+        case Level::AVX2: return decodeAVX2(s, n, out);
+        case Level::SSE42: return decodeSSE42(s, n, out);
+        default: break;
+        }
+#endif
+        return decodeScalar(s, n, out);
+    }
+
+    size_t count(const char* s, size_t n) {
+        size_t result = 0;
+        for (size_t i = 0; i < n; ++i) {
+            result += (at(s, i) & 0xC0) != 0x80;
+        }
+        return result;
+    }
+
+    void boundaries(const char* s, size_t n, uint32_t base, std::vector<uint32_t>& out) {
+#ifdef SWEETIE_X86
+        if (level != Level::Scalar) {
+            boundariesSSE42(s, n, base, out);
+            return;
+        }
+#endif
+        for (size_t i = 0; i < n; ++i) {
+            if ((at(s, i) & 0xC0) != 0x80) out.push_back(base + static_cast<uint32_t>(i));
+        }
+    }
+
+};
@@ -0,0 +1,43 @@
+#ifndef _UTF8_HH_
+#define _UTF8_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bulk UTF-8 routines used when subject text is ingested.
+//
+// Each entry point picks the widest implementation the running CPU supports
+// (AVX2, then SSE4.2, then portable scalar code). All implementations agree
+// exactly, including on the offset of the first error.
+namespace UTF8 {
+
+    // Returns the offset of the first byte that does not begin a well-formed
+    // sequence, or n if the whole buffer is valid UTF-8.
+    //
+    // Overlong encodings, surrogates (U+D800..U+DFFF), code points above
+    // U+10FFFF, stray continuation bytes and truncated sequences are errors.
+    size_t validate(const char* s, size_t n);
+
+    bool isValid(const char* s, size_t n);
+
+    // Returns true if every byte is below 0x80.
+    bool isASCII(const char* s, size_t n);
+
+    // Decodes valid UTF-8 into out, which must have room for n code points.
+    // Returns the number of code points written.
+    // The input must have been checked with validate() first.
+    size_t decode(const char* s, size_t n, char32_t* out);
+
+    // Number of code points in valid UTF-8.
+    size_t count(const char* s, size_t n);
+
+    // Appends base + offset for the first byte of every code point.
+    void boundaries(const char* s, size_t n, uint32_t base, std::vector<uint32_t>& out);
+
+    // Scalar reference implementations, also used for the tails of buffers.
+    size_t validateScalar(const char* s, size_t n);
+    size_t decodeScalar(const char* s, size_t n, char32_t* out);
+};
+
+#endif // !_UTF8_HH_
@@ -1,113 +1,576 @@
 #include "vm.hh"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 
-VM::VM(Program _program) : program(_program), positionOfInstructions(0), positionOfText(0)
+VM::VM(Program _program) : VM(std::make_shared<const Program>(std::move(_program)))
 {
 }
 
-bool VM::test(String _text)
+VM::VM(std::shared_ptr<const Program> _program) : program(std::move(_program)), slotCount(0)
+{
+	if (program->hasBackreferences)
+	{
+		throw std::runtime_error("Backreferences are not supported by the Pike VM");
+	}
+	if (program->atomicGroups)
+	{
+		throw std::runtime_error("Atomic groups are not supported by the Pike VM");
+	}
+	if (program->states(maxStates) > maxStates)
+	{
+		throw std::runtime_error("Nested counted repetitions are too large for the Pike VM");
+	}
+	std::vector<size_t> copies = program->copies(radix);
+	base.resize(program->size());
+	for (size_t pc = 0; pc < program->size(); ++pc)
+	{
+		base[pc] = pcOf.size();
+		size_t width = (*program)[pc].code == ByteCode::String ? (*program)[pc].operand_2 : 1;
+		pcOf.insert(pcOf.end(), width * copies[pc], pc);
+	}
+	for (const Lookaround& lookaround : program->lookarounds)
+	{
+		lookarounds.push_back(std::make_unique<VM>(lookaround.body));
+	}
+	holds.resize(lookarounds.size());
+}
+
+bool VM::supports(const Program& program)
+{
+	return !program.hasBackreferences && !program.atomicGroups && program.states(maxStates) <= maxStates;
+}
+
+VM::Result VM::test(StringView _text)
 {
 	text = _text;
-    /*while (positionOfInstructions < program.size())
-    {
-        switch (program[positionOfInstructions].code)
-        {
-        case ByteCode::Match:
-            if (match1(ch())) {
-                return 
-            }
-            break;
-        default:
-            break;
-        }
+	end = text.size();
+	meter.start(budget);
+	return run(0, false, nullptr);
+}
 
-        positionOfInstructions++;
-        advance();
-    }*/
-	return false;
+VM::Result VM::search(StringView _text, Captures& captures, size_t start, bool anchored)
+{
+	text = _text;
+	end = text.size();
+	meter.start(budget);
+	return run(start, anchored, &captures);
 }
 
-bool VM::advance()
+void VM::ThreadList::reset(size_t states, size_t slotCount)
 {
-	return positionOfText < text.length() ? ++positionOfText : false;
+	dense.resize(states);
+	sparse.resize(states);
+	slots.resize(states * slotCount);
+	size = 0;
 }
 
-Char VM::ch()
+VM::Result VM::run(size_t start, bool anchored, Captures* captures)
 {
-	return text[positionOfText];
+	// 只有明确接着上次搜索同一文本时（见 Matches）才复用断言表，文本内容可能已变
+	bool reuse = continuing && evaluated.data() == text.data() && evaluated.size() == text.size();
+	continuing = false;
+	if (!program->lookarounds.empty() && !reuse)
+	{
+		if (!evaluateLookarounds(meter))
+		{
+			return Result::BudgetExceeded;
+		}
+	}
+	slotCount = captures ? 2 * program->groups : 0;
+	current.reset(pcOf.size(), slotCount);
+	next.reset(pcOf.size(), slotCount);
+	scratch.resize(slotCount);
+	if (!meter.check(footprint()))
+	{
+		return Result::BudgetExceeded;
+	}
+
+	bool matched = false;
+	size_t position = start;
+	while (true)
+	{
+		// 新线程的优先级低于所有已存在的线程，保证最左匹配
+		if (!matched && (!anchored || position == start))
+		{
+			std::fill(scratch.begin(), scratch.end(), npos);
+			addThread(current, 0, position, scratch.data());
+		}
+		if (current.size == 0)
+		{
+			break;
+		}
+		if (!meter.tick(current.size) && !meter.check(footprint()))
+		{
+			return Result::BudgetExceeded;
+		}
+
+		// 无效的 UTF-8 字节不是字符，任何类都不匹配它
+		size_t length;
+		char32_t c = text.decode(position, length);
+		Char ch = length > 1 || c < 0x80 ? Char(static_cast<int>(c)) : Char();
+		next.size = 0;
+		for (size_t i = 0; i < current.size; ++i)
+		{
+			size_t state = current.dense[i];
+			size_t pc = pcOf[state];
+			const Instruction& instruction = (*program)[pc];
+			const size_t* slots = current.slots.data() + state * slotCount;
+
+			if (instruction.code == ByteCode::Match)
+			{
+				if (length && program->matcher(instruction).match(ch))
+				{
+					addThread(next, pc + 1, position + length, slots, state - base[pc]);
+				}
+			}
+			else if (instruction.code == ByteCode::String)
+			{
+				size_t k;
+				size_t offset = offsetOf(state, pc, k);
+				std::string_view literal = program->literal(instruction);
+				if (length && k + length <= literal.size()
+					&& std::memcmp(text.data() + position, literal.data() + k, length) == 0)
+				{
+					if (k + length == literal.size())
+					{
+						addThread(next, pc + 1, position + length, slots, offset);
+					}
+					else if (!next.contains(state + length))
+					{
+						next.insert(state + length);
+						std::copy(slots, slots + slotCount, next.slots.data() + (state + length) * slotCount);
+					}
+				}
+			}
+			else if (instruction.code == ByteCode::Accept)
+			{
+				if (!captures)
+				{
+					return Result::Match;
+				}
+				matched = true;
+				captures->assign(slots, slots + slotCount);
+				// 优先级更低的线程不再需要
+				break;
+			}
+		}
+
+		std::swap(current, next);
+		if (length == 0)
+		{
+			break;
+		}
+		position += length;
+	}
+	return matched ? Result::Match : Result::NoMatch;
 }
 
-void VM::keep()
+// Splits a state of the instruction at pc into the offset of its counts and
+// the progress k inside a literal.
+size_t VM::offsetOf(size_t state, size_t pc, size_t& k) const
 {
-	while (match1(ch()) && advance()) {}
+	k = state - base[pc];
+	const Instruction& instruction = (*program)[pc];
+	size_t width = instruction.code == ByteCode::String ? instruction.operand_2 : 1;
+	if (k < width)
+	{
+		return 0;
+	}
+	size_t offset = k / width;
+	k -= offset * width;
+	return offset;
 }
 
-bool VM::match1(Char c)
+// Adds the thread at pc, with the counts in offset, to list, following every
+// instruction that does not consume input. Only the first thread to reach a
+// state is kept.
+void VM::addThread(ThreadList& list, size_t pc, size_t position, const size_t* slots, size_t offset)
 {
-	return program[positionOfInstructions].matcher->match(c);
+	if (slots != scratch.data())
+	{
+		std::copy(slots, slots + slotCount, scratch.begin());
+	}
+	stack.clear();
+	stack.push_back({ pc, offset, npos, 0 });
+	while (!stack.empty())
+	{
+		Frame frame = stack.back();
+		stack.pop_back();
+		if (frame.slot != npos)
+		{
+			scratch[frame.slot] = frame.value;
+			continue;
+		}
+
+		pc = frame.pc;
+		offset = frame.offset;
+		while (true)
+		{
+			size_t state = base[pc];
+			if (offset)
+			{
+				const Instruction& instruction = (*program)[pc];
+				state += offset * (instruction.code == ByteCode::String ? instruction.operand_2 : 1);
+			}
+			if (list.contains(state))
+			{
+				break;
+			}
+			list.insert(state);
+
+			const Instruction& instruction = (*program)[pc];
+			switch (instruction.code)
+			{
+			case ByteCode::Jump:
+				pc = instruction.operand_1;
+				continue;
+			case ByteCode::Split:
+				stack.push_back({ instruction.operand_2, offset, npos, 0 });
+				pc = instruction.operand_1;
+				continue;
+			case ByteCode::Repeat:
+			{
+				const Counter& counter = program->counters[instruction.operand_1];
+				size_t weight = radix[instruction.operand_1];
+				size_t count = offset / weight % (counter.limit() + size_t(1));
+				size_t exit = offset - count * weight;
+				if (count < counter.min)
+				{
+					pc++;
+				}
+				else if (counter.max != Counter::unbounded && count == counter.max)
+				{
+					pc = instruction.operand_2;
+					offset = exit;
+				}
+				else if (counter.lazy)
+				{
+					stack.push_back({ pc + 1, offset, npos, 0 });
+					pc = instruction.operand_2;
+					offset = exit;
+				}
+				else
+				{
+					stack.push_back({ instruction.operand_2, exit, npos, 0 });
+					pc++;
+				}
+				continue;
+			}
+			case ByteCode::Loop:
+			{
+				const Counter& counter = program->counters[instruction.operand_1];
+				size_t weight = radix[instruction.operand_1];
+				if (offset / weight % (counter.limit() + size_t(1)) < counter.limit())
+				{
+					offset += weight;
+				}
+				pc = instruction.operand_2;
+				continue;
+			}
+			case ByteCode::Capture:
+				if (instruction.operand_1 < slotCount)
+				{
+					stack.push_back({ 0, 0, instruction.operand_1, scratch[instruction.operand_1] });
+					scratch[instruction.operand_1] = position;
+				}
+				pc++;
+				continue;
+			case ByteCode::Anchor:
+				if (instruction.operand_1 == static_cast<size_t>(AnchorType::Begin)
+					? position == 0 : position == end)
+				{
+					pc++;
+					continue;
+				}
+				// Kept with its slots, for a Stream to resume once it ends
+				std::copy(scratch.begin(), scratch.begin() + slotCount, list.slots.data() + state * slotCount);
+				break;
+			case ByteCode::Assert:
+				if (holds[instruction.operand_1][position])
+				{
+					pc++;
+					continue;
+				}
+				break;
+			default:
+				std::copy(scratch.begin(), scratch.begin() + slotCount, list.slots.data() + state * slotCount);
+				break;
+			}
+			break;
+		}
+	}
+}
+
+// Bytes of scratch held by the thread lists, the closure stack and the
+// lookaround tables.
+size_t VM::footprint() const
+{
+	size_t bytes = 2 * (current.dense.size() + current.sparse.size() + current.slots.size()) * sizeof(size_t)
+		+ stack.capacity() * sizeof(Frame);
+	for (const std::vector<uint8_t>& h : holds)
+	{
+		bytes += h.size();
+	}
+	return bytes;
 }
 
-bool VM::match0or1()
+// Returns false if the budget ran out. The tables are then left unevaluated.
+bool VM::evaluateLookarounds(Meter& _meter)
 {
-	if (match1(ch()))
+	evaluated = StringView();
+	for (size_t i = 0; i < lookarounds.size(); ++i)
 	{
-		advance();
+		const Lookaround& lookaround = program->lookarounds[i];
+		if (!lookarounds[i]->scan(text, lookaround.ahead, holds[i], &_meter))
+		{
+			return false;
+		}
+		if (!lookaround.positive)
+		{
+			for (uint8_t& h : holds[i])
+			{
+				h = !h;
+			}
+		}
 	}
+	evaluated = text;
 	return true;
 }
 
-bool VM::match1orMore()
+bool VM::scan(StringView _text, bool backward, std::vector<uint8_t>& marks, Meter* _meter)
 {
-	if (!match1(ch()))
+	marks.assign(_text.size() + 1, 0);
+	return sweep(_text, backward, _meter, &marks, nullptr);
+}
+
+bool VM::scanAccepts(StringView _text, std::vector<uint8_t>& accepted)
+{
+	return sweep(_text, false, nullptr, nullptr, &accepted);
+}
+
+// Runs the program from every position of text at once, and records where
+// matches end in marks and which Accepts they reach in accepted.
+bool VM::sweep(StringView _text, bool backward, Meter* _meter, std::vector<uint8_t>* marks,
+	std::vector<uint8_t>* accepted)
+{
+	text = _text;
+	end = text.size();
+	if (!_meter)
+	{
+		meter.start(budget);
+		_meter = &meter;
+	}
+	if (!program->lookarounds.empty() && !evaluateLookarounds(*_meter))
+	{
+		return false;
+	}
+	slotCount = 0;
+	current.reset(pcOf.size(), 0);
+	next.reset(pcOf.size(), 0);
+	size_t held = marks ? marks->size() : 0;
+	if (!_meter->check(footprint() + held))
 	{
 		return false;
 	}
-	advance();
-	keep();
+
+	size_t position = backward ? text.size() : 0;
+	while (true)
+	{
+		addThread(current, 0, position, scratch.data());
+		if (!_meter->tick(current.size) && !_meter->check(footprint() + held))
+		{
+			return false;
+		}
+
+		// The character read next, at [at, at + length)
+		size_t at = position;
+		size_t length = 0;
+		char32_t codepoint = Char::none;
+		if (backward ? position > 0 : position < text.size())
+		{
+			at = backward ? text.prev(position) : position;
+			codepoint = text.decode(at, length);
+			if (backward && at + length != position)
+			{
+				at = position - 1;
+				codepoint = text.byte(at);
+				length = 1;
+			}
+		}
+		Char c = length > 1 || (length && codepoint < 0x80) ? Char(static_cast<int>(codepoint)) : Char();
+		size_t to = backward ? position - length : position + length;
+
+		next.size = 0;
+		for (size_t i = 0; i < current.size; ++i)
+		{
+			size_t state = current.dense[i];
+			size_t pc = pcOf[state];
+			const Instruction& instruction = (*program)[pc];
+			if (instruction.code == ByteCode::Accept)
+			{
+				if (marks)
+				{
+					(*marks)[position] = 1;
+				}
+				if (accepted)
+				{
+					(*accepted)[instruction.operand_1] = 1;
+				}
+			}
+			else if (length == 0)
+			{
+				continue;
+			}
+			else if (instruction.code == ByteCode::Match)
+			{
+				if (program->matcher(instruction).match(c))
+				{
+					addThread(next, pc + 1, to, nullptr, state - base[pc]);
+				}
+			}
+			else if (instruction.code == ByteCode::String)
+			{
+				size_t k;
+				size_t offset = offsetOf(state, pc, k);
+				std::string_view literal = program->literal(instruction);
+				if (k + length <= literal.size()
+					&& std::memcmp(text.data() + at, literal.data() + k, length) == 0)
+				{
+					if (k + length == literal.size())
+					{
+						addThread(next, pc + 1, to, nullptr, offset);
+					}
+					else if (!next.contains(state + length))
+					{
+						next.insert(state + length);
+					}
+				}
+			}
+		}
+
+		std::swap(current, next);
+		if (length == 0)
+		{
+			break;
+		}
+		position = to;
+	}
 	return true;
 }
 
-bool VM::match0orMore()
+
+String Instruction::toString(const Program& program) const
 {
-	keep();
-	return true;
+	switch (code)
+	{
+	case ByteCode::Jump:
+		return "Jump " + String(static_cast<int>(operand_1));
+	case ByteCode::Split:
+		return "Split " + String(static_cast<int>(operand_1)) + ", " + String(static_cast<int>(operand_2));
+	case ByteCode::Match:
+		return "Match " + program.matcher(*this).toString();
+	case ByteCode::String:
+		return "String \"" + String(std::string(program.literal(*this))) + "\"";
+	case ByteCode::ByteRange:
+		return "ByteRange " + toHexString(static_cast<int>(operand_1)) + "-" + toHexString(static_cast<int>(operand_2));
+	case ByteCode::Repeat:
+	{
+		const Counter& counter = program.counters[operand_1];
+		String bounds = String(static_cast<int>(counter.min)) + ","
+			+ (counter.max == Counter::unbounded ? String("") : String(static_cast<int>(counter.max)));
+		return "Repeat " + String(static_cast<int>(operand_1)) + " {" + bounds + "}" + (counter.lazy ? "?" : "")
+			+ ", " + String(static_cast<int>(operand_2));
+	}
+	case ByteCode::Loop:
+		return "Loop " + String(static_cast<int>(operand_1)) + ", " + String(static_cast<int>(operand_2));
+	case ByteCode::Atomic:
+		return "Atomic " + String(static_cast<int>(operand_1)) + ", " + String(static_cast<int>(operand_2));
+	case ByteCode::Commit:
+		return "Commit " + String(static_cast<int>(operand_1));
+	case ByteCode::Anchor:
+		return String("Anchor ") + (operand_1 == static_cast<size_t>(AnchorType::Begin) ? "^" : "$");
+	case ByteCode::Capture:
+		return "Capture " + String(static_cast<int>(operand_1));
+	case ByteCode::Assert:
+		return "Assert " + String(static_cast<int>(operand_1));
+	case ByteCode::Ref:
+		return "Ref " + String(static_cast<int>(operand_1));
+	case ByteCode::Accept:
+		return operand_1 ? "Accept " + String(static_cast<int>(operand_1)) : String("Accept");
+	default:
+		return "Halt";
+	}
 }
 
-bool VM::match_or_(int m, int n)
-{
-    if (n == -1) {
-        // n为-1时，相当于*原语，匹配0次或多次，至少m次
-        int count = 0;
-        size_t old_positionOfText = positionOfText;
-        while (old_positionOfText < text.length() && match1(ch()) && count < m) {
-            advance();
-            count++;
-        }
-        if (count < m) {
-            return false; // 没有达到最小匹配次数m
-        }
-        positionOfText = old_positionOfText;
-        keep();
-        return true;
-    }
-    else {
-        // n为非负数时，匹配m到n次
-        int count = 0;
-        while (count < m && positionOfText < text.length() && match1(ch())) {
-            advance();
-            count++;
-        }
-        if (count < m) {
-            return false; // 没有达到最小匹配次数m
-        }
-        while (count < n && positionOfText < text.length() && match1(ch())) {
-            advance();
-            count++;
-        }
-        // 回退到最后一个未满足n次但满足m次的位置
-        if (count > m && count > n) {
-            positionOfText -= count - n;
-        }
-        return true;
-    }
+size_t Program::loopEnd(size_t head) const
+{
+	size_t pc = head + 1;
+	while (instructions[pc].code != ByteCode::Loop || instructions[pc].operand_1 != instructions[head].operand_1)
+	{
+		pc++;
+	}
+	return pc;
 }
 
+std::vector<size_t> Program::copies(std::vector<size_t>& radix) const
+{
+	// 外层循环的 Repeat 在前，处理到内层时 result 已含外层的乘积
+	std::vector<size_t> result(size(), 1);
+	radix.assign(counters.size(), 1);
+	for (size_t pc = 0; pc < size(); ++pc)
+	{
+		if (instructions[pc].code == ByteCode::Repeat)
+		{
+			radix[instructions[pc].operand_1] = result[pc];
+			size_t counts = counters[instructions[pc].operand_1].limit() + size_t(1);
+			for (size_t i = pc, end = loopEnd(pc); i <= end; ++i)
+			{
+				result[i] *= counts;
+			}
+		}
+	}
+	return result;
+}
+
+size_t Program::states(size_t limit) const
+{
+	// 与 copies() 相同，但乘积超过 limit 时就停下，不会溢出
+	std::vector<size_t> counts(size(), 1);
+	size_t total = 0;
+	for (size_t pc = 0; pc < size(); ++pc)
+	{
+		if (instructions[pc].code == ByteCode::Repeat)
+		{
+			size_t factor = counters[instructions[pc].operand_1].limit() + size_t(1);
+			for (size_t i = pc, end = loopEnd(pc); i <= end; ++i)
+			{
+				counts[i] = counts[i] > limit / factor ? limit + 1 : counts[i] * factor;
+			}
+		}
+		size_t width = instructions[pc].code == ByteCode::String ? instructions[pc].operand_2 : 1;
+		if ((width && counts[pc] > limit / width) || total + width * counts[pc] > limit)
+		{
+			return limit + 1;
+		}
+		total += width * counts[pc];
+	}
+	return total;
+}
+
+String Program::toString() const
+{
+	String s;
+	for (size_t i = 0; i < instructions.size(); ++i)
+	{
+		s += String(static_cast<int>(i)) + "\t" + instructions[i].toString(*this) + "\n";
+	}
+	for (size_t i = 0; i < lookarounds.size(); ++i)
+	{
+		const Lookaround& l = lookarounds[i];
+		s += "Lookaround " + String(static_cast<int>(i)) + ": "
+			+ (l.positive ? "" : "negative ") + (l.ahead ? "lookahead\n" : "lookbehind\n")
+			+ l.body->toString();
+	}
+	return s;
+}
@@ -2,65 +2,305 @@
 #define _VM_HH_
 
 #include <variant>
+#include "budget.hh"
 #include "parser.hh"
 #include "matcher.hh"
 
-enum class ByteCode
+enum class ByteCode : uint8_t
 {
-	Jump, Split, Match, Repeat, Anchor, Capture, Assert, Ref, Accept, Halt
+	Jump, Split, Match, String, ByteRange, Repeat, Loop, Atomic, Commit, Anchor, Capture, Assert, Ref, Accept, Halt
 };
 
+// Operand of ByteCode::Anchor
+enum class AnchorType : size_t
+{
+	Begin, End
+};
+
+struct Program;
+
+// Jump    operand_1 = target
+// Split   operand_1 = preferred target, operand_2 = alternative target
+// Match   operand_1 = index into Program::matchers, consumes one character
+// String  operand_1 = offset into Program::literals, operand_2 = length,
+//         consumes that many bytes
+// ByteRange operand_1 = lowest byte, operand_2 = highest byte, consumes one
+//         byte (only in programs lowered by Compiler::toBytes())
+// Repeat  operand_1 = index into Program::counters, operand_2 = exit. Head
+//         of a counted loop: enters the body at pc + 1 while the count is
+//         below min, may enter it or exit while it is below max, and exits
+//         otherwise. Exiting resets the count to 0.
+// Loop    operand_1 = counter, operand_2 = head, closes the body of a counted
+//         loop: counts one more turn and goes back to the head
+// Atomic  operand_1 = atomic group, operand_2 = pc of its Commit, enters the
+//         body of an atomic group (?>e) at pc + 1
+// Commit  operand_1 = atomic group, leaves it: the backtrack points left in
+//         its body are discarded, so only the first way through is tried
+// Anchor  operand_1 = AnchorType
+// Capture operand_1 = slot (2 * group for the start, 2 * group + 1 for the end)
+// Assert  operand_1 = index into Program::lookarounds
+// Ref     operand_1 = group
+// Accept  operand_1 = pattern, the whole pattern has matched. Only the
+//         union programs of a RegexSet have patterns other than 0.
+// Halt    the thread fails
+//
+// An instruction is a plain 12-byte value. Classes and literals live in side
+// tables of the Program, so copying a program costs a few flat copies rather
+// than an allocation per instruction.
 struct Instruction
 {
 	ByteCode code;
 
-	size_t operand_1;
-	size_t operand_2;
+	uint32_t operand_1;
+	uint32_t operand_2;
 
-	std::unique_ptr<Matcher> matcher;
-	bool isNegative;
-	Instruction(ByteCode _code, bool _isNegative = false)
-		: code(_code), isNegative(_isNegative) {
-		matcher = nullptr;
-	}
-	Instruction(std::unique_ptr<Matcher> _m) {
-		code = ByteCode::Match;
-		matcher = std::move(_m);
-		isNegative = matcher->isNegative;
+	Instruction(ByteCode _code, size_t _operand_1 = 0, size_t _operand_2 = 0)
+		: code(_code), operand_1(static_cast<uint32_t>(_operand_1)),
+		operand_2(static_cast<uint32_t>(_operand_2)) {}
+
+	String toString(const Program& program) const;
+};
+
+static_assert(std::is_trivially_copyable_v<Instruction>);
+
+
+// A lookaround assertion, compiled separately from the main program.
+//
+// The body is compiled in the direction the engines scan it: forward for a
+// lookbehind, whose matches must end at the position being tested, and in
+// reverse for a lookahead, whose matches must begin there.
+struct Lookaround
+{
+	bool ahead;
+	bool positive;
+	std::shared_ptr<Program> body;
+};
+
+// A counted loop, e{min,max} with max unbounded for e{min,} (see Compiler).
+struct Counter
+{
+	static constexpr uint32_t unbounded = UINT32_MAX;
+
+	uint32_t min;
+	uint32_t max;
+	bool lazy;
+
+	// Counts run from 0 to limit(): past min, an unbounded loop stops counting.
+	uint32_t limit() const { return max == unbounded ? min : max; }
+};
+
+struct Program
+{
+	std::vector<Instruction> instructions;
+
+	// Classes of the Match instructions, and the bytes of the String
+	// literals one after another.
+	std::vector<Matcher> matchers;
+	std::string literals;
+
+	// Number of capturing groups, counting the whole match as group 0.
+	size_t groups = 1;
+
+	// Name of each named group, indexed by group number.
+	std::vector<String> names;
+
+	std::vector<Lookaround> lookarounds;
+
+	std::vector<Counter> counters;
+
+	// Number of atomic groups, as numbered by Atomic and Commit. Only the
+	// backtracker runs programs that have any.
+	size_t atomicGroups = 0;
+
+	bool hasBackreferences = false;
+
+	size_t size() const { return instructions.size(); }
+	Instruction& operator[](size_t i) { return instructions[i]; }
+	const Instruction& operator[](size_t i) const { return instructions[i]; }
+
+	const Matcher& matcher(const Instruction& instruction) const {
+		return matchers[instruction.operand_1];
 	}
-	Instruction(const Instruction& i)
-		: code(i.code), isNegative(i.isNegative) {
-		if (i.matcher) {
-			matcher = std::make_unique<Matcher>(*i.matcher);
-		}
-		else {
-			matcher = nullptr;
-		}
+	std::string_view literal(const Instruction& instruction) const {
+		return { literals.data() + instruction.operand_1, instruction.operand_2 };
 	}
-};
 
+	// pc of the Loop that closes the counted loop whose Repeat is at head.
+	// Every pc in between belongs to its body.
+	size_t loopEnd(size_t head) const;
+
+	// For every pc, the number of combinations of counts the counted loops
+	// around it can hold, i.e. how many states it stands for; and in radix,
+	// the weight of each counter in the offset of a state (see VM).
+	std::vector<size_t> copies(std::vector<size_t>& radix) const;
+
+	// Total number of states the engines number (see VM), with the bytes of
+	// a String counted one by one. Counts past limit are not worked out:
+	// nested counted loops multiply their counts, which can overflow, so
+	// anything over limit returns limit + 1.
+	size_t states(size_t limit) const;
+
+	String toString() const;
+};
 
-using Program = std::vector<Instruction>;
+// Byte offsets of the capture group boundaries: slot 2k is where group k
+// starts and slot 2k + 1 where it ends. Unset slots hold VM::npos.
+using Captures = std::vector<size_t>;
 
+// Pike VM.
+//
+// All threads of the program advance over the text in lockstep, one
+// character at a time. Two threads that reach the same state at the same
+// position can only behave the same from then on, so only the one with the
+// higher priority is kept. A search therefore costs O(n * m) time for n
+// characters of text and m states, whatever the pattern and the input.
+//
+// Threads are kept in priority order, which gives leftmost-first (Perl)
+// semantics: the first alternative wins, greedy quantifiers prefer more and
+// lazy ones prefer less.
+//
+// Lookarounds never start a nested search. Before the main search, each
+// lookaround body is run once over the whole text by a child VM, in the
+// manner of Mamouras and Chattopadhyay, "Efficient Matching of Regular
+// Expressions with Lookaround Assertions": a lookbehind is scanned forwards
+// and marks every position where a match of its body ends, a lookahead is
+// scanned backwards in reverse and marks every position where one begins.
+// Nested lookarounds are evaluated first, by the children's own children.
+// Assert then reads one entry of a table, and the whole search stays linear.
+// Captures inside lookarounds are not reported, and a backreference inside
+// one, which would need the captures of the search, is rejected by the
+// Compiler.
+//
+// Every search is metered against a Budget (none by default): a step is one
+// live thread reading one character, and lookaround bodies are scanned on
+// the meter of the search that needs them.
+//
+// A VM holds the state of the search it runs, so it serves one thread at a
+// time. Threads share the program instead, each with a VM of its own (see
+// Pattern).
 class VM
 {
-	Program program;
-	size_t positionOfText;
-	size_t positionOfInstructions;
-	String text;
+	friend class Pattern;
+	friend class Stream;
+
 public:
+	static constexpr size_t npos = static_cast<size_t>(-1);
+
+	// Most states a program may have (see Program::states()). Every state
+	// takes a few words in each thread list before the first byte is read,
+	// and counted loops nested in one another multiply their counts, so
+	// (?:(?:x{2,300}){2,300}){2,300} alone would have 27 million.
+	static constexpr size_t maxStates = 1 << 20;
+
+	enum class Result { Match, NoMatch, BudgetExceeded };
+
+	// The program is shared, not copied: any number of engines can run one
+	// program at once.
+	VM(std::shared_ptr<const Program> _program);
 	VM(Program _program);
-	bool test(String _text);
+
+	// Whether a VM can run program: one without backreferences or atomic
+	// groups, and with at most maxStates states.
+	static bool supports(const Program& program);
+
+	// Whether the pattern matches anywhere in text.
+	Result test(StringView _text);
+
+	// Finds the leftmost match that begins at or after start and stores its
+	// 2 * groups capture slots in captures. If anchored is true the match must
+	// begin at start.
+	Result search(StringView _text, Captures& captures, size_t start = 0, bool anchored = false);
+
+	// Runs the program from every position of text at once and sets marks[p]
+	// if a match ends at p. A reverse program scanned backward sets marks[p]
+	// if a match of the original pattern begins at p. This is how lookaround
+	// tables are built (see above). The scan counts against _meter if one is
+	// given, and against the VM's own budget otherwise. Returns false if the
+	// budget ran out.
+	bool scan(StringView _text, bool backward, std::vector<uint8_t>& marks, Meter* _meter = nullptr);
+
+	// Runs the program forward from every position of text at once, as
+	// scan() does, and sets accepted[i] if a match reaches Accept i (see
+	// Compiler::compileSet()). Returns false if the budget ran out.
+	bool scanAccepts(StringView _text, std::vector<uint8_t>& accepted);
+
+	void setBudget(const Budget& _budget) { budget = _budget; }
 
 private:
-	bool advance();
-	Char ch();
-	void keep();
-	bool match1(Char ch);
-	bool match0or1();
-	bool match1orMore();
-	bool match0orMore();
-	bool match_or_(int m, int n);
+	// A state is an instruction plus the progress made inside it, i.e. the
+	// number of bytes of a String literal matched so far, and the counts of
+	// the counted loops around it. States are numbered densely: (pc, k) is
+	// state base[pc] + k, and with counts, base[pc] + offset * width + k,
+	// where width is the length of the literal (or 1) and the offset sums
+	// count * radix over the enclosing loops. Counts of the loops a thread is
+	// not in are always 0, so they never tell two states apart.
+	//
+	// Each list is a sparse set over the states, so that insertion, lookup
+	// and clearing are O(1), with the capture slots of every live thread.
+	struct ThreadList
+	{
+		std::vector<size_t> dense;
+		std::vector<size_t> sparse;
+		std::vector<size_t> slots;
+		size_t size = 0;
+
+		void reset(size_t states, size_t slotCount);
+		bool contains(size_t state) const {
+			size_t i = sparse[state];
+			return i < size && dense[i] == state;
+		}
+		void insert(size_t state) {
+			sparse[state] = size;
+			dense[size++] = state;
+		}
+	};
+
+	// Work item of the epsilon closure: either a state to explore or a
+	// capture slot to restore once the branch that set it has been explored.
+	struct Frame
+	{
+		size_t pc;
+		size_t offset;
+		size_t slot;
+		size_t value;
+	};
+
+	std::shared_ptr<const Program> program;
+	std::vector<size_t> base;
+	std::vector<size_t> pcOf;
+	// Weight of each counter in the offset of a state: the product of
+	// limit() + 1 over the counted loops around it.
+	std::vector<size_t> radix;
+	StringView text;
+	// Where $ holds: the end of the text, or npos while a Stream goes on
+	size_t end = 0;
+
+	// Number of capture slots tracked by the current search.
+	size_t slotCount;
+	ThreadList current;
+	ThreadList next;
+	std::vector<Frame> stack;
+	std::vector<size_t> scratch;
+
+	// Engines for the lookaround bodies, and for each lookaround whether it
+	// holds at every byte offset of the text they were last evaluated on.
+	std::vector<std::unique_ptr<VM>> lookarounds;
+	std::vector<std::vector<uint8_t>> holds;
+	StringView evaluated;
+	// Set by Pattern for the next search only, when it goes on over the text
+	// of the last one, unchanged, so that the tables above still hold
+	bool continuing = false;
+
+	Budget budget;
+	Meter meter;
+
+	Result run(size_t start, bool anchored, Captures* captures);
+	void addThread(ThreadList& list, size_t pc, size_t position, const size_t* slots, size_t offset = 0);
+	size_t offsetOf(size_t state, size_t pc, size_t& k) const;
+	bool evaluateLookarounds(Meter& _meter);
+	bool sweep(StringView _text, bool backward, Meter* _meter, std::vector<uint8_t>* marks,
+		std::vector<uint8_t>* accepted);
+	size_t footprint() const;
 };
 
 
@@ -0,0 +1,54 @@
+#include "check.hpp"
+#include "../src/pattern.hh"
+#include <string>
+
+// The step limit the backtracker sets itself when the budget has none.
+
+// Words whose neighbours never share a letter, so that (\w+) \1 fails at
+// every position
+static std::string words(size_t size)
+{
+    std::string text;
+    for (size_t i = 0; text.size() < size; ++i)
+    {
+        text += std::string(1 + i % 7, i % 2 ? 'a' + i % 13 : 'n' + i % 13);
+        text += ' ';
+    }
+    return text;
+}
+
+TEST(default_grows_with_text)
+{
+    Pattern pattern("(\\w+) \\1");
+    std::string text = words(1300000);
+    CHECK(!pattern.test(text));
+    CHECK(pattern.test(text + "xy xy"));
+}
+
+TEST(default_still_stops_catastrophic_patterns)
+{
+    Pattern pattern("((a+)+)\\2\\1b");
+    CHECK_THROWS(pattern.test("b" + std::string(500, 'a')), BudgetExceeded);
+}
+
+TEST(steps_set_replace_default)
+{
+    Pattern pattern("(\\w+) \\1");
+    pattern.setBudget({ 1000 });
+    CHECK_THROWS(pattern.test(words(100000)), BudgetExceeded);
+}
+
+TEST(other_limits_keep_default_steps)
+{
+    Pattern pattern("((a+)+)\\2\\1b");
+    std::string text = "b" + std::string(500, 'a');
+    pattern.setBudget({ 0, 1000 });
+    CHECK_THROWS(pattern.test(text), BudgetExceeded);
+    pattern.setBudget({ 0, 0, size_t(1) << 30 });
+    CHECK_THROWS(pattern.test(text), BudgetExceeded);
+}
+
+int main()
+{
+    return __check::RunTests();
+}
@@ -0,0 +1,117 @@
+#ifndef _CHECK_HPP_
+#define _CHECK_HPP_
+
+/*
+ * A minimal test framework.
+ *
+ * Every .cc file in tests/ is a program of its own, built against the
+ * sources and run from the root of the tree:
+ *
+ *   g++ -std=c++20 -Isrc tests/counters.cc $(find src -name '*.cc' ! -name main.cc) && ./a.out
+ *
+ * The tools are tested by shell scripts, run the same way: sh tests/sweetie-gen.sh
+ *
+ * Usage:
+ *   TEST(name) { CHECK(1 + 1 == 2); CHECK_THROWS(f(), std::runtime_error); }
+ *   int main() { return __check::RunTests(); }
+ *
+ * A failed check prints where it is and the test goes on. The program exits
+ * with 1 if any check failed.
+*/
+
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace __check
+{
+
+struct Test
+{
+    const char* name;
+    std::function<void()> body;
+};
+
+inline std::vector<Test>& Tests()
+{
+    static std::vector<Test> tests;
+    return tests;
+}
+
+inline int& Failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+struct Register
+{
+    Register(const char* name, std::function<void()> body)
+    {
+        Tests().push_back({ name, std::move(body) });
+    }
+};
+
+inline void Fail(const char* file, int line, const char* what)
+{
+    std::cerr << file << ":" << line << ": check failed: " << what << "\n";
+    Failures()++;
+}
+
+inline int RunTests()
+{
+    for (const Test& test : Tests())
+    {
+        int before = Failures();
+        try
+        {
+            test.body();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << test.name << ": unexpected exception: " << e.what() << "\n";
+            Failures()++;
+        }
+        std::cout << (Failures() == before ? "ok   " : "FAIL ") << test.name << "\n";
+    }
+    return Failures() ? 1 : 0;
+}
+
+}
+
+#define TEST(name) \
+static void name(); \
+static __check::Register name##_registered(#name, name); \
+static void name()
+
+#define CHECK(condition) \
+do \
+{ \
+    if (!(condition)) \
+    { \
+        __check::Fail(__FILE__, __LINE__, #condition); \
+    } \
+} \
+while (0)
+
+#define CHECK_THROWS(expression, exception) \
+do \
+{ \
+    bool thrown = false; \
+    try \
+    { \
+        (void)(expression); \
+    } \
+    catch (const exception&) \
+    { \
+        thrown = true; \
+    } \
+    if (!thrown) \
+    { \
+        __check::Fail(__FILE__, __LINE__, #expression " throws " #exception); \
+    } \
+} \
+while (0)
+
+#endif // !_CHECK_HPP_
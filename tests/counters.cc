@@ -0,0 +1,53 @@
+#include "check.hpp"
+#include "../src/pattern.hh"
+#include <string>
+
+// Counted loops (see Compiler), and the fallback to the backtracker when
+// nested ones would need more states than the VM takes.
+
+TEST(large_bound_runs_on_vm)
+{
+    Pattern pattern("a.{1,5000}b");
+    CHECK(VM::supports(pattern.getProgram()));
+    CHECK(pattern.test("a" + std::string(4000, 'x') + "b"));
+    CHECK(!pattern.test("a" + std::string(6000, 'x')));
+}
+
+TEST(states_saturate_instead_of_overflowing)
+{
+    Pattern pattern("(?:(?:(?:(?:x{2,60000}){2,60000}){2,60000}){2,60000})y");
+    CHECK(pattern.getProgram().states(VM::maxStates) == VM::maxStates + 1);
+}
+
+TEST(nested_bounds_fall_back_to_backtracker)
+{
+    Pattern pattern("(?:(?:(?:x{2,300}){2,300}){2,300})y");
+    CHECK(!VM::supports(pattern.getProgram()));
+    CHECK(pattern.test(std::string(8, 'x') + "y"));
+    CHECK(pattern.test("zz" + std::string(20, 'x') + "y"));
+    CHECK(!pattern.test(std::string(7, 'x') + "y"));
+
+    size_t start, end;
+    CHECK(pattern.find("ab" + std::string(9, 'x') + "y", start, end));
+    CHECK(start == 2 && end == 12);
+}
+
+TEST(nested_bounds_keep_captures)
+{
+    Pattern pattern("(?:((?:x{2,300}){2,300}),){2,300}");
+    Captures captures;
+    CHECK(pattern.search("xxxx,xxxxx,", captures));
+    CHECK(captures[0] == 0 && captures[1] == 11);
+    CHECK(captures[2] == 5 && captures[3] == 10);
+}
+
+TEST(vm_rejects_nested_bounds_by_name)
+{
+    Pattern pattern("(?:(?:(?:x{2,300}){2,300}){2,300})y");
+    CHECK_THROWS(VM(pattern.getProgram()), std::runtime_error);
+}
+
+int main()
+{
+    return __check::RunTests();
+}
@@ -0,0 +1,126 @@
+#include "check.hpp"
+#include "../src/ct_regex.hh"
+#include "../src/pattern.hh"
+#include <random>
+#include <string>
+#include <vector>
+
+// ct_regex has a parser and compiler of its own, so every pattern here is
+// also run through Pattern, which must agree on test(), on find() from every
+// offset, and on match() with ^(?:...)$.
+
+static const std::vector<std::string>& texts()
+{
+    static const std::vector<std::string> texts = []
+    {
+        std::vector<std::string> made = { "", "a", "ab", "aab", "abc", "ba", "aaa", "xab", "a\nb", "abab",
+            "2024-01-31T12:34:56Z", "192.168.1.255", "256.1.1.1", "1.2.3", "héllo wörld",
+            "日本語 text", "\xff\xfe" "a", "foo123bar", "  x  " };
+        std::mt19937 random(7);
+        const char alphabet[] = "ab01.-: \n";
+        for (int i = 0; i < 200; ++i)
+        {
+            std::string text;
+            for (size_t n = random() % 9; n > 0; --n)
+            {
+                text += alphabet[random() % 9];
+            }
+            made.push_back(text);
+        }
+        return made;
+    }();
+    return texts;
+}
+
+template <sweetie::fixed_string Source>
+static bool agrees()
+{
+    using Regex = sweetie::ct_regex<Source>;
+    std::string source(Regex::pattern());
+    Pattern pattern(source);
+    Pattern whole("^(?:" + source + ")$");
+    bool same = true;
+    for (const std::string& text : texts())
+    {
+        for (size_t from = 0; from <= text.size(); ++from)
+        {
+            size_t s1 = 0, e1 = 0, s2 = 0, e2 = 0;
+            bool found = Regex::find(text, s1, e1, from);
+            if (found != pattern.find(text, s2, e2, from) || (found && (s1 != s2 || e1 != e2)))
+            {
+                std::cerr << source << ": find() differs on \"" << text << "\" from " << from << "\n";
+                same = false;
+            }
+        }
+        if (Regex::test(text) != pattern.test(text) || Regex::match(text) != whole.test(text))
+        {
+            std::cerr << source << ": test() or match() differs on \"" << text << "\"\n";
+            same = false;
+        }
+    }
+    return same;
+}
+
+TEST(literals_and_alternatives)
+{
+    CHECK(agrees<"a">());
+    CHECK(agrees<"ab|a">());
+    CHECK(agrees<"a|ab">());
+    CHECK(agrees<"(?:ab|a)(?:c|bc)?">());
+    CHECK(agrees<"\\.|-">());
+}
+
+TEST(repetitions)
+{
+    CHECK(agrees<"a*">());
+    CHECK(agrees<"a+?">());
+    CHECK(agrees<"a*?b">());
+    CHECK(agrees<"(a|b)*b">());
+    CHECK(agrees<"(?:ab)+?b?">());
+    CHECK(agrees<"a{2,3}?">());
+    CHECK(agrees<"a{0}b">());
+    CHECK(agrees<"(?:a|)*b">());
+    CHECK(agrees<"(?:a*)*?$">());
+    CHECK(agrees<"(?:a|b)*?a(?:a|b)">());
+    CHECK(agrees<"[ab]{2,}?:">());
+}
+
+TEST(anchors)
+{
+    CHECK(agrees<"^a">());
+    CHECK(agrees<"a$">());
+    CHECK(agrees<"^$">());
+    CHECK(agrees<"$">());
+    CHECK(agrees<"^">());
+    CHECK(agrees<"(?:a|^)b">());
+    CHECK(agrees<"b(?:$|a)">());
+    CHECK(agrees<"(?:^|a)+b?">());
+    CHECK(agrees<"(?:$|b)+">());
+    CHECK(agrees<"(?:^a|b$)+">());
+}
+
+TEST(classes)
+{
+    CHECK(agrees<".">());
+    CHECK(agrees<".+">());
+    CHECK(agrees<"\\w+">());
+    CHECK(agrees<"\\s*">());
+    CHECK(agrees<"[^a]+">());
+    CHECK(agrees<"[^\\s]*$">());
+    CHECK(agrees<"[é-ö]\\w*">());
+}
+
+TEST(real_patterns)
+{
+    CHECK(agrees<"\\d{1,3}(?:\\.\\d{1,3}){3}">());
+    CHECK(agrees<"^\\d{4}-\\d{2}-\\d{2}T\\d{2}:\\d{2}:\\d{2}(?:Z|[+-]\\d{2}:\\d{2})$">());
+    CHECK(agrees<"^(?:25[0-5]|2[0-4]\\d|1\\d\\d|[1-9]?\\d)(?:\\.(?:25[0-5]|2[0-4]\\d|1\\d\\d|[1-9]?\\d)){3}$">());
+}
+
+static_assert(sweetie::ct_regex<"[0-9]{4}-[0-9]{2}-[0-9]{2}">::match("2024-01-31"));
+static_assert(!sweetie::ct_regex<"[0-9]{4}-[0-9]{2}-[0-9]{2}">::match("2024-01-3"));
+
+int main()
+{
+    return __check::RunTests();
+}
@@ -0,0 +1,47 @@
+#include "check.hpp"
+#include "../src/pattern.hh"
+#include <string>
+
+// Lookarounds are evaluated with tables before the search (see VM), so what
+// they can hold is limited.
+
+static std::string error(const char* pattern)
+{
+    try
+    {
+        Pattern compiled(pattern);
+    }
+    catch (const std::runtime_error& e)
+    {
+        return e.what();
+    }
+    return "";
+}
+
+TEST(backreference_inside_is_rejected_by_name)
+{
+    CHECK(error("(a)(?=\\1)") == "Backreferences are not supported in lookarounds");
+    CHECK(error("(a)(?<!\\1)b") == "Backreferences are not supported in lookarounds");
+    CHECK(error("(?<n>a)(?!x(?=\\k<n>))") == "Backreferences are not supported in lookarounds");
+}
+
+TEST(backreference_outside_runs_on_backtracker)
+{
+    Pattern pattern("(a)\\1(?=b)");
+    CHECK(pattern.test("xaab"));
+    CHECK(!pattern.test("xaac"));
+}
+
+TEST(captures_inside_are_not_reported)
+{
+    Pattern pattern("a(?=(b))");
+    Captures captures;
+    CHECK(pattern.search("xab", captures));
+    CHECK(captures[0] == 1 && captures[1] == 2);
+    CHECK(captures[2] == VM::npos);
+}
+
+int main()
+{
+    return __check::RunTests();
+}
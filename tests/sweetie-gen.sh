@@ -0,0 +1,87 @@
+#!/bin/sh
+# Builds sweetie-gen, compiles patterns with escapes and awkward names, and
+# checks that the generated files compile and agree with Pattern, and that
+# names the generated code cannot take are rejected. Run from the root of
+# the tree; CXX defaults to c++.
+
+set -e
+CXX=${CXX:-c++}
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+mkdir "$work/obj"
+for source in $(ls src/*.cc | grep -v main.cc); do
+    $CXX -std=c++20 -O1 -c "$source" -o "$work/obj/$(basename "$source" .cc).o"
+done
+$CXX -std=c++20 -Isrc -o "$work/sweetie-gen" tools/sweetie-gen.cc "$work"/obj/*.o
+
+# A pattern ending in a backslash used to continue the comment above its
+# namespace in the header
+cat > "$work/patterns.txt" <<'EOF'
+slash      a\\
+quote      "[^"]*"
+escapes    \d+\.\t?\\n
+comment    /\*.*?\*/
+EOF
+"$work/sweetie-gen" "$work/patterns.txt" "$work/gen"
+
+cat > "$work/driver.cc" <<'EOF'
+#include "gen.hh"
+#include "pattern.hh"
+#include <iostream>
+#include <string>
+
+template <typename Test, typename Find, typename Match>
+int compare(const char* source, Test test, Find find, Match match)
+{
+    Pattern pattern(source);
+    Pattern whole(std::string("^(?:") + source + ")$");
+    const char* texts[] = { "", "a\\", "a\\\\b", "x\"q\"y", "12.\t\\n", "7.\\n", "/* c */ d */", "a", "\\" };
+    int failures = 0;
+    for (std::string text : texts)
+    {
+        size_t s1 = 0, e1 = 0, s2 = 0, e2 = 0;
+        bool found = find(text, s1, e1, 0);
+        bool expected = pattern.find(text, s2, e2);
+        if (test(text) != pattern.test(text) || found != expected || (found && (s1 != s2 || e1 != e2))
+            || match(text) != whole.test(text))
+        {
+            std::cerr << source << " differs from Pattern on \"" << text << "\"\n";
+            failures++;
+        }
+    }
+    return failures;
+}
+
+#define COMPARE(name, source) compare(source, name::test, name::find, name::match)
+
+int main()
+{
+    int failures = COMPARE(slash, "a\\\\") + COMPARE(quote, "\"[^\"]*\"")
+        + COMPARE(escapes, "\\d+\\.\\t?\\\\n") + COMPARE(comment, "/\\*.*?\\*/");
+    std::cout << (failures ? "FAIL" : "ok  ") << " generated code agrees with Pattern\n";
+    return failures ? 1 : 0;
+}
+EOF
+$CXX -std=c++20 -Wall -Wextra -Werror -c -o "$work/gen.o" "$work/gen.cc"
+$CXX -std=c++20 -Isrc -I"$work" -o "$work/driver" "$work/driver.cc" "$work/gen.o" "$work"/obj/*.o
+"$work/driver"
+
+# Each of these names must be refused with a message, not written out
+status=0
+for line in 'class a' 'search a' 'Automaton a' 'std a' '__x a' '_X a' '9a a' \
+    'date a
+dateForward b' 'hex a
+hexBackwardClasses b'
+do
+    printf '%s\n' "$line" > "$work/bad.txt"
+    if "$work/sweetie-gen" "$work/bad.txt" "$work/bad" 2> "$work/error.txt"; then
+        echo "FAIL accepted: $line"
+        status=1
+    elif ! grep -q "sweetie-gen: .*bad.txt:[0-9]*: " "$work/error.txt"; then
+        echo "FAIL no message for: $line"
+        status=1
+    fi
+done
+[ $status = 0 ] && echo "ok   names the generated code cannot take are rejected"
+exit $status
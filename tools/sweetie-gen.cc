@@ -0,0 +1,402 @@
+// sweetie-gen: compiles fixed patterns to C++ ahead of time.
+//
+//     sweetie-gen patterns.txt out
+//
+// reads one pattern per line, as a name followed by the pattern:
+//
+//     # Lines starting with # and blank lines are skipped
+//     date    \d{4}-\d{2}-\d{2}
+//     hex     #[0-9a-fA-F]{6}
+//
+// and writes out.hh and out.cc. Every pattern becomes a namespace with
+//
+//     bool test(std::string_view text);
+//     bool find(std::string_view text, size_t& start, size_t& end, size_t from = 0);
+//     bool match(std::string_view text);
+//
+// which behave like Pattern::test() and Pattern::find(), and match() tells
+// whether the pattern matches the whole text. The generated files hold the
+// forward and reverse DFAs as static tables, fully built, with a scan loop
+// like DFA::search(); they need only the standard library and do no work
+// at startup.
+//
+// Patterns with lookarounds, backreferences or atomic groups that matter
+// have no DFA and are rejected, as are those whose DFAs have more than
+// maxStates states. Names must be identifiers that are neither keywords nor
+// names the generated code uses itself (search, Automaton, std, size_t and
+// the uintN_t), nor clash with the tables of another pattern, which are
+// named after it (dateForward, dateForwardClasses, ...).
+//
+// Build it with the engine, e.g.
+//
+//     c++ -std=c++20 -Isrc -o sweetie-gen tools/sweetie-gen.cc $(ls src/*.cc | grep -v main.cc)
+
+#include "../src/compiler.hh"
+#include "../src/dfa.hh"
+#include "../src/parser.hh"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    constexpr size_t maxStates = 100000;
+    constexpr size_t cacheSize = size_t(1) << 30;
+
+    struct Entry
+    {
+        std::string name;
+        std::string pattern;
+    };
+
+    [[noreturn]] void fail(const std::string& message)
+    {
+        std::cerr << "sweetie-gen: " << message << std::endl;
+        exit(1);
+    }
+
+    // Names the generated files declare or use at namespace scope besides
+    // those of the patterns
+    const char* const reserved[] = { "Automaton", "search", "std", "size_t", "uint8_t", "uint16_t", "uint32_t" };
+
+    const char* const keywords[] = {
+        "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch",
+        "char", "char8_t", "char16_t", "char32_t", "class", "compl", "concept", "const", "consteval", "constexpr",
+        "constinit", "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype", "default",
+        "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false",
+        "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new",
+        "noexcept", "not", "not_eq", "nullptr", "operator", "or", "or_eq", "private", "protected", "public",
+        "register", "reinterpret_cast", "requires", "return", "short", "signed", "sizeof", "static",
+        "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local", "throw", "true",
+        "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile",
+        "wchar_t", "while", "xor", "xor_eq",
+    };
+
+    bool isIdentifier(const std::string& name)
+    {
+        if (name.empty() || isdigit(static_cast<unsigned char>(name[0])))
+        {
+            return false;
+        }
+        for (char c : name)
+        {
+            if (!isalnum(static_cast<unsigned char>(c)) && c != '_')
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Why name cannot name a pattern, or an empty string if it can
+    std::string misnamed(const std::string& name)
+    {
+        if (!isIdentifier(name))
+        {
+            return name + " is not an identifier";
+        }
+        for (const char* keyword : keywords)
+        {
+            if (name == keyword)
+            {
+                return name + " is a C++ keyword";
+            }
+        }
+        for (const char* symbol : reserved)
+        {
+            if (name == symbol)
+            {
+                return name + " is used by the generated code";
+            }
+        }
+        if (name[0] == '_' || name.find("__") != std::string::npos)
+        {
+            return name + " is reserved to the implementation";
+        }
+        return "";
+    }
+
+    // Names of the namespace and the tables written for the pattern name
+    std::vector<std::string> symbols(const std::string& name)
+    {
+        std::vector<std::string> result = { name };
+        for (const char* automaton : { "Forward", "Backward" })
+        {
+            result.push_back(name + automaton);
+            for (const char* table : { "Classes", "Transitions", "Matches", "EndMatches" })
+            {
+                result.push_back(name + automaton + table);
+            }
+        }
+        return result;
+    }
+
+    // The pattern as a C++ string literal, so that it can go in a comment:
+    // one ending in a backslash would otherwise continue the comment on the
+    // next line
+    std::string quote(const std::string& pattern)
+    {
+        std::string result = "\"";
+        for (char c : pattern)
+        {
+            unsigned char b = static_cast<unsigned char>(c);
+            if (c == '\\' || c == '"')
+            {
+                result += '\\';
+                result += c;
+            }
+            else if (b < 0x20 || b == 0x7F)
+            {
+                const char* digits = "01234567";
+                result += { '\\', digits[b >> 6], digits[b >> 3 & 7], digits[b & 7] };
+            }
+            else
+            {
+                result += c;
+            }
+        }
+        return result + '"';
+    }
+
+    std::vector<Entry> readPatterns(const std::string& path)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            fail("cannot open " + path);
+        }
+        std::vector<Entry> entries;
+        std::string line;
+        for (size_t number = 1; std::getline(in, line); ++number)
+        {
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+            size_t begin = line.find_first_not_of(" \t");
+            if (begin == std::string::npos || line[begin] == '#')
+            {
+                continue;
+            }
+            size_t split = line.find_first_of(" \t", begin);
+            size_t pattern = split == std::string::npos ? split : line.find_first_not_of(" \t", split);
+            std::string name = line.substr(begin, split - begin);
+            if (pattern == std::string::npos)
+            {
+                fail(path + ":" + std::to_string(number) + ": missing pattern after " + name);
+            }
+            std::string where = path + ":" + std::to_string(number) + ": ";
+            std::string problem = misnamed(name);
+            if (!problem.empty())
+            {
+                fail(where + problem);
+            }
+            for (const Entry& entry : entries)
+            {
+                if (entry.name == name)
+                {
+                    fail(where + name + " is defined twice");
+                }
+                for (const std::string& mine : symbols(name))
+                {
+                    for (const std::string& theirs : symbols(entry.name))
+                    {
+                        if (mine == theirs)
+                        {
+                            fail(where + name + " and " + entry.name + " both generate " + mine);
+                        }
+                    }
+                }
+            }
+            entries.push_back({ name, line.substr(pattern) });
+        }
+        return entries;
+    }
+
+    // Smallest unsigned type that holds every state number
+    const char* stateType(size_t states)
+    {
+        return states <= 0x100 ? "uint8_t" : states <= 0x10000 ? "uint16_t" : "uint32_t";
+    }
+
+    template <typename T>
+    void writeArray(std::ostream& out, const char* type, const std::string& name, const std::vector<T>& values)
+    {
+        out << "    const " << type << " " << name << "[" << values.size() << "] = {";
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            out << (i % 16 ? " " : "\n        ") << +values[i] << ",";
+        }
+        out << "\n    };\n";
+    }
+
+    // Writes the tables of one automaton and an Automaton that refers to them
+    void writeAutomaton(std::ostream& out, const std::string& name, const DFA::Tables& tables, bool reverse)
+    {
+        size_t states = tables.matches.size();
+        const char* type = stateType(states);
+        writeArray(out, "uint8_t", name + "Classes",
+            std::vector<uint8_t>(tables.byteClass.begin(), tables.byteClass.end()));
+        writeArray(out, type, name + "Transitions", tables.transitions);
+        writeArray(out, "uint8_t", name + "Matches", tables.matches);
+        writeArray(out, "uint8_t", name + "EndMatches", tables.endMatches);
+        out << "    const Automaton<" << type << "> " << name << " = { " << name << "Classes, "
+            << name << "Transitions, " << name << "Matches, " << name << "EndMatches, { ";
+        for (int i = 0; i < 4; ++i)
+        {
+            out << tables.starts[i] << (i < 3 ? ", " : " }, ");
+        }
+        out << tables.classes << ", " << (reverse ? "true" : "false") << " };\n\n";
+    }
+
+    DFA::Tables build(const Entry& entry, const Program& program, bool reverse)
+    {
+        DFA dfa(program, reverse, cacheSize);
+        DFA::Tables tables;
+        if (!dfa.build(tables, maxStates))
+        {
+            fail(entry.name + ": more than " + std::to_string(maxStates) + " DFA states");
+        }
+        return tables;
+    }
+
+    // The scan of DFA::search(), over tables that are complete
+    const char* prologue = R"(namespace
+{
+    template <typename State>
+    struct Automaton
+    {
+        const uint8_t* classes;
+        const State* transitions;
+        const uint8_t* matches;
+        const uint8_t* endMatches;
+        uint32_t starts[4];
+        size_t stride;
+        bool reverse;
+    };
+
+    template <typename State>
+    bool search(const Automaton<State>& a, std::string_view text, size_t from, size_t to,
+        bool earliest, size_t& position)
+    {
+        size_t nearEnd = a.reverse ? text.size() : 0;
+        size_t farEnd = a.reverse ? 0 : text.size();
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+        size_t s = a.starts[(from == nearEnd ? 1 : 0) | (from == farEnd ? 2 : 0)];
+        bool found = false;
+        if (a.matches[s])
+        {
+            found = true;
+            position = from;
+            if (earliest)
+            {
+                return true;
+            }
+        }
+        size_t p = from;
+        while (p != to && s != 0)
+        {
+            unsigned char b = a.reverse ? data[p - 1] : data[p];
+            s = a.transitions[s * a.stride + a.classes[b]];
+            p = a.reverse ? p - 1 : p + 1;
+            if (a.matches[s])
+            {
+                found = true;
+                position = p;
+                if (earliest)
+                {
+                    return true;
+                }
+            }
+        }
+        if (p == farEnd && a.endMatches[s])
+        {
+            found = true;
+            position = p;
+        }
+        return found;
+    }
+
+)";
+
+    void writeFunctions(std::ostream& out, const std::string& name)
+    {
+        std::string forward = name + "Forward", backward = name + "Backward";
+        out << "\nnamespace " << name << "\n{\n"
+            << "    bool test(std::string_view text)\n    {\n"
+            << "        size_t end;\n"
+            << "        return search(" << forward << ", text, 0, text.size(), true, end);\n    }\n\n"
+            << "    bool find(std::string_view text, size_t& start, size_t& end, size_t from)\n    {\n"
+            << "        return from <= text.size()\n"
+            << "            && search(" << forward << ", text, from, text.size(), false, end)\n"
+            << "            && search(" << backward << ", text, end, from, false, start);\n    }\n\n"
+            << "    bool match(std::string_view text)\n    {\n"
+            << "        size_t start;\n"
+            << "        return search(" << backward << ", text, text.size(), 0, false, start) && start == 0;\n"
+            << "    }\n}\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: sweetie-gen <patterns> <output>" << std::endl;
+        return 2;
+    }
+    std::vector<Entry> entries = readPatterns(argv[1]);
+    std::string output = argv[2];
+    std::string base = output.substr(output.find_last_of("/\\") + 1);
+
+    std::string guard = "_";
+    for (char c : base)
+    {
+        guard += isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(toupper(c)) : '_';
+    }
+    guard += "_HH_";
+
+    std::ostringstream header, source;
+    header << "// Generated by sweetie-gen from " << argv[1] << ". Do not edit.\n\n"
+        << "#ifndef " << guard << "\n#define " << guard << "\n\n"
+        << "#include <cstddef>\n#include <string_view>\n";
+    source << "// Generated by sweetie-gen from " << argv[1] << ". Do not edit.\n\n"
+        << "#include \"" << base << ".hh\"\n#include <cstdint>\n\n" << prologue;
+
+    for (const Entry& entry : entries)
+    {
+        Lexer lexer(String(entry.pattern));
+        Parser parser(lexer.tokenize());
+        std::unique_ptr<AST> regex = parser.parse();
+        Program program = Compiler().compile(*regex);
+        Program reversed = Compiler(true).compile(*regex);
+        if (!DFA::supports(program) || !DFA::supports(reversed))
+        {
+            fail(entry.name + ": lookarounds, backreferences and atomic groups have no DFA");
+        }
+        DFA::Tables forward = build(entry, program, false);
+        DFA::Tables backward = build(entry, reversed, true);
+        writeAutomaton(source, entry.name + "Forward", forward, false);
+        writeAutomaton(source, entry.name + "Backward", backward, true);
+
+        header << "\n// " << quote(entry.pattern) << "\nnamespace " << entry.name << "\n{\n"
+            << "    bool test(std::string_view text);\n"
+            << "    bool find(std::string_view text, size_t& start, size_t& end, size_t from = 0);\n"
+            << "    bool match(std::string_view text);\n}\n";
+    }
+    source << "}\n";
+    for (const Entry& entry : entries)
+    {
+        writeFunctions(source, entry.name);
+    }
+    header << "\n#endif // !" << guard << "\n";
+
+    for (auto [path, text] : { std::pair{ output + ".hh", header.str() }, std::pair{ output + ".cc", source.str() } })
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!(out << text))
+        {
+            fail("cannot write " + path);
+        }
+    }
+    return 0;
+}